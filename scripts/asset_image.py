@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+"""
+Asset image builder and reader.
+
+Packs the files in web/assets into a read-only image which the web server
+serves without any per-request processing. For every file the image holds
+the path, the content type, an ETag and the content encoding, all computed
+here, and the path index is a minimal perfect hash so a lookup costs two
+hashes and one string compare regardless of the number of files. The files
+are served by the routes listed for them in web/routes.txt.
+
+Image layout, little endian, every section aligned to 4 bytes:
+
+    header        magic "AFS1", version, file count, bucket count,
+                  entry size, hash seed, entries offset, image size
+    displacement  one int16 per bucket; d >= 0 selects slot
+                  hash(d, path) % count, d < 0 selects slot -d - 1
+    entries       one entry per slot, see ENTRY below
+    strings       paths, content types and ETags
+    data          file contents
+
+hash(seed, path) is 32-bit FNV-1a with the offset basis XORed with the seed.
+
+Text files are stored gzip compressed when that makes them smaller; the
+entry then records the gzip content encoding, and also points at the
+uncompressed content, which is sent to the clients that do not accept gzip.
+The ETag is weak, computed from the uncompressed content, so both encodings
+of a file share it.
+
+Usage:
+    asset_image.py build [--assets DIR] [--output FILE.c] [--binary FILE.bin]
+    asset_image.py list FILE.bin
+    asset_image.py get FILE.bin PATH [--output FILE]
+
+The C source is only rewritten when its content changes, so running the
+script as a pre-build step does not trigger needless rebuilds. The list and
+get commands read a binary image the way the firmware does, for testing.
+"""
+
+import argparse
+import gzip
+import os
+import struct
+import sys
+
+from page_templates import APP_DIR, file_header, write_if_changed
+
+MAGIC = b"AFS1"
+VERSION = 2
+HEADER = struct.Struct("<4sHHHHIII")
+ENTRY = struct.Struct("<IIIIIIIHBBB3x")
+
+ENCODING_IDENTITY = 0
+ENCODING_GZIP = 1
+ENCODING_NAMES = {ENCODING_IDENTITY: "identity", ENCODING_GZIP: "gzip"}
+
+FNV_OFFSET_BASIS = 0x811C9DC5
+FNV_PRIME = 0x01000193
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".json": "application/json",
+    ".txt": "text/plain",
+    ".svg": "image/svg+xml",
+    ".png": "image/png",
+    ".jpg": "image/jpeg",
+    ".gif": "image/gif",
+    ".ico": "image/x-icon",
+}
+COMPRESSIBLE = {".html", ".css", ".js", ".json", ".txt", ".svg"}
+
+# Longest line of the byte array emitted in the generated source.
+BYTES_PER_LINE = 16
+
+
+def fnv1a(seed, data):
+    value = FNV_OFFSET_BASIS ^ seed
+    for byte in data:
+        value ^= byte
+        value = (value * FNV_PRIME) & 0xFFFFFFFF
+    return value
+
+
+def align(data):
+    return data + b"\0" * (-len(data) % 4)
+
+
+def build_index(paths, seed):
+    """Hash and displace: returns the displacement table and the slot of every
+    path, or None if no displacement below 32768 separates a bucket."""
+    count = len(paths)
+    buckets = [[] for _ in range(count)]
+    for path in paths:
+        buckets[fnv1a(seed, path) % count].append(path)
+
+    displacement = [0] * count
+    slots = {}
+    free = set(range(count))
+    for bucket_index in sorted(range(count), key=lambda index: -len(buckets[index])):
+        bucket = buckets[bucket_index]
+        if not bucket:
+            continue
+        if len(bucket) == 1:
+            slot = min(free)
+            displacement[bucket_index] = -slot - 1
+            slots[bucket[0]] = slot
+            free.remove(slot)
+            continue
+        for d in range(32768):
+            chosen = [fnv1a(d, path) % count for path in bucket]
+            if len(set(chosen)) == len(chosen) and all(slot in free for slot in chosen):
+                break
+        else:
+            return None
+        displacement[bucket_index] = d
+        for path, slot in zip(bucket, chosen):
+            slots[path] = slot
+            free.remove(slot)
+    return displacement, slots
+
+
+def build_image(assets):
+    """assets: list of (path bytes, content type, encoding, data, identity data)."""
+    count = len(assets)
+    paths = [path for path, _, _, _, _ in assets]
+    seed = 0
+    index = build_index(paths, seed) if count else ([], {})
+    while index is None:
+        seed += 1
+        index = build_index(paths, seed)
+    displacement, slots = index
+
+    entries_offset = HEADER.size + len(align(struct.pack("<%uh" % count, *displacement)))
+    strings = b""
+    data = b""
+    records = [None] * count
+    for path, content_type, encoding, content, identity in assets:
+        etag = b'W/"%08x"' % fnv1a(0, identity)
+        path_offset = len(strings)
+        strings += path + b"\0"
+        type_offset = len(strings)
+        strings += content_type.encode() + b"\0"
+        etag_offset = len(strings)
+        strings += etag + b"\0"
+        content_offset = len(data)
+        data += align(content)
+        identity_offset = content_offset
+        if encoding != ENCODING_IDENTITY:
+            identity_offset = len(data)
+            data += align(identity)
+        records[slots[path]] = (path_offset, type_offset, etag_offset, len(path),
+                                len(content_type), len(etag), encoding, content_offset, len(content),
+                                identity_offset, len(identity))
+
+    strings_offset = entries_offset + ENTRY.size * count
+    data_offset = strings_offset + len(align(strings))
+    image_size = data_offset + len(data)
+
+    image = HEADER.pack(MAGIC, VERSION, count, count, ENTRY.size, seed, entries_offset, image_size)
+    image += align(struct.pack("<%uh" % count, *displacement))
+    for (path_offset, type_offset, etag_offset, path_length, type_length, etag_length,
+         encoding, content_offset, content_length, identity_offset, identity_length) in records:
+        image += ENTRY.pack(strings_offset + path_offset, strings_offset + type_offset,
+                            strings_offset + etag_offset, data_offset + content_offset,
+                            content_length, data_offset + identity_offset, identity_length,
+                            path_length, type_length, etag_length, encoding)
+    image += align(strings) + data
+    assert len(image) == image_size
+    return image
+
+
+def read_assets(directory):
+    assets = []
+    for root, _, files in os.walk(directory):
+        for file_name in sorted(files):
+            full_path = os.path.join(root, file_name)
+            path = "/" + os.path.relpath(full_path, directory).replace(os.sep, "/")
+            extension = os.path.splitext(file_name)[1].lower()
+            if extension not in CONTENT_TYPES:
+                sys.exit("Unknown content type: " + full_path)
+            with open(full_path, "rb") as asset:
+                content = asset.read()
+            identity = content
+            encoding = ENCODING_IDENTITY
+            if extension in COMPRESSIBLE:
+                compressed = gzip.compress(content, 9, mtime=0)
+                if len(compressed) < len(content):
+                    content, encoding = compressed, ENCODING_GZIP
+            assets.append((path.encode(), CONTENT_TYPES[extension], encoding, content, identity))
+    return sorted(assets)
+
+
+def generate_source(image):
+    lines = [file_header("asset_image.c",
+                         ["This file is generated by scripts/asset_image.py",
+                          "from web/assets. Do not edit it by hand."]),
+             '#include "asset_fs.h"',
+             "",
+             "/* Boards with external flash mapped for execute in place keep the",
+             " * image there, the others in internal flash.",
+             " */",
+             "#if defined(CY_DEVICE_PSOC6A512K)",
+             'CY_SECTION(".cy_xip")',
+             "#endif",
+             "CY_ALIGN(4) const uint8_t asset_image[%u] =" % len(image),
+             "{"]
+    for offset in range(0, len(image), BYTES_PER_LINE):
+        chunk = image[offset:offset + BYTES_PER_LINE]
+        lines.append("    " + " ".join("0x%02x," % byte for byte in chunk))
+    lines += ["};", "", "/* [] END OF FILE */", ""]
+    return "\n".join(lines)
+
+
+class AssetImage:
+    """Reads an image the way asset_fs.c does."""
+
+    def __init__(self, image):
+        (magic, version, self.count, self.buckets, entry_size, self.seed,
+         self.entries_offset, image_size) = HEADER.unpack_from(image, 0)
+        if magic != MAGIC or version != VERSION or entry_size != ENTRY.size or \
+                image_size != len(image):
+            raise ValueError("Not a valid asset image")
+        self.image = image
+        self.displacement = struct.unpack_from("<%uh" % self.buckets, image, HEADER.size)
+
+    def _string(self, offset, length):
+        return self.image[offset:offset + length]
+
+    def entry(self, slot):
+        (path_offset, type_offset, etag_offset, content_offset, content_length,
+         identity_offset, identity_length, path_length, type_length, etag_length, encoding) = \
+            ENTRY.unpack_from(self.image, self.entries_offset + slot * ENTRY.size)
+        return {
+            "path": self._string(path_offset, path_length).decode(),
+            "content_type": self._string(type_offset, type_length).decode(),
+            "etag": self._string(etag_offset, etag_length).decode(),
+            "encoding": ENCODING_NAMES[encoding],
+            "data": self.image[content_offset:content_offset + content_length],
+            "identity": self.image[identity_offset:identity_offset + identity_length],
+        }
+
+    def find(self, path):
+        if self.count == 0:
+            return None
+        key = path.encode()
+        d = self.displacement[fnv1a(self.seed, key) % self.buckets]
+        slot = -d - 1 if d < 0 else fnv1a(d, key) % self.count
+        entry = self.entry(slot)
+        return entry if entry["path"] == path else None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build or read the web asset image.")
+    commands = parser.add_subparsers(dest="command", required=True)
+    build = commands.add_parser("build")
+    build.add_argument("--assets", default=os.path.join(APP_DIR, "web", "assets"))
+    build.add_argument("--output", default=os.path.join(APP_DIR, "source", "asset_image.c"))
+    build.add_argument("--binary", help="also write the raw image to this file")
+    listing = commands.add_parser("list")
+    listing.add_argument("image")
+    get = commands.add_parser("get")
+    get.add_argument("image")
+    get.add_argument("path")
+    get.add_argument("--output", help="write the stored content to this file")
+    args = parser.parse_args()
+
+    if args.command == "build":
+        assets = read_assets(args.assets)
+        image = build_image(assets)
+        for path, content_type, encoding, content, _ in assets:
+            print("%-28s %-24s %-8s %6u bytes" % (path.decode(), content_type,
+                                                  ENCODING_NAMES[encoding], len(content)))
+        print("%-28s %u files, %u bytes" % ("Image", len(assets), len(image)))
+        if write_if_changed(args.output, generate_source(image)):
+            print("Generated " + os.path.relpath(args.output, APP_DIR))
+        if args.binary:
+            with open(args.binary, "wb") as output:
+                output.write(image)
+        return
+
+    with open(args.image, "rb") as image_file:
+        image = AssetImage(image_file.read())
+    if args.command == "list":
+        for slot in range(image.count):
+            entry = image.entry(slot)
+            print("%-28s %-24s %-8s %s %6u bytes" % (entry["path"], entry["content_type"],
+                                                     entry["encoding"], entry["etag"],
+                                                     len(entry["data"])))
+    else:
+        entry = image.find(args.path)
+        if entry is None:
+            sys.exit("Not found: " + args.path)
+        if args.output:
+            with open(args.output, "wb") as output:
+                output.write(entry["data"])
+        else:
+            print("%s %s %s %u bytes" % (entry["content_type"], entry["encoding"],
+                                         entry["etag"], len(entry["data"])))
+
+
+if __name__ == "__main__":
+    main()
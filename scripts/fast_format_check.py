@@ -0,0 +1,492 @@
+#!/usr/bin/env python3
+"""
+Host check and benchmark of the allocation-free formatting helpers.
+
+Builds source/fast_format.c for the host together with a small harness, and
+  - checks format_uint(), format_uint_fixed(), format_ipv4(), format_append()
+    and format_append_uint() against the snprintf() calls they replace, on
+    random values biased towards the digit count boundaries, and on buffers
+    of random capacity for the appending helpers. A canary after the buffer
+    catches any write past its capacity;
+  - measures the time taken by each helper and by snprintf() on a few values,
+    and on a history export record, which is the hottest path of the helpers;
+  - compares the stack used by each helper and by snprintf(): the frames
+    reported by -fstack-usage for fast_format.c, and the peak stack measured
+    by running each call on a painted stack, which includes the C library.
+
+Usage:
+    fast_format_check.py [--cases N] [--seed S] [--iterations N] [--cc cc]
+                         [--skip-bench]
+
+The harness is built with the compiler given by --cc, or $CC, in a temporary
+directory. Any mismatch is printed with its operation and arguments, and
+makes the script exit with status 1. The snprintf() figures are those of
+the C library of the host rather than of newlib, which the target uses.
+"""
+
+import argparse
+import os
+import random
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+APP_DIR = os.path.dirname(SCRIPT_DIR)
+SOURCE_DIR = os.path.join(APP_DIR, "source")
+
+# Operations of the harness, in the order of its switch.
+OPERATIONS = ("uint", "uint_fixed", "ipv4", "append", "append_uint", "record")
+
+# Mirror of FORMAT_UINT_MAX_DIGITS
+UINT_MAX_DIGITS = 10
+
+BENCH_CASES = (
+    ("uint", 7, 0, 0, b""),
+    ("uint", 4095, 0, 0, b""),
+    ("uint", 4294967295, 0, 0, b""),
+    ("uint_fixed", 42, 4, 0, b""),
+    ("ipv4", 0x6401A8C0, 0, 0, b""),
+    ("append", 0, 64, 12, b"Connected to the Wi-Fi network"),
+    ("append_uint", 86400, 64, 12, b""),
+    ("record", 86400, 3300, 65, b""),
+)
+
+HARNESS = r"""
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include "fast_format.h"
+
+#define BUFFER_LENGTH   128u
+#define CANARY_LENGTH   16u
+#define CANARY_BYTE     0xA5u
+#define STACK_LENGTH    (64u * 1024u)
+#define STACK_PAINT     0x5Au
+
+enum { OP_UINT, OP_UINT_FIXED, OP_IPV4, OP_APPEND, OP_APPEND_UINT, OP_RECORD };
+
+typedef struct
+{
+    uint32_t op;
+    uint32_t value;
+    uint32_t arg;       /* Width, capacity, or second value of a record */
+    uint32_t prefix;    /* Length of the text already in the buffer */
+    char     src[BUFFER_LENGTH + 1u];
+} format_case_t;
+
+typedef struct
+{
+    char     text[BUFFER_LENGTH + CANARY_LENGTH];
+    size_t   length;
+    int      result;
+} format_output_t;
+
+static int read_case(format_case_t *test)
+{
+    uint32_t header[5];
+
+    if (fread(header, sizeof(header), 1, stdin) != 1)
+    {
+        return 0;
+    }
+    test->op = header[0];
+    test->value = header[1];
+    test->arg = header[2];
+    test->prefix = header[3];
+    if ((header[4] > BUFFER_LENGTH) || ((header[4] != 0u) && (fread(test->src, header[4], 1, stdin) != 1)))
+    {
+        return 0;
+    }
+    test->src[header[4]] = '\0';
+    return 1;
+}
+
+static size_t capacity_of(const format_case_t *test)
+{
+    return ((test->op == OP_APPEND) || (test->op == OP_APPEND_UINT)) ? test->arg : BUFFER_LENGTH;
+}
+
+static void prepare(format_output_t *out, const format_case_t *test)
+{
+    size_t capacity = capacity_of(test);
+
+    memset(out->text, CANARY_BYTE, sizeof(out->text));
+    if (capacity != 0u)
+    {
+        /* A prefix beyond the capacity stands for a buffer already full */
+        memset(out->text, 'p', (test->prefix < capacity) ? test->prefix : (capacity - 1u));
+        out->text[(test->prefix < capacity) ? test->prefix : (capacity - 1u)] = '\0';
+    }
+    out->length = test->prefix;
+    out->result = 1;
+}
+
+/* The helpers of fast_format.c */
+static void run_fast(format_output_t *out, const format_case_t *test)
+{
+    switch (test->op)
+    {
+        case OP_UINT:
+            out->length = format_uint(out->text, test->value);
+            break;
+        case OP_UINT_FIXED:
+            out->length = format_uint_fixed(out->text, test->value, (uint8_t)test->arg);
+            break;
+        case OP_IPV4:
+            out->length = format_ipv4(out->text, test->value);
+            break;
+        case OP_APPEND:
+            out->result = format_append(out->text, test->arg, &out->length, test->src);
+            break;
+        case OP_APPEND_UINT:
+            out->result = format_append_uint(out->text, test->arg, &out->length, test->value);
+            break;
+        default:
+            /* A history export record, as format_history_record() writes it */
+            out->length = 0;
+            format_append_uint(out->text, BUFFER_LENGTH, &out->length, test->value);
+            format_append(out->text, BUFFER_LENGTH, &out->length, ",");
+            format_append_uint(out->text, BUFFER_LENGTH, &out->length, test->arg);
+            format_append(out->text, BUFFER_LENGTH, &out->length, ",");
+            format_append_uint(out->text, BUFFER_LENGTH, &out->length, test->prefix);
+            out->result = format_append(out->text, BUFFER_LENGTH, &out->length, "\n");
+            break;
+    }
+}
+
+/* The snprintf() calls the helpers replace */
+static void run_reference(format_output_t *out, const format_case_t *test)
+{
+    char digits[FORMAT_UINT_MAX_DIGITS + 1u];
+    size_t room;
+    int length;
+
+    switch (test->op)
+    {
+        case OP_UINT:
+            out->length = (size_t)snprintf(out->text, BUFFER_LENGTH, "%u", (unsigned int)test->value);
+            break;
+        case OP_UINT_FIXED:
+            out->length = (size_t)snprintf(out->text, BUFFER_LENGTH, "%0*u", (int)test->arg,
+                                           (unsigned int)test->value);
+            break;
+        case OP_IPV4:
+            out->length = (size_t)snprintf(out->text, BUFFER_LENGTH, "%u.%u.%u.%u",
+                                           (unsigned int)(test->value & 0xffu),
+                                           (unsigned int)((test->value >> 8) & 0xffu),
+                                           (unsigned int)((test->value >> 16) & 0xffu),
+                                           (unsigned int)(test->value >> 24));
+            break;
+        case OP_APPEND:
+            if (out->length >= test->arg)
+            {
+                out->result = 0;
+                break;
+            }
+            room = test->arg - out->length;
+            length = snprintf(&out->text[out->length], room, "%s", test->src);
+            out->result = ((size_t)length < room);
+            out->length += out->result ? (size_t)length : (room - 1u);
+            break;
+        case OP_APPEND_UINT:
+            length = snprintf(digits, sizeof(digits), "%u", (unsigned int)test->value);
+            if ((out->length + (size_t)length) >= test->arg)
+            {
+                out->result = 0;
+                break;
+            }
+            memcpy(&out->text[out->length], digits, (size_t)length + 1u);
+            out->length += (size_t)length;
+            break;
+        default:
+            out->length = (size_t)snprintf(out->text, BUFFER_LENGTH, "%u,%u,%u\n", (unsigned int)test->value,
+                                           (unsigned int)test->arg, (unsigned int)test->prefix);
+            break;
+    }
+}
+
+static int intact(const format_output_t *out, const format_case_t *test)
+{
+    size_t capacity = capacity_of(test);
+
+    for (size_t index = capacity; index < (capacity + CANARY_LENGTH); index++)
+    {
+        if ((unsigned char)out->text[index] != CANARY_BYTE)
+        {
+            return 0;
+        }
+    }
+    /* A buffer which was already full is left untouched */
+    return (out->length >= capacity) || (out->text[out->length] == '\0');
+}
+
+static void print_output(const format_output_t *out)
+{
+    printf(" %d %zu ", out->result, out->length);
+    for (size_t index = 0; index < out->length; index++)
+    {
+        printf("%02x", (unsigned char)out->text[index]);
+    }
+    if (out->length == 0u)
+    {
+        printf("-");
+    }
+}
+
+static double elapsed_ns(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((double)(end.tv_sec - start->tv_sec) * 1e9) + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+/* Runs one call on a painted stack and measures the stack it used */
+static ucontext_t caller_context;
+static ucontext_t callee_context;
+static format_output_t stack_output;
+static const format_case_t *stack_case;
+static int stack_reference;
+
+static void stack_entry(void)
+{
+    prepare(&stack_output, stack_case);
+    if (stack_reference)
+    {
+        run_reference(&stack_output, stack_case);
+    }
+    else
+    {
+        run_fast(&stack_output, stack_case);
+    }
+}
+
+static size_t measure_stack(const format_case_t *test, int reference)
+{
+    static unsigned char stack[STACK_LENGTH];
+    size_t untouched = 0;
+
+    memset(stack, STACK_PAINT, sizeof(stack));
+    getcontext(&callee_context);
+    callee_context.uc_stack.ss_sp = stack;
+    callee_context.uc_stack.ss_size = sizeof(stack);
+    callee_context.uc_link = &caller_context;
+    makecontext(&callee_context, stack_entry, 0);
+    stack_case = test;
+    stack_reference = reference;
+    swapcontext(&caller_context, &callee_context);
+
+    while ((untouched < sizeof(stack)) && (stack[untouched] == STACK_PAINT))
+    {
+        untouched++;
+    }
+    return sizeof(stack) - untouched;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *mode = (argc > 1) ? argv[1] : "check";
+    long iterations = (argc > 2) ? atol(argv[2]) : 0;
+    format_case_t test;
+    format_output_t fast;
+    format_output_t reference;
+    struct timespec start;
+    volatile size_t sink = 0;
+
+    while (read_case(&test))
+    {
+        if (!strcmp(mode, "bench"))
+        {
+            double fast_ns;
+            double reference_ns;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long run = 0; run < iterations; run++)
+            {
+                prepare(&fast, &test);
+                run_fast(&fast, &test);
+                sink += fast.length;
+                __asm__ volatile("" : : "r"(&fast) : "memory");
+            }
+            fast_ns = elapsed_ns(&start) / (double)iterations;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long run = 0; run < iterations; run++)
+            {
+                prepare(&reference, &test);
+                run_reference(&reference, &test);
+                sink += reference.length;
+                __asm__ volatile("" : : "r"(&reference) : "memory");
+            }
+            reference_ns = elapsed_ns(&start) / (double)iterations;
+            printf("%.2f %.2f\n", fast_ns, reference_ns);
+            continue;
+        }
+
+        if (!strcmp(mode, "stack"))
+        {
+            /* Let the C library set up its state before the measurement */
+            prepare(&reference, &test);
+            run_reference(&reference, &test);
+            printf("%zu %zu\n", measure_stack(&test, 0), measure_stack(&test, 1));
+            continue;
+        }
+
+        prepare(&fast, &test);
+        run_fast(&fast, &test);
+        prepare(&reference, &test);
+        run_reference(&reference, &test);
+        printf("%d", intact(&fast, &test));
+        print_output(&fast);
+        print_output(&reference);
+        printf("\n");
+    }
+
+    return 0;
+}
+"""
+
+
+def record(operation, value, arg, prefix, src):
+    return struct.pack("<IIIII", OPERATIONS.index(operation), value, arg, prefix, len(src)) + src
+
+
+def random_value(rng):
+    """Returns a value around a power of ten, or anywhere in the 32-bit range."""
+    if rng.random() < 0.5:
+        power = 10 ** rng.randint(0, UINT_MAX_DIGITS - 1)
+        return min(max(power + rng.randint(-2, 2), 0), 0xFFFFFFFF)
+    return rng.choice([rng.randint(0, 99), rng.randint(0, 65535), rng.randint(0, 0xFFFFFFFF)])
+
+
+def random_case(rng):
+    operation = rng.choice(OPERATIONS)
+    value = random_value(rng)
+    if operation == "uint_fixed":
+        return (operation, value, rng.randint(0, 12), 0, b"")
+    if operation == "ipv4":
+        return (operation, rng.randint(0, 0xFFFFFFFF), 0, 0, b"")
+    if operation == "record":
+        return (operation, value, rng.randint(0, 3300), rng.randint(0, 100), b"")
+    if operation in ("append", "append_uint"):
+        capacity = rng.randint(0, 64)
+        prefix = rng.randint(0, capacity + 2)
+        src = bytes(rng.choice(b"abcXYZ019 ,.:%-") for _ in range(rng.randint(0, 40)))
+        return (operation, value, capacity, prefix, src if operation == "append" else b"")
+    return (operation, value, 0, 0, b"")
+
+
+def build(directory, compiler):
+    """Builds the harness, and returns it with the frames of fast_format.c."""
+    harness = os.path.join(directory, "harness.c")
+    binary = os.path.join(directory, "fast_format_harness")
+    with open(harness, "w", encoding="utf-8") as source:
+        source.write(HARNESS)
+
+    objects = []
+    for path in (harness, os.path.join(SOURCE_DIR, "fast_format.c")):
+        obj = os.path.join(directory, os.path.splitext(os.path.basename(path))[0] + ".o")
+        subprocess.run([compiler, "-O2", "-std=gnu11", "-Wall", "-fstack-usage", "-I", SOURCE_DIR,
+                        "-c", path, "-o", obj], check=True)
+        objects.append(obj)
+    subprocess.run([compiler] + objects + ["-o", binary], check=True)
+
+    frames = {}
+    with open(os.path.join(directory, "fast_format.su"), encoding="utf-8") as usage:
+        for line in usage:
+            location, size, kind = line.rstrip("\n").split("\t")
+            frames[location.rsplit(":", 1)[-1]] = (int(size), kind)
+    return binary, frames
+
+
+def check(binary, args):
+    rng = random.Random(args.seed)
+    cases = [random_case(rng) for _ in range(args.cases)]
+
+    output = subprocess.run([binary, "check"], input=b"".join(record(*case) for case in cases),
+                            stdout=subprocess.PIPE, check=True).stdout.decode().splitlines()
+
+    failures = 0
+    for case, line in zip(cases, output):
+        intact, *fields = line.split()
+        fast, reference = fields[:3], fields[3:]
+        problems = []
+
+        if int(intact) != 1:
+            problems.append("wrote past the buffer or missed the NUL")
+        if fast != reference:
+            problems.append("returned %s, length %s, text %s; snprintf gave %s, length %s, text %s" % (
+                tuple(fast) + tuple(reference)))
+
+        if problems:
+            failures += 1
+            operation, value, arg, prefix, src = case
+            print("MISMATCH %s value=%u arg=%u prefix=%u src=%s" % (operation, value, arg, prefix, src.hex() or "-"))
+            for problem in problems:
+                print("  " + problem)
+
+    counts = {operation: sum(1 for case in cases if case[0] == operation) for operation in OPERATIONS}
+    print("Checked %u cases (%s), %u mismatches" % (
+        len(cases), ", ".join("%s %u" % item for item in counts.items()), failures))
+    return failures == 0
+
+
+def bench(binary, args):
+    output = subprocess.run([binary, "bench", str(args.iterations)],
+                            input=b"".join(record(*case) for case in BENCH_CASES),
+                            stdout=subprocess.PIPE, check=True).stdout.decode().splitlines()
+
+    print("%-12s %12s %10s %12s %8s" % ("helper", "value", "fast ns", "snprintf ns", "speedup"))
+    for (operation, value, _, _, _), line in zip(BENCH_CASES, output):
+        fast_ns, reference_ns = (float(field) for field in line.split())
+        print("%-12s %12u %10.1f %12.1f %7.2fx" % (operation, value, fast_ns, reference_ns, reference_ns / fast_ns))
+
+
+def stack(binary, frames):
+    print("\nStack frames of fast_format.c (-fstack-usage)")
+    for function, (size, kind) in sorted(frames.items()):
+        print("  %-20s %6u bytes %s" % (function, size, kind))
+
+    output = subprocess.run([binary, "stack"], input=b"".join(record(*case) for case in BENCH_CASES),
+                            stdout=subprocess.PIPE, check=True).stdout.decode().splitlines()
+
+    print("\nPeak stack of a call, measured on a painted stack with the harness around it")
+    print("%-12s %12s %10s %12s" % ("helper", "value", "fast", "snprintf"))
+    for (operation, value, _, _, _), line in zip(BENCH_CASES, output):
+        fast, reference = (int(field) for field in line.split())
+        print("%-12s %12u %10u %12u" % (operation, value, fast, reference))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check and benchmark the formatting helpers on the host.")
+    parser.add_argument("--cases", type=int, default=20000, help="number of random cases")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--iterations", type=int, default=1000000, help="calls timed per case")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--skip-bench", action="store_true")
+    args = parser.parse_args()
+
+    if shutil.which(args.cc) is None:
+        sys.exit("Compiler %s not found, select one with --cc" % args.cc)
+
+    directory = tempfile.mkdtemp()
+    try:
+        binary, frames = build(directory, args.cc)
+        passed = check(binary, args)
+        if not args.skip_bench:
+            bench(binary, args)
+            stack(binary, frames)
+    finally:
+        shutil.rmtree(directory)
+
+    return 0 if passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,399 @@
+#!/usr/bin/env python3
+"""
+Host check and benchmark of the form parser.
+
+Builds source/form_parser.c for the host together with a small harness, and
+  - checks it against a reference decoder written in Python on the bodies of
+    the fuzz corpus in scripts/form_corpus and on random mutations of them,
+    each fed to the parser in randomly sized pieces, as the HTTP server hands
+    a body over in packets;
+  - measures the time taken to parse a typical and an escape-heavy body, and
+    compares it with the previous decoder, which decoded the whole body into
+    a buffer with url_decode() and then looked for '=' and '&'.
+
+The form has the fields of the credentials form: SSID (32 bytes, required)
+and Password (64 bytes).
+
+Usage:
+    form_parser_check.py [--cases N] [--seed S] [--iterations N]
+                         [--corpus DIR] [--cc cc] [--skip-bench]
+
+The harness is built with the compiler given by --cc, or $CC, in a temporary
+directory. Any mismatch is printed with the body, in hexadecimal, and makes
+the script exit with status 1; add the body to the corpus once it is fixed.
+"""
+
+import argparse
+import os
+import random
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+APP_DIR = os.path.dirname(SCRIPT_DIR)
+SOURCE_DIR = os.path.join(APP_DIR, "source")
+
+# Fields of the credentials form: name, capacity, required
+FIELDS = (("SSID", 32, True), ("Password", 64, False))
+
+# Mirror of form_parser_result_t
+RESULTS = ("OK", "BAD_ESCAPE", "VALUE_TOO_LONG", "MISSING_FIELD")
+
+# Bytes the mutations insert, biased towards those with a meaning in a form.
+MUTATION_BYTES = b"%&=+ SsIDPpasword0123456789abcdefABCDEFxyz\x00\x7f\x80\xff"
+
+BENCH_BODIES = {
+    "typical": b"SSID=MyHomeNetwork&Password=correct+horse+battery&submit=Connect+to+Wi-Fi",
+    "escape-heavy": b"SSID=" + b"".join(b"%%%02X" % ord(c) for c in "Caf\xe9 & Bar #1!") +
+                    b"&Password=" + b"".join(b"%%%02X" % c for c in b"p@ss w0rd&=+%!~*'()[]") +
+                    b"&submit=Connect+to+Wi-Fi",
+}
+
+HARNESS = r"""
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "form_parser.h"
+
+static uint8_t ssid[32];
+static uint8_t password[64];
+static form_field_t fields[2] =
+{
+    { .name = "SSID", .value = ssid, .capacity = sizeof(ssid), .required = true },
+    { .name = "Password", .value = password, .capacity = sizeof(password), .required = false }
+};
+
+static int read_record(uint8_t **body, uint32_t *length, uint32_t *chunk)
+{
+    uint32_t header[2];
+
+    if (fread(header, sizeof(header), 1, stdin) != 1)
+    {
+        return 0;
+    }
+    *length = header[0];
+    *chunk = header[1];
+    *body = realloc(*body, *length + 1u);
+    if ((*length != 0u) && (fread(*body, *length, 1, stdin) != 1))
+    {
+        return 0;
+    }
+    (*body)[*length] = 0;
+    return 1;
+}
+
+static form_parser_result_t parse(const uint8_t *body, uint32_t length, uint32_t chunk)
+{
+    form_parser_t parser;
+    uint32_t offset = 0;
+
+    form_parser_init(&parser, fields, 2);
+    while (offset < length)
+    {
+        uint32_t piece = ((chunk == 0u) || (chunk > (length - offset))) ? (length - offset) : chunk;
+        form_parser_feed(&parser, &body[offset], piece);
+        offset += piece;
+    }
+    return form_parser_finish(&parser);
+}
+
+static void print_field(const form_field_t *field)
+{
+    printf(" %d ", field->found ? 1 : 0);
+    for (size_t index = 0; index < field->length; index++)
+    {
+        printf("%02x", field->value[index]);
+    }
+    if (field->length == 0u)
+    {
+        printf("-");
+    }
+}
+
+/* Previous decoder: url_decode() into a buffer, then a scan for '=' and '&' */
+static char legacy_buffer[2048];
+static uint8_t legacy_ssid[32];
+static uint8_t legacy_password[64];
+
+static void legacy_url_decode(char *dst, const uint8_t *src)
+{
+    char high, low;
+
+    while ((*src) && ((*src) < 128))
+    {
+        if ((*src == '%') && ((high = src[1]) && (low = src[2])) && (isxdigit(high) && isxdigit(low)))
+        {
+            if (high >= 'a') high -= 'a' - 'A';
+            if (high >= 'A') high -= ('A' - 10); else high -= '0';
+            if (low >= 'a') low -= 'a' - 'A';
+            if (low >= 'A') low -= ('A' - 10); else low -= '0';
+            *dst++ = 16 * high + low;
+            src += 3;
+        }
+        else if (*src == '+')
+        {
+            *dst++ = ' ';
+            src++;
+        }
+        else
+        {
+            *dst++ = *src++;
+        }
+    }
+    *dst++ = 0;
+}
+
+static void legacy_parse(const uint8_t *body, uint32_t length)
+{
+    int index = 0;
+    int out;
+
+    legacy_url_decode(legacy_buffer, body);
+    if (!strncmp("SSID", legacy_buffer, 4))
+    {
+        while (legacy_buffer[index++] != '=');
+        out = 0;
+        while (legacy_buffer[index] != '&') legacy_ssid[out++] = legacy_buffer[index++];
+        index++;
+        while (legacy_buffer[index++] != '=');
+        out = 0;
+        while (index < (int)length)
+        {
+            if (legacy_buffer[index] == '&') break;
+            legacy_password[out++] = legacy_buffer[index++];
+        }
+    }
+}
+
+static double elapsed_ns(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((double)(end.tv_sec - start->tv_sec) * 1e9) + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t *body = NULL;
+    uint32_t length;
+    uint32_t chunk;
+    long iterations = (argc > 2) ? atol(argv[2]) : 0;
+    struct timespec start;
+    volatile form_parser_result_t sink = FORM_PARSER_OK;
+    double new_ns;
+    double legacy_ns;
+
+    while (read_record(&body, &length, &chunk))
+    {
+        if ((argc > 1) && !strcmp(argv[1], "bench"))
+        {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long run = 0; run < iterations; run++)
+            {
+                sink = parse(body, length, 0);
+            }
+            new_ns = elapsed_ns(&start) / (double)iterations;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long run = 0; run < iterations; run++)
+            {
+                legacy_parse(body, length);
+            }
+            legacy_ns = elapsed_ns(&start) / (double)iterations;
+            printf("%.1f %.1f\n", new_ns, legacy_ns);
+        }
+        else
+        {
+            printf("%d", (int)parse(body, length, chunk));
+            print_field(&fields[0]);
+            print_field(&fields[1]);
+            printf("\n");
+        }
+    }
+    (void)sink;
+    free(body);
+    return 0;
+}
+"""
+
+
+def decode(raw):
+    """Decodes '+' and percent escapes; returns the bytes and whether every
+    escape was well formed."""
+    output = bytearray()
+    valid = True
+    index = 0
+    while index < len(raw):
+        byte = raw[index]
+        if byte == ord("%"):
+            digits = raw[index + 1:index + 3]
+            if len(digits) == 2 and all(chr(d) in "0123456789abcdefABCDEF" for d in digits):
+                output.append(int(digits, 16))
+                index += 3
+                continue
+            valid = False
+        elif byte == ord("+"):
+            output.append(ord(" "))
+        else:
+            output.append(byte)
+        index += 1
+    return bytes(output), valid
+
+
+def reference(body):
+    """Returns the result and the fields expected for a body."""
+    values = {name: None for name, _, _ in FIELDS}
+    overflow = {name: False for name, _, _ in FIELDS}
+    valid = True
+
+    for segment in body.split(b"&"):
+        if not segment:
+            continue
+        raw_key, _, raw_value = segment.partition(b"=")
+        key, key_valid = decode(raw_key)
+        value, value_valid = decode(raw_value)
+        valid = valid and key_valid and value_valid
+        for name, capacity, _ in FIELDS:
+            if key == name.encode():
+                values[name] = value[:capacity]
+                overflow[name] = len(value) > capacity
+
+    if not valid:
+        result = "BAD_ESCAPE"
+    elif any(overflow.values()):
+        result = "VALUE_TOO_LONG"
+    elif any(required and values[name] is None for name, _, required in FIELDS):
+        result = "MISSING_FIELD"
+    else:
+        result = "OK"
+    return result, values
+
+
+def parse_output(line):
+    parts = line.split()
+    values = {}
+    for index, (name, _, _) in enumerate(FIELDS):
+        found, value = parts[1 + 2 * index], parts[2 + 2 * index]
+        values[name] = (b"" if value == "-" else bytes.fromhex(value)) if found == "1" else None
+    return RESULTS[int(parts[0])], values
+
+
+def record(body, chunk):
+    return struct.pack("<II", len(body), chunk) + body
+
+
+def mutate(body, seeds, rng):
+    data = bytearray(body)
+    for _ in range(rng.randint(1, 4)):
+        operation = rng.randrange(5)
+        position = rng.randint(0, len(data))
+        if operation == 0:
+            data[position:position] = bytes([rng.choice(MUTATION_BYTES)])
+        elif operation == 1 and data:
+            del data[min(position, len(data) - 1)]
+        elif operation == 2 and data:
+            data[min(position, len(data) - 1)] = rng.choice(MUTATION_BYTES)
+        elif operation == 3 and data:
+            start = rng.randrange(len(data))
+            data[position:position] = data[start:start + rng.randint(1, 40)]
+        else:
+            other = rng.choice(seeds)
+            data = data[:position] + other[rng.randint(0, len(other)):]
+    return bytes(data)
+
+
+def build(directory, compiler):
+    harness = os.path.join(directory, "harness.c")
+    binary = os.path.join(directory, "form_parser_harness")
+    with open(harness, "w", encoding="utf-8") as source:
+        source.write(HARNESS)
+    subprocess.run([compiler, "-O2", "-std=c11", "-D_POSIX_C_SOURCE=199309L", "-Wall", "-I", SOURCE_DIR,
+                    harness, os.path.join(SOURCE_DIR, "form_parser.c"),
+                    os.path.join(SOURCE_DIR, "url_decode.c"), "-o", binary], check=True)
+    return binary
+
+
+def check(binary, args):
+    seeds = []
+    for name in sorted(os.listdir(args.corpus)):
+        with open(os.path.join(args.corpus, name), "rb") as corpus_file:
+            seeds.append(corpus_file.read())
+    if not seeds:
+        sys.exit("No bodies in %s" % args.corpus)
+
+    rng = random.Random(args.seed)
+    bodies = [(seed, 0) for seed in seeds]
+    bodies += [(seed, rng.randint(1, 8)) for seed in seeds]
+    for _ in range(args.cases):
+        body = mutate(rng.choice(seeds), seeds, rng)
+        bodies.append((body, rng.choice([0, 1, 2, 3, rng.randint(1, max(1, len(body)))])))
+
+    output = subprocess.run([binary], input=b"".join(record(body, chunk) for body, chunk in bodies),
+                            stdout=subprocess.PIPE, check=True).stdout.decode().splitlines()
+
+    failures = 0
+    for (body, chunk), line in zip(bodies, output):
+        result, values = parse_output(line)
+        expected_result, expected_values = reference(body)
+        if result != expected_result or (result != "BAD_ESCAPE" and values != expected_values):
+            failures += 1
+            print("MISMATCH pieces of %u: %s" % (chunk, body.hex()))
+            print("  parser    %s %s" % (result, values))
+            print("  reference %s %s" % (expected_result, expected_values))
+
+    counts = {}
+    for line in output:
+        counts[RESULTS[int(line.split()[0])]] = counts.get(RESULTS[int(line.split()[0])], 0) + 1
+    print("Checked %u bodies (%u corpus, %u mutated), %u mismatches: %s" % (
+        len(bodies), 2 * len(seeds), args.cases, failures,
+        ", ".join("%s %u" % item for item in sorted(counts.items()))))
+    return failures == 0
+
+
+def bench(binary, args):
+    names = list(BENCH_BODIES)
+    output = subprocess.run([binary, "bench", str(args.iterations)],
+                            input=b"".join(record(BENCH_BODIES[name], 0) for name in names),
+                            stdout=subprocess.PIPE, check=True).stdout.decode().splitlines()
+
+    print("%-14s %6s %12s %12s %12s %12s" % ("body", "bytes", "parser ns", "parser MB/s", "previous ns", "previous MB/s"))
+    for name, line in zip(names, output):
+        new_ns, legacy_ns = (float(value) for value in line.split())
+        size = len(BENCH_BODIES[name])
+        print("%-14s %6u %12.1f %12.1f %12.1f %12.1f" % (name, size, new_ns, size * 1e3 / new_ns,
+                                                         legacy_ns, size * 1e3 / legacy_ns))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check and benchmark the form parser on the host.")
+    parser.add_argument("--cases", type=int, default=20000, help="number of mutated bodies")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--iterations", type=int, default=200000, help="parses timed per body")
+    parser.add_argument("--corpus", default=os.path.join(SCRIPT_DIR, "form_corpus"))
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--skip-bench", action="store_true")
+    args = parser.parse_args()
+
+    if shutil.which(args.cc) is None:
+        sys.exit("Compiler %s not found, select one with --cc" % args.cc)
+
+    directory = tempfile.mkdtemp()
+    try:
+        binary = build(directory, args.cc)
+        passed = check(binary, args)
+        if not args.skip_bench:
+            bench(binary, args)
+    finally:
+        shutil.rmtree(directory)
+
+    return 0 if passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
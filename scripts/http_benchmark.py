@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+HTTP request benchmark for the web server.
+
+Sends a series of requests to the device and reports the request rate and
+the latency percentiles, once over a single persistent connection and once
+with a new connection for every request, so the gain of connection reuse
+can be measured. The default request is the control request sent by the
+"Increase" button of the device data page.
+
+Usage:
+    http_benchmark.py HOST [--port PORT] [--method POST] [--path /]
+                      [--body Increase] [--requests N] [--mode both]
+
+The rate limiter of the device answers requests beyond its budget with 429;
+these are counted separately. Build the firmware with RATE_LIMIT_DISABLED in
+DEFINES to measure the server itself.
+"""
+
+import argparse
+import http.client
+import socket
+import sys
+import time
+
+
+def percentile(samples, fraction):
+    """Returns the sample below which the given fraction of samples lie."""
+    if not samples:
+        return 0.0
+    ordered = sorted(samples)
+    index = min(len(ordered) - 1, max(0, int(round(fraction * len(ordered) + 0.5)) - 1))
+    return ordered[index]
+
+
+def run(args, reuse):
+    """Sends args.requests requests and returns the statistics of the run."""
+    headers = {"Connection": "keep-alive" if reuse else "close"}
+    body = args.body.encode() if args.method == "POST" else None
+    if body is not None:
+        headers["Content-Type"] = "text/plain"
+
+    latencies = []
+    statuses = {}
+    errors = 0
+    connections = 0
+    connection = None
+
+    start = time.perf_counter()
+    for _ in range(args.requests):
+        request_start = time.perf_counter()
+        try:
+            if connection is None:
+                connection = http.client.HTTPConnection(args.host, args.port, timeout=args.timeout)
+                connections += 1
+            connection.request(args.method, args.path, body=body, headers=headers)
+            response = connection.getresponse()
+            response.read()
+            statuses[response.status] = statuses.get(response.status, 0) + 1
+            if not reuse or response.will_close:
+                connection.close()
+                connection = None
+        except (OSError, http.client.HTTPException):
+            errors += 1
+            if connection is not None:
+                connection.close()
+                connection = None
+            continue
+        latencies.append(time.perf_counter() - request_start)
+    elapsed = time.perf_counter() - start
+
+    if connection is not None:
+        connection.close()
+
+    return {
+        "completed": len(latencies),
+        "errors": errors,
+        "connections": connections,
+        "statuses": statuses,
+        "rate": len(latencies) / elapsed if elapsed > 0 else 0.0,
+        "p50": percentile(latencies, 0.50) * 1000.0,
+        "p99": percentile(latencies, 0.99) * 1000.0,
+    }
+
+
+def report(name, result):
+    statuses = ", ".join("%u: %u" % item for item in sorted(result["statuses"].items()))
+    print("%-8s %5u ok %4u errors %4u connections %8.1f req/s  p50 %7.1f ms  p99 %7.1f ms  [%s]" % (
+        name, result["completed"], result["errors"], result["connections"],
+        result["rate"], result["p50"], result["p99"], statuses))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure request rate and latency with and without connection reuse.")
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--method", default="POST", choices=["GET", "POST"])
+    parser.add_argument("--path", default="/")
+    parser.add_argument("--body", default="Increase")
+    parser.add_argument("--requests", type=int, default=200)
+    parser.add_argument("--timeout", type=float, default=5.0)
+    parser.add_argument("--mode", default="both", choices=["reuse", "close", "both"])
+    args = parser.parse_args()
+
+    try:
+        socket.getaddrinfo(args.host, args.port)
+    except socket.gaierror as error:
+        sys.exit("Cannot resolve %s: %s" % (args.host, error))
+
+    print("%s %s on %s:%u, %u requests" % (args.method, args.path, args.host, args.port, args.requests))
+    if args.mode in ("reuse", "both"):
+        report("reuse", run(args, True))
+    if args.mode in ("close", "both"):
+        report("close", run(args, False))
+
+
+if __name__ == "__main__":
+    main()
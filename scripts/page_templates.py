@@ -0,0 +1,362 @@
+#!/usr/bin/env python3
+"""
+Page template compiler.
+
+Turns the HTML pages in web/templates into tables of constant text
+segments and named slots, written to source/page_templates.c and
+source/page_templates.h. The segments are rendered from flash by
+template_render() and the slots are filled in by the caller while the page
+is being streamed, so no page has to be assembled in RAM.
+
+A slot is written as {{name}} in a template and becomes PAGE_SLOT_NAME in
+the generated page_slot_t enumeration. A file from web/include is inserted
+with <!--#include file="name.html" -->.
+
+Every page is minified before it is compiled: comments are removed, the
+whitespace used to lay out the markup is dropped and the inline CSS and
+JavaScript are compacted. Inline scripts must end their statements with
+semicolons, as line breaks are not kept. The size of each page before and
+after minification is reported.
+
+Usage: page_templates.py [--templates DIR] [--include DIR] [--output DIR]
+                         [--no-minify]
+
+The output files are only rewritten when their content changes, so running
+the script as a pre-build step does not trigger needless rebuilds.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+APP_DIR = os.path.dirname(SCRIPT_DIR)
+
+SLOT_PATTERN = re.compile(r"\{\{\s*([A-Za-z_][A-Za-z0-9_]*)\s*\}\}")
+
+INCLUDE_PATTERN = re.compile(r'<!--#include\s+file="([^"]+)"\s*-->')
+COMMENT_PATTERN = re.compile(r"<!--.*?-->", re.S)
+RAW_TEXT_PATTERN = re.compile(r"(<(script|style)\b[^>]*>)(.*?)(</\2\s*>)", re.S | re.I)
+
+# Characters which never need whitespace next to them in CSS and JavaScript.
+CSS_PUNCTUATION = "{}:;,>"
+JS_PUNCTUATION = "{}()[];,:=<>!&|?*/%+-."
+
+# Longest C string literal line emitted in the generated source.
+LITERAL_LINE_LENGTH = 72
+
+LICENSE = """\
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/"""
+
+
+def file_header(file_name, description):
+    lines = ["/" + "*" * 78,
+             "* File Name: " + file_name,
+             "*"]
+    for index, line in enumerate(description):
+        lines.append(("* Description: " if index == 0 else "*              ") + line)
+    lines += ["*", "*" * 80, LICENSE, ""]
+    return "\n".join(lines)
+
+
+def expand_includes(text, include_dir, depth=0):
+    """Replaces the include directives with the content of the named files."""
+    if depth > 4:
+        sys.exit("Includes nested too deeply")
+
+    def insert(match):
+        with open(os.path.join(include_dir, match.group(1)), "r", encoding="utf-8") as include:
+            return expand_includes(include.read(), include_dir, depth + 1)
+
+    return INCLUDE_PATTERN.sub(insert, text)
+
+
+def split_code(text, comment_styles):
+    """Splits CSS or JavaScript into ("code", text) and ("string", text) pieces,
+    dropping the comments."""
+    pieces = []
+    code = ""
+    position = 0
+    while position < len(text):
+        char = text[position]
+        if char in "\"'`":
+            end = position + 1
+            while end < len(text) and text[end] != char:
+                end += 2 if text[end] == "\\" else 1
+            pieces += [("code", code), ("string", text[position:end + 1])]
+            code = ""
+            position = end + 1
+        elif text.startswith("/*", position):
+            end = text.find("*/", position + 2)
+            position = len(text) if end < 0 else end + 2
+            code += " "
+        elif "//" in comment_styles and text.startswith("//", position):
+            end = text.find("\n", position)
+            position = len(text) if end < 0 else end
+        else:
+            code += char
+            position += 1
+    pieces.append(("code", code))
+    return pieces
+
+
+def compact_code(text, punctuation, comment_styles):
+    """Removes comments and every whitespace run which does not separate two
+    words, or two operators which would otherwise merge."""
+    result = ""
+    for kind, piece in split_code(text, comment_styles):
+        if kind == "string":
+            result += piece
+            continue
+        for index, word in enumerate(re.split(r"\s+", piece)):
+            if index > 0 and result and word:
+                left = result[-1]
+                right = word[0]
+                if not (left in punctuation or right in punctuation) or \
+                        (left in "+-" and right in "+-"):
+                    result += " "
+            result += word
+    return result
+
+
+def minify_css(text):
+    return compact_code(text, CSS_PUNCTUATION, ()).replace(";}", "}")
+
+
+def minify_js(text):
+    return compact_code(text, JS_PUNCTUATION, ("//",))
+
+
+def minify_markup(text):
+    """Collapses whitespace in markup. Whitespace that contains a line break
+    and touches a tag is only layout and is dropped; any other run becomes a
+    single space."""
+    def collapse(match):
+        run = match.group(0)
+        before = text[match.start() - 1] if match.start() > 0 else "<"
+        after = text[match.end()] if match.end() < len(text) else ">"
+        if "\n" in run and (before == ">" or after == "<"):
+            return ""
+        if after == ">" or (after == "/" and text.startswith("/>", match.end())):
+            return ""
+        return " "
+
+    return re.sub(r"\s+", collapse, text)
+
+
+def minify(text):
+    """Minifies a page, including its inline CSS and JavaScript."""
+    text = COMMENT_PATTERN.sub("", text)
+    result = ""
+    position = 0
+    for match in RAW_TEXT_PATTERN.finditer(text):
+        result += minify_markup(text[position:match.start()])
+        code = minify_js(match.group(3)) if match.group(2).lower() == "script" \
+            else minify_css(match.group(3))
+        result += minify_markup(match.group(1)) + code.strip() + match.group(4)
+        position = match.end()
+    result += minify_markup(text[position:])
+    return result.strip()
+
+
+def join_lines(text):
+    """Drops line breaks and indentation without minifying the page."""
+    return " ".join(line.strip() for line in text.splitlines() if line.strip())
+
+
+def parse_template(text):
+    """Splits a template into ("text", value) and ("slot", name) segments."""
+    segments = []
+    position = 0
+    for match in SLOT_PATTERN.finditer(text):
+        if match.start() > position:
+            segments.append(("text", text[position:match.start()]))
+        segments.append(("slot", match.group(1).lower()))
+        position = match.end()
+    if position < len(text):
+        segments.append(("text", text[position:]))
+    return segments
+
+
+def c_literal(data):
+    """Formats bytes as one or more C string literal lines."""
+    lines = []
+    current = ""
+    for byte in data:
+        char = chr(byte)
+        if char == '"':
+            piece = '\\"'
+        elif char == "\\":
+            piece = "\\\\"
+        elif 0x20 <= byte < 0x7f:
+            piece = char
+        else:
+            piece = "\\%03o" % byte
+        if len(current) + len(piece) > LITERAL_LINE_LENGTH:
+            lines.append(current)
+            current = ""
+        current += piece
+    lines.append(current)
+    return "\n".join('    "%s"' % line for line in lines)
+
+
+def slot_enum(name):
+    return "PAGE_SLOT_" + name.upper()
+
+
+def generate(templates):
+    slots = sorted({value for _, segments in templates
+                    for kind, value in segments if kind == "slot"})
+
+    header = [file_header("page_templates.h",
+                          ["This file is generated by scripts/page_templates.py",
+                           "from web/templates. Do not edit it by hand."]),
+              "/" + "*" * 79,
+              "* Include guard",
+              "*" * 79 + "/",
+              "#ifndef PAGE_TEMPLATES_H_",
+              "#define PAGE_TEMPLATES_H_",
+              "",
+              '#include "template_engine.h"',
+              "",
+              "/" + "*" * 79,
+              "* Macros",
+              "*" * 79 + "/",
+              "/* Length of the constant text of each page, excluding the slots */"]
+    for name, segments in templates:
+        length = sum(len(value.encode("utf-8")) for kind, value in segments if kind == "text")
+        header.append("#define %-48s(%uu)" % ("PAGE_%s_LENGTH" % name.upper(), length))
+    header += ["",
+              "/" + "*" * 79,
+              " *                    Enumerations",
+              "*" * 79 + "/",
+              "typedef enum",
+              "{"]
+    for slot in slots:
+        header.append("    %s," % slot_enum(slot))
+    header += ["    PAGE_SLOT_COUNT",
+               "} page_slot_t;",
+               "",
+               "/" + "*" * 79,
+               " *                    Global Variables",
+               "*" * 79 + "/"]
+    for name, _ in templates:
+        header.append("extern const page_template_t page_%s;" % name)
+    header += ["", "#endif /* PAGE_TEMPLATES_H_ */", "", "/* [] END OF FILE */", ""]
+
+    source = [file_header("page_templates.c",
+                          ["This file is generated by scripts/page_templates.py",
+                           "from web/templates. Do not edit it by hand."]),
+              "#include <stddef.h>",
+              "",
+              '#include "page_templates.h"']
+    for name, segments in templates:
+        source += ["", "/* web/templates/%s.html */" % name]
+        rows = []
+        text_index = 0
+        for kind, value in segments:
+            if kind == "text":
+                data = value.encode("utf-8")
+                symbol = "page_%s_text_%u" % (name, text_index)
+                text_index += 1
+                source += ["static const char %s[] =" % symbol, c_literal(data) + ";"]
+                rows.append("    { %s, %uu, 0u }," % (symbol, len(data)))
+            else:
+                rows.append("    { NULL, 0u, %s }," % slot_enum(value))
+        source += ["",
+                   "static const template_segment_t page_%s_segments[] =" % name,
+                   "{"] + rows + ["};",
+                   "",
+                   "const page_template_t page_%s =" % name,
+                   "{",
+                   "    page_%s_segments, %uu" % (name, len(segments)),
+                   "};"]
+    source += ["", "/* [] END OF FILE */", ""]
+
+    return "\n".join(header), "\n".join(source)
+
+
+def write_if_changed(path, content):
+    if os.path.exists(path):
+        with open(path, "r", newline="") as existing:
+            if existing.read() == content:
+                return False
+    with open(path, "w", newline="\n") as output:
+        output.write(content)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile the HTML page templates to C.")
+    parser.add_argument("--templates", default=os.path.join(APP_DIR, "web", "templates"))
+    parser.add_argument("--include", default=os.path.join(APP_DIR, "web", "include"))
+    parser.add_argument("--output", default=os.path.join(APP_DIR, "source"))
+    parser.add_argument("--no-minify", action="store_true",
+                        help="keep the pages as written, only dropping the line breaks")
+    args = parser.parse_args()
+
+    templates = []
+    total_source = 0
+    total_output = 0
+    for file_name in sorted(os.listdir(args.templates)):
+        base, extension = os.path.splitext(file_name)
+        if extension != ".html":
+            continue
+        if not re.match(r"^[a-z][a-z0-9_]*$", base):
+            sys.exit("Template name is not a valid C identifier: " + file_name)
+        with open(os.path.join(args.templates, file_name), "r", encoding="utf-8") as template:
+            text = expand_includes(template.read(), args.include)
+        page = join_lines(COMMENT_PATTERN.sub("", text)) if args.no_minify else minify(text)
+        templates.append((base, parse_template(page)))
+
+        source_length = len(text.encode("utf-8"))
+        output_length = len(page.encode("utf-8"))
+        total_source += source_length
+        total_output += output_length
+        print("%-28s %6u -> %6u bytes, saved %6u (%2u%%)"
+              % (file_name, source_length, output_length, source_length - output_length,
+                 (100 * (source_length - output_length)) // max(source_length, 1)))
+    print("%-28s %6u -> %6u bytes, saved %6u (%2u%%)"
+          % ("Total", total_source, total_output, total_source - total_output,
+             (100 * (total_source - total_output)) // max(total_source, 1)))
+
+    header, source = generate(templates)
+    for file_name, content in (("page_templates.h", header), ("page_templates.c", source)):
+        path = os.path.join(args.output, file_name)
+        if write_if_changed(path, content):
+            print("Generated " + os.path.relpath(path, APP_DIR))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+RAM report of the application, read from the map file of the GCC linker.
+
+Lists the statically allocated RAM by module, the largest variables and the
+storage of the tasks, queues and mutexes, which are all created statically
+(see source/rtos_memory.c), and shows the RAM reclaimed after provisioning:
+the provisioning arena holds the buffers used only while the device is
+provisioned over the SoftAP, and is handed over to the sensor history once
+the STA server has taken over.
+
+Usage:
+    ram_report.py [MAP] [--baseline MAP] [--top N]
+
+MAP defaults to the map file found under build/, such as
+build/CY8CPROTO-062-4343W/Debug/mtb-example-wifi-web-server.map. With
+--baseline, the variables whose size changed between the two map files are
+listed as well, for example to compare the build before and after a change.
+"""
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+APP_DIR = os.path.dirname(SCRIPT_DIR)
+
+# Output sections placed in RAM by the linker scripts of the application.
+RAM_SECTIONS = (".ramVectors", ".data", ".noinit", ".bss", ".heap", ".cy_sharedmem")
+
+# Suffixes of the storage of the statically created RTOS objects.
+RTOS_STORAGE = re.compile(r"_(stack|tcb|queue_storage|queue_buffer|mutex_buffer)$")
+
+# Mirror of the provisioning arena and of the sensor history records.
+ARENA_SYMBOL = "provisioning_arena"
+HISTORY_RECORD_SIZE = 8
+HISTORY_SAMPLE_INTERVAL_SEC = 60
+
+INPUT_SECTION = re.compile(r"^ (\.[\w.$]+|COMMON)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S+))?\s*$")
+ADDRESS_LINE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S+)\s*$")
+OUTPUT_SECTION = re.compile(r"^(\.[\w.$]+)(?:\s+0x[0-9a-fA-F]+)?")
+
+
+def find_map():
+    maps = glob.glob(os.path.join(APP_DIR, "build", "**", "*.map"), recursive=True)
+    if not maps:
+        sys.exit("No map file found under build/, build the application or give the map file")
+    return max(maps, key=os.path.getmtime)
+
+
+def module_name(path):
+    """Returns the object file of an input section, or the archive member."""
+    member = re.search(r"\(([^)]+)\)$", path)
+    name = member.group(1) if member else os.path.basename(path)
+    return re.sub(r"\.o(bj)?$", "", name)
+
+
+def parse_map(path):
+    """Returns the RAM variables of a map file as (section, symbol, module, size)."""
+    variables = []
+    output_section = None
+    pending = None
+    in_map = False
+
+    with open(path, encoding="utf-8", errors="replace") as map_file:
+        for line in map_file:
+            if line.startswith("Linker script and memory map"):
+                in_map = True
+                continue
+            if not in_map:
+                continue
+
+            if pending is not None:
+                match = ADDRESS_LINE.match(line)
+                if match:
+                    size = int(match.group(2), 16)
+                    if size:
+                        variables.append((output_section, pending, module_name(match.group(3)), size))
+                pending = None
+                continue
+
+            match = OUTPUT_SECTION.match(line)
+            if match:
+                output_section = match.group(1)
+                continue
+            if output_section not in RAM_SECTIONS:
+                continue
+
+            match = INPUT_SECTION.match(line)
+            if match:
+                name = match.group(1)
+                symbol = re.sub(r"^\.(bss|data|noinit|sbss|sdata)\.", "", name)
+                if match.group(3) is None:
+                    pending = symbol
+                elif int(match.group(3), 16):
+                    variables.append((output_section, symbol, module_name(match.group(4)), int(match.group(3), 16)))
+
+    return variables
+
+
+def report(variables, top):
+    sections = {}
+    modules = {}
+    for section, _, module, size in variables:
+        sections[section] = sections.get(section, 0) + size
+        modules[module] = modules.get(module, 0) + size
+
+    print("RAM by output section")
+    for section in RAM_SECTIONS:
+        if section in sections:
+            print("  %-16s %8u" % (section, sections[section]))
+    print("  %-16s %8u" % ("total", sum(sections.values())))
+
+    print("\nRAM by module (top %u)" % top)
+    for module, size in sorted(modules.items(), key=lambda item: -item[1])[:top]:
+        print("  %-40s %8u" % (module, size))
+
+    print("\nLargest variables (top %u)" % top)
+    for section, symbol, module, size in sorted(variables, key=lambda item: -item[3])[:top]:
+        print("  %-40s %-10s %-24s %8u" % (symbol, section, module, size))
+
+    rtos = [(symbol, module, size) for _, symbol, module, size in variables if RTOS_STORAGE.search(symbol)]
+    print("\nRTOS object storage")
+    for symbol, module, size in sorted(rtos, key=lambda item: -item[2]):
+        print("  %-40s %-24s %8u" % (symbol, module, size))
+    print("  %-40s %-24s %8u" % ("total", "", sum(size for _, _, size in rtos)))
+
+    arena = sum(size for _, symbol, _, size in variables if symbol == ARENA_SYMBOL)
+    print("\nReclaimed after provisioning")
+    if arena:
+        records = arena // HISTORY_RECORD_SIZE
+        print("  %s: %u bytes, handed over to the sensor history as %u records (%.1f hours)" % (
+            ARENA_SYMBOL, arena, records, records * HISTORY_SAMPLE_INTERVAL_SEC / 3600.0))
+    else:
+        print("  %s not found in the map file" % ARENA_SYMBOL)
+
+
+def compare(variables, baseline, top):
+    def sizes(entries):
+        result = {}
+        for _, symbol, module, size in entries:
+            result[(symbol, module)] = result.get((symbol, module), 0) + size
+        return result
+
+    new, old = sizes(variables), sizes(baseline)
+    changes = [(key, old.get(key, 0), new.get(key, 0)) for key in set(new) | set(old)
+               if old.get(key, 0) != new.get(key, 0)]
+    print("\nChanged variables against the baseline (top %u)" % top)
+    for (symbol, module), before, after in sorted(changes, key=lambda item: -abs(item[2] - item[1]))[:top]:
+        print("  %-40s %-24s %8u -> %8u %+8d" % (symbol, module, before, after, after - before))
+    print("  %-40s %-24s %8u -> %8u %+8d" % ("total", "", sum(old.values()), sum(new.values()),
+                                            sum(new.values()) - sum(old.values())))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the RAM used by the application from a map file.")
+    parser.add_argument("map", nargs="?", help="map file of the GCC linker")
+    parser.add_argument("--baseline", help="map file to compare with")
+    parser.add_argument("--top", type=int, default=15, help="number of modules and variables listed")
+    args = parser.parse_args()
+
+    path = args.map or find_map()
+    variables = parse_map(path)
+    if not variables:
+        sys.exit("No RAM variables found in %s" % path)
+
+    print("Map file: %s\n" % path)
+    report(variables, args.top)
+    if args.baseline:
+        compare(variables, parse_map(args.baseline), args.top)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
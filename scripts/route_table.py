@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""
+Route table compiler.
+
+Turns the route list in web/routes.txt into a constant table in
+source/route_table.c and source/route_table.h. A route is looked up by its
+server, method and path through a minimal perfect hash, the same hash and
+displace scheme as the asset image: the key is one byte for the server, one
+byte for the method and the path, hashed with seeded 32-bit FNV-1a. The
+lookup therefore costs two hashes and one string compare however many
+routes there are.
+
+Every path is registered once with the HTTP server, whatever the number of
+methods it supports, and the route dispatcher in router.c selects the
+handler of the method. The files of web/assets are served through routes
+to asset_resource_handler, which must be GET routes to existing files.
+
+Usage: route_table.py [--routes FILE] [--output DIR]
+
+The output files are only rewritten when their content changes, so running
+the script as a pre-build step does not trigger needless rebuilds.
+"""
+
+import argparse
+import os
+import sys
+
+from asset_image import build_index
+from page_templates import APP_DIR, file_header, write_if_changed
+
+# Values of route_server_t.
+SERVERS = {"ap": (0, "ROUTE_SERVER_AP"), "sta": (1, "ROUTE_SERVER_STA")}
+
+# Values of cy_http_request_type_t, which the dispatcher hashes as they are.
+METHODS = {"GET": (0, "CY_HTTP_REQUEST_GET"),
+           "POST": (1, "CY_HTTP_REQUEST_POST"),
+           "PUT": (2, "CY_HTTP_REQUEST_PUT")}
+
+CLASSES = {"control": "ROUTE_CLASS_CONTROL",
+           "page": "ROUTE_CLASS_PAGE",
+           "scan": "ROUTE_CLASS_SCAN",
+           "events": "ROUTE_CLASS_EVENTS"}
+
+# Handler of the files of web/assets, served through the route table.
+ASSET_HANDLER = "asset_resource_handler"
+ASSET_DIR = os.path.join(APP_DIR, "web", "assets")
+
+MACRO_WIDTH = 48
+
+
+def read_routes(file_name):
+    routes = []
+    keys = set()
+    with open(file_name, "r", encoding="utf-8") as routes_file:
+        for number, line in enumerate(routes_file, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            if len(fields) != 5:
+                sys.exit("%s:%u: expected server, method, path, class and handler" % (file_name, number))
+            server, method, path, request_class, handler = fields
+            if server not in SERVERS or method not in METHODS or request_class not in CLASSES:
+                sys.exit("%s:%u: unknown server, method or class" % (file_name, number))
+            if not path.startswith("/"):
+                sys.exit("%s:%u: the path must start with /" % (file_name, number))
+            if handler == ASSET_HANDLER and (method != "GET" or
+                                             not os.path.isfile(os.path.join(ASSET_DIR, path.lstrip("/")))):
+                sys.exit("%s:%u: an asset route must be a GET route to a file of web/assets" % (file_name, number))
+            key = bytes([SERVERS[server][0], METHODS[method][0]]) + path.encode()
+            if key in keys:
+                sys.exit("%s:%u: duplicate route" % (file_name, number))
+            keys.add(key)
+            routes.append({"server": server, "method": method, "path": path,
+                           "class": request_class, "handler": handler, "key": key})
+    return routes
+
+
+def route_paths(routes):
+    """Returns the distinct (server, path) pairs with their methods, in the
+    order they first appear."""
+    paths = []
+    for route in routes:
+        for entry in paths:
+            if entry["server"] == route["server"] and entry["path"] == route["path"]:
+                entry["methods"].append(route["method"])
+                break
+        else:
+            paths.append({"server": route["server"], "path": route["path"],
+                          "methods": [route["method"]]})
+    return paths
+
+
+def c_string(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def generate_header(routes, paths, seed):
+    handlers = []
+    for route in routes:
+        if route["handler"] not in handlers:
+            handlers.append(route["handler"])
+
+    lines = [file_header("route_table.h",
+                         ["This file is generated by scripts/route_table.py",
+                          "from web/routes.txt. Do not edit it by hand."]),
+             "/" + "*" * 79,
+             "* Include guard",
+             "*" * 79 + "/",
+             "#ifndef ROUTE_TABLE_H_",
+             "#define ROUTE_TABLE_H_",
+             "",
+             '#include "router.h"',
+             "",
+             "/" + "*" * 79,
+             "* Macros",
+             "*" * 79 + "/",
+             "/* Number of routes and of distinct paths of each server */",
+             "#define %-*s (%uu)" % (MACRO_WIDTH - 1, "ROUTE_COUNT", len(routes)),
+             "#define %-*s (%uu)" % (MACRO_WIDTH - 1, "ROUTE_PATH_COUNT", len(paths))]
+    for server in sorted(SERVERS, key=lambda name: SERVERS[name][0]):
+        count = sum(1 for entry in paths if entry["server"] == server)
+        lines.append("#define %-*s (%uu)" % (MACRO_WIDTH - 1, "ROUTE_PATH_COUNT_" + server.upper(), count))
+    lines += ["/* Seed of the hash selecting the bucket of a route */",
+              "#define %-*s (%uu)" % (MACRO_WIDTH - 1, "ROUTE_HASH_SEED", seed),
+              "",
+              "/" + "*" * 79,
+              " *                    Global Variables",
+              "*" * 79 + "/",
+              "extern const route_t route_table[ROUTE_COUNT];",
+              "extern const int16_t route_displacement[ROUTE_COUNT];",
+              "extern const route_path_t route_paths[ROUTE_PATH_COUNT];",
+              "",
+              "/" + "*" * 79,
+              " * Function Prototypes",
+              "*" * 79 + "/"]
+    for handler in handlers:
+        lines.append("int32_t %s(const char *url_path, const char *url_parameters,\n"
+                     "%s cy_http_response_stream_t *stream, void *arg,\n"
+                     "%s cy_http_message_body_t *http_message_body);"
+                     % (handler, " " * (len(handler) + 8), " " * (len(handler) + 8)))
+    lines += ["", "#endif /* ROUTE_TABLE_H_ */", "", "/* [] END OF FILE */", ""]
+    return "\n".join(lines)
+
+
+def generate_source(routes, paths, displacement, slots):
+    by_slot = sorted(routes, key=lambda route: slots[route["key"]])
+    lines = [file_header("route_table.c",
+                         ["This file is generated by scripts/route_table.py",
+                          "from web/routes.txt. Do not edit it by hand."]),
+             '#include "web_server.h"',
+             '#include "route_table.h"',
+             "",
+             "/* Routes in the order of their hash slots. */",
+             "const route_t route_table[ROUTE_COUNT] =",
+             "{"]
+    for route in by_slot:
+        lines.append("    { %s, %s, %u, %s, %s, %s }," % (
+            c_string(route["path"]), route["handler"], len(route["path"].encode()),
+            SERVERS[route["server"]][1], METHODS[route["method"]][1], CLASSES[route["class"]]))
+    lines += ["};",
+              "",
+              "/* Displacement of each bucket: d >= 0 selects the slot",
+              " * hash(d, key) % ROUTE_COUNT, d < 0 selects the slot -d - 1.",
+              " */",
+              "const int16_t route_displacement[ROUTE_COUNT] =",
+              "{",
+              "    " + " ".join("%d," % value for value in displacement),
+              "};",
+              "",
+              "/* Paths registered with the HTTP servers, with their methods. */",
+              "const route_path_t route_paths[ROUTE_PATH_COUNT] =",
+              "{"]
+    for entry in paths:
+        methods = " | ".join("ROUTE_METHOD_MASK(%s)" % METHODS[method][1] for method in entry["methods"])
+        lines.append("    { %s, %s, %s }," % (c_string(entry["path"]), SERVERS[entry["server"]][1], methods))
+    lines += ["};", "", "/* [] END OF FILE */", ""]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile the HTTP route list to C.")
+    parser.add_argument("--routes", default=os.path.join(APP_DIR, "web", "routes.txt"))
+    parser.add_argument("--output", default=os.path.join(APP_DIR, "source"))
+    args = parser.parse_args()
+
+    routes = read_routes(args.routes)
+    if not routes:
+        sys.exit("No routes in " + args.routes)
+    paths = route_paths(routes)
+
+    keys = [route["key"] for route in routes]
+    seed = 0
+    index = build_index(keys, seed)
+    while index is None:
+        seed += 1
+        index = build_index(keys, seed)
+    displacement, slots = index
+
+    for route in sorted(routes, key=lambda route: slots[route["key"]]):
+        print("%-4s %-5s %-24s %-8s %s" % (route["server"], route["method"], route["path"],
+                                          route["class"], route["handler"]))
+    print("%u routes, %u paths, hash seed %u" % (len(routes), len(paths), seed))
+
+    for file_name, content in (("route_table.h", generate_header(routes, paths, seed)),
+                               ("route_table.c", generate_source(routes, paths, displacement, slots))):
+        if write_if_changed(os.path.join(args.output, file_name), content):
+            print("Generated source/" + file_name)
+
+
+if __name__ == "__main__":
+    main()
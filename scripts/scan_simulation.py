@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+Host simulation of the filtered Wi-Fi scans of the scan page.
+
+Stands in for the Wi-Fi driver: a scan sweeps a list of channels, dwelling
+on each one actively or passively (DFS channels may only be listened to),
+and in AP+STA mode returns to the SoftAP channel between two channels. The
+query parameters of /wifi_scan_form are mapped onto the scan filter of the
+Wi-Fi connection manager exactly as scan_options_to_wcm_filter() does in
+source/scan_filter.c, and the remaining options are applied to every result
+as scan_options_match() does. A band filter restricts the sweep to the
+channels of the band; the SSID and RSSI filters only reduce the results.
+
+Usage:
+    scan_simulation.py [--aps N] [--seed S] [--active-msec 40]
+                       [--passive-msec 110] [--home-msec 45] [--no-softap]
+                       [QUERY ...]
+
+Each QUERY is a query string such as "channels=1,6,11&min_rssi=-70"; a set
+of typical queries is simulated when none is given. The results are printed
+as a table of swept channels, scan time and listed APs for every query,
+along with the speedup over the unfiltered scan.
+"""
+
+import argparse
+import random
+import sys
+from urllib.parse import parse_qs
+
+CHANNELS_2_4GHZ = list(range(1, 14))
+CHANNELS_5GHZ = [36, 40, 44, 48, 52, 56, 60, 64, 100, 104, 108, 112, 116, 120,
+                 124, 128, 132, 136, 140, 144, 149, 153, 157, 161, 165]
+DFS_CHANNELS = set(range(52, 65, 4)) | set(range(100, 145, 4))
+
+# Mirror of the limits and RSSI ranges used by source/scan_filter.c.
+MAX_2_4GHZ_CHANNEL = 14
+SCAN_FILTER_MAX_CHANNELS = 16
+SCAN_FILTER_MAX_CHANNEL = 196
+SCAN_FILTER_SSID_LENGTH = 32
+SCAN_FILTER_MIN_RSSI = -127
+RSSI_RANGES = [("EXCELLENT", -50), ("GOOD", -60), ("FAIR", -90)]
+
+DEFAULT_QUERIES = [
+    "",
+    "ssid=Office",
+    "ssid_prefix=Guest",
+    "min_rssi=-60",
+    "channels=1,6,11",
+    "channels=36,40,44,48",
+    "channels=1,6,36",
+    "channels=1,6,11&min_rssi=-70",
+]
+
+
+def parse_options(query):
+    """Returns the scan options of a query string, ignoring invalid ones."""
+    params = parse_qs(query, keep_blank_values=True)
+    options = {"channels": [], "ssid": "", "prefix": False, "rssi_floor": None}
+
+    if "channels" in params:
+        try:
+            channels = [int(value) for value in params["channels"][0].split(",")]
+            if (0 < len(channels) <= SCAN_FILTER_MAX_CHANNELS and
+                    all(0 < channel <= SCAN_FILTER_MAX_CHANNEL for channel in channels)):
+                options["channels"] = channels
+        except ValueError:
+            pass
+
+    for key, prefix in (("ssid", False), ("ssid_prefix", True)):
+        if key in params:
+            ssid = params[key][0]
+            if 0 < len(ssid.encode()) <= SCAN_FILTER_SSID_LENGTH:
+                options["ssid"] = ssid
+                options["prefix"] = prefix
+            break
+
+    if "min_rssi" in params:
+        try:
+            rssi = int(params["min_rssi"][0])
+            if SCAN_FILTER_MIN_RSSI <= rssi <= 0:
+                options["rssi_floor"] = rssi
+        except ValueError:
+            pass
+
+    return options
+
+
+def wcm_filter(options):
+    """Returns the scan filter selected by scan_options_to_wcm_filter()."""
+    if options["ssid"] and not options["prefix"]:
+        return ("SSID", options["ssid"])
+
+    channels = options["channels"]
+    if channels:
+        low = sum(1 for channel in channels if channel <= MAX_2_4GHZ_CHANNEL)
+        if low in (0, len(channels)):
+            return ("BAND", "2.4GHz" if low else "5GHz")
+
+    rssi_floor = options["rssi_floor"]
+    if rssi_floor is not None and rssi_floor >= RSSI_RANGES[-1][1]:
+        for name, value in RSSI_RANGES:
+            if rssi_floor >= value:
+                return ("RSSI", name)
+
+    return None
+
+
+def matches(options, ap):
+    """Mirror of scan_options_match()."""
+    if options["channels"] and ap["channel"] not in options["channels"]:
+        return False
+    if options["ssid"]:
+        if options["prefix"] and not ap["ssid"].startswith(options["ssid"]):
+            return False
+        if not options["prefix"] and ap["ssid"] != options["ssid"]:
+            return False
+    return options["rssi_floor"] is None or ap["rssi"] >= options["rssi_floor"]
+
+
+def reported_by_driver(scan_filter, ap):
+    """Returns whether the connection manager reports an AP for a filter."""
+    if scan_filter is None:
+        return True
+    mode, value = scan_filter
+    if mode == "SSID":
+        return ap["ssid"] == value
+    if mode == "BAND":
+        return (ap["channel"] <= MAX_2_4GHZ_CHANNEL) == (value == "2.4GHz")
+    return ap["rssi"] >= dict(RSSI_RANGES)[value]
+
+
+def swept_channels(scan_filter):
+    if scan_filter is not None and scan_filter[0] == "BAND":
+        return CHANNELS_2_4GHZ if scan_filter[1] == "2.4GHz" else CHANNELS_5GHZ
+    return CHANNELS_2_4GHZ + CHANNELS_5GHZ
+
+
+def make_environment(count, seed):
+    rng = random.Random(seed)
+    names = ["Office", "Office-5G", "Guest", "Guest-Lobby", "Lab", "Printer",
+             "HomeNet", "Cafe", "Warehouse", "IoT"]
+    aps = []
+    for index in range(count):
+        channel = rng.choice(CHANNELS_2_4GHZ * 2 + CHANNELS_5GHZ)
+        aps.append({"ssid": names[index % len(names)] + ("" if index < len(names) else "-%u" % index),
+                    "channel": channel,
+                    "rssi": rng.randint(-92, -35)})
+    return aps
+
+
+def simulate(query, aps, args):
+    options = parse_options(query)
+    scan_filter = wcm_filter(options)
+    channels = swept_channels(scan_filter)
+
+    time_msec = 0.0
+    for channel in channels:
+        time_msec += args.passive_msec if channel in DFS_CHANNELS else args.active_msec
+    if not args.no_softap:
+        time_msec += args.home_msec * (len(channels) - 1)
+
+    reported = [ap for ap in aps if ap["channel"] in channels and reported_by_driver(scan_filter, ap)]
+    listed = [ap for ap in reported if matches(options, ap)]
+    return {"filter": "%s=%s" % scan_filter if scan_filter else "none",
+            "channels": len(channels),
+            "time": time_msec,
+            "reported": len(reported),
+            "listed": len(listed)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Simulate the scan time of filtered scans.")
+    parser.add_argument("queries", nargs="*", metavar="QUERY")
+    parser.add_argument("--aps", type=int, default=40, help="number of APs around the device")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--active-msec", type=float, default=40.0, help="dwell time of an active channel")
+    parser.add_argument("--passive-msec", type=float, default=110.0, help="dwell time of a DFS channel")
+    parser.add_argument("--home-msec", type=float, default=45.0, help="time spent on the SoftAP channel between two channels")
+    parser.add_argument("--no-softap", action="store_true", help="simulate a scan without the concurrent SoftAP")
+    args = parser.parse_args()
+
+    queries = args.queries if args.queries else DEFAULT_QUERIES
+    aps = make_environment(args.aps, args.seed)
+    baseline = simulate("", aps, args)["time"]
+
+    print("%-32s %-16s %8s %9s %8s %6s %7s" % ("query", "wcm filter", "channels", "time ms",
+                                              "reported", "listed", "speedup"))
+    for query in queries:
+        result = simulate(query, aps, args)
+        print("%-32s %-16s %8u %9.0f %8u %6u %6.2fx" % (query or "(none)", result["filter"], result["channels"],
+                                                         result["time"], result["reported"], result["listed"],
+                                                         baseline / result["time"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
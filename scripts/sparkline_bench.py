@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""
+Host benchmark of the sparkline of the TFT display.
+
+Builds source/sparkline.c for the host against a minimal stand-in for emWin,
+whose GUI_* functions count the pixels, lines, rectangles and colour changes
+they are asked to draw instead of drawing them, and
+  - checks that neither the incremental update nor the full redraw draws
+    outside the area of the graph;
+  - measures the time taken by sparkline_add(), which draws only the column
+    of the new sample, and by sparkline_redraw(), which draws the whole
+    graph, on a filled graph, together with the drawing operations and the
+    pixels each of them issues per frame.
+
+Usage:
+    sparkline_bench.py [--frames N] [--cc cc]
+
+The harness is built with the compiler given by --cc, or $CC, in a temporary
+directory. The times only cover the code of sparkline.c and the stand-in; on
+the target the display transfer dominates, so the pixel counts are the
+figures to compare. A drawing outside the graph makes the script exit with
+status 1. Add SPARKLINE_BENCHMARK to DEFINES in the Makefile to measure the
+render time on the target.
+"""
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+APP_DIR = os.path.dirname(SCRIPT_DIR)
+SOURCE_DIR = os.path.join(APP_DIR, "source")
+
+# Place of the graph, below the rows of the readings as display_task.c puts it
+GRAPH_X0 = 0
+GRAPH_Y0 = 120
+
+# Stand-in for web_server.h: the only names sparkline.c takes from it are
+# those of emWin, of the sensors and APP_INFO.
+WEB_SERVER_STUB = r"""
+#ifndef WEB_SERVER_H_
+#define WEB_SERVER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define GUI_WHITE                       0x00FFFFFFu
+#define GUI_YELLOW                      0x0000FFFFu
+#define GUI_GREEN                       0x0000FF00u
+
+#define LIGHTSENSOR_ADC_MAX_VOLTAGE     (%(light_max)su)
+#define MAX_DUTYCYCLE                   (%(duty_max)su)
+
+#define APP_INFO(x)                     do { printf x; } while (0)
+
+typedef uint32_t GUI_COLOR;
+
+void GUI_SetColor(GUI_COLOR color);
+void GUI_DrawPixel(int x, int y);
+void GUI_DrawLine(int x0, int y0, int x1, int y1);
+void GUI_ClearRect(int x0, int y0, int x1, int y1);
+
+#endif /* WEB_SERVER_H_ */
+"""
+
+HARNESS = r"""
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "web_server.h"
+#include "sparkline.h"
+
+typedef struct
+{
+    unsigned long colors;
+    unsigned long pixels;
+    unsigned long lines;
+    unsigned long rects;
+    unsigned long pixels_drawn;
+    unsigned long outside;
+} gui_counters_t;
+
+static gui_counters_t counters;
+static int area_x0;
+static int area_y0;
+
+static int outside_area(int x, int y)
+{
+    return (x < area_x0) || (x >= (area_x0 + (int)SPARKLINE_WIDTH)) ||
+           (y < area_y0) || (y >= (area_y0 + (int)SPARKLINE_HEIGHT));
+}
+
+void GUI_SetColor(GUI_COLOR color)
+{
+    (void)color;
+    counters.colors++;
+}
+
+void GUI_DrawPixel(int x, int y)
+{
+    counters.pixels++;
+    counters.pixels_drawn++;
+    counters.outside += outside_area(x, y);
+}
+
+void GUI_DrawLine(int x0, int y0, int x1, int y1)
+{
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+
+    /* A line covers one pixel per step along its longer axis */
+    counters.lines++;
+    counters.pixels_drawn += (unsigned long)(((dx > dy) ? dx : dy) + 1);
+    counters.outside += outside_area(x0, y0) || outside_area(x1, y1);
+}
+
+void GUI_ClearRect(int x0, int y0, int x1, int y1)
+{
+    counters.rects++;
+    counters.pixels_drawn += (unsigned long)((x1 - x0 + 1) * (y1 - y0 + 1));
+    counters.outside += outside_area(x0, y0) || outside_area(x1, y1);
+}
+
+static double elapsed_ns(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((double)(end.tv_sec - start->tv_sec) * 1e9) + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+static void print_counters(const char *method, double ns, unsigned long frames)
+{
+    printf("%s %.1f %.2f %.2f %.2f %.2f %.1f %lu\n", method, ns / (double)frames,
+           (double)counters.colors / (double)frames, (double)counters.pixels / (double)frames,
+           (double)counters.lines / (double)frames, (double)counters.rects / (double)frames,
+           (double)counters.pixels_drawn / (double)frames, counters.outside);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long frames = (argc > 3) ? strtoul(argv[3], NULL, 10) : 1000u;
+    struct timespec start;
+    double ns;
+
+    area_x0 = (argc > 1) ? atoi(argv[1]) : 0;
+    area_y0 = (argc > 2) ? atoi(argv[2]) : 0;
+
+    /* Fill the graph, and check the first pass, which wraps at its end */
+    sparkline_init((uint16_t)area_x0, (uint16_t)area_y0);
+    memset(&counters, 0, sizeof(counters));
+    for (uint32_t x = 0; x < SPARKLINE_WIDTH; x++)
+    {
+        sparkline_add((uint16_t)((x * LIGHTSENSOR_ADC_MAX_VOLTAGE) / SPARKLINE_WIDTH),
+                      (uint8_t)(x % MAX_DUTYCYCLE));
+    }
+    print_counters("fill", 0.0, SPARKLINE_WIDTH);
+
+    memset(&counters, 0, sizeof(counters));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long frame = 0; frame < frames; frame++)
+    {
+        sparkline_add((uint16_t)((frame * 37u) % LIGHTSENSOR_ADC_MAX_VOLTAGE), (uint8_t)(frame % MAX_DUTYCYCLE));
+    }
+    ns = elapsed_ns(&start);
+    print_counters("incremental", ns, frames);
+
+    memset(&counters, 0, sizeof(counters));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned long frame = 0; frame < frames; frame++)
+    {
+        sparkline_redraw();
+    }
+    ns = elapsed_ns(&start);
+    print_counters("full", ns, frames);
+
+    return 0;
+}
+"""
+
+
+def header_value(path, name):
+    """Returns the value of a numeric macro of a header of the application."""
+    with open(os.path.join(SOURCE_DIR, path), encoding="utf-8") as header:
+        match = re.search(r"#define\s+%s\s+\(?(\d+)u?\)?" % name, header.read())
+    if match is None:
+        sys.exit("%s not found in %s" % (name, path))
+    return int(match.group(1))
+
+
+def build(directory, compiler):
+    """Builds the harness. sparkline.c is copied next to the stand-in for
+    web_server.h, as its include would otherwise find the real header."""
+    for name in ("sparkline.c", "sparkline.h"):
+        shutil.copy(os.path.join(SOURCE_DIR, name), directory)
+    with open(os.path.join(directory, "web_server.h"), "w", encoding="utf-8") as stub:
+        stub.write(WEB_SERVER_STUB % {"light_max": header_value("sensors.h", "LIGHTSENSOR_ADC_MAX_VOLTAGE"),
+                                      "duty_max": header_value("sensors.h", "MAX_DUTYCYCLE")})
+    with open(os.path.join(directory, "FreeRTOS.h"), "w", encoding="utf-8") as stub:
+        stub.write("/* Not used without SPARKLINE_BENCHMARK */\n")
+    with open(os.path.join(directory, "task.h"), "w", encoding="utf-8") as stub:
+        stub.write("/* Not used without SPARKLINE_BENCHMARK */\n")
+
+    harness = os.path.join(directory, "harness.c")
+    binary = os.path.join(directory, "sparkline_harness")
+    with open(harness, "w", encoding="utf-8") as source:
+        source.write(HARNESS)
+    subprocess.run([compiler, "-O2", "-std=gnu11", "-Wall", "-DENABLE_TFT", "-I", directory,
+                    harness, os.path.join(directory, "sparkline.c"), "-o", binary], check=True)
+    return binary
+
+
+def bench(binary, args):
+    output = subprocess.run([binary, str(GRAPH_X0), str(GRAPH_Y0), str(args.frames)],
+                            stdout=subprocess.PIPE, check=True).stdout.decode().splitlines()
+
+    results = {}
+    for line in output:
+        fields = line.split()
+        results[fields[0]] = [float(value) for value in fields[1:-1]] + [int(fields[-1])]
+
+    print("Per frame, over %u frames of a filled graph" % args.frames)
+    print("%-12s %10s %8s %8s %8s %8s %10s" % ("method", "host ns", "colors", "pixels", "lines", "rects",
+                                               "pixels set"))
+    for method in ("incremental", "full"):
+        ns, colors, pixels, lines, rects, drawn, _ = results[method]
+        print("%-12s %10.1f %8.2f %8.2f %8.2f %8.2f %10.1f" % (method, ns, colors, pixels, lines, rects, drawn))
+    print("The incremental update sets %.1fx fewer pixels and runs %.1fx faster on the host" % (
+        results["full"][5] / results["incremental"][5], results["full"][0] / results["incremental"][0]))
+
+    outside = {method: result[-1] for method, result in results.items() if result[-1]}
+    for method, count in outside.items():
+        print("OUTSIDE THE GRAPH: %u drawing operations of the %s pass" % (count, method))
+    return not outside
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark the sparkline rendering on the host.")
+    parser.add_argument("--frames", type=int, default=2000, help="frames rendered by each method")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    args = parser.parse_args()
+
+    if shutil.which(args.cc) is None:
+        sys.exit("Compiler %s not found, select one with --cc" % args.cc)
+
+    directory = tempfile.mkdtemp()
+    try:
+        binary = build(directory, args.cc)
+        passed = bench(binary, args)
+    finally:
+        shutil.rmtree(directory)
+
+    return 0 if passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,330 @@
+#!/usr/bin/env python3
+"""
+Host check and benchmark of the URL decoder.
+
+Builds source/url_decode.c for the host together with a small harness, and
+  - checks it against a reference decoder written in Python on random inputs
+    biased towards '%', '+' and hexadecimal digits, with destination buffers
+    of random sizes, including ones too small for the decoded text. A canary
+    after the destination buffer catches any write past its length;
+  - checks that it decodes like the previous url_decode() on the inputs the
+    previous decoder accepted, that is without NUL or bytes from 128 up;
+  - measures the throughput on typical and escape-heavy inputs of a few sizes
+    and compares it with the previous decoder.
+
+Usage:
+    url_decode_bench.py [--cases N] [--seed S] [--iterations N] [--cc cc]
+                        [--skip-bench]
+
+The harness is built with the compiler given by --cc, or $CC, in a temporary
+directory. Any mismatch is printed with the input, in hexadecimal, and makes
+the script exit with status 1.
+"""
+
+import argparse
+import os
+import random
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+APP_DIR = os.path.dirname(SCRIPT_DIR)
+SOURCE_DIR = os.path.join(APP_DIR, "source")
+
+# Mirror of URL_DECODE_OVERFLOW, as printed by the harness
+OVERFLOW = -1
+
+# Bytes of the random inputs, biased towards those with a meaning in an escape.
+INPUT_BYTES = b"%%%%++0123456789abcdefABCDEFgxyzG _-.~/=&" + bytes(range(1, 128))
+EXTRA_BYTES = b"\x00\x80\xc3\xa9\xff"
+
+BENCH_SIZES = (32, 256, 2048)
+BENCH_PATTERNS = {
+    "typical": b"ssid_prefix=Office+Guest&channels=1,6,11&min_rssi=-70&name=My-Home_Network.2G&",
+    "escape-heavy": b"".join(b"%%%02X" % ord(c) for c in "Caf\xe9 & Bar #1! p@ss w0rd&=+%~*'()[] ") + b"+",
+}
+
+HARNESS = r"""
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "url_decode.h"
+
+#define CANARY_LENGTH 16u
+#define CANARY_BYTE   0xA5u
+
+static int read_record(uint8_t **src, uint32_t *src_length, uint32_t *dst_length)
+{
+    uint32_t header[2];
+
+    if (fread(header, sizeof(header), 1, stdin) != 1)
+    {
+        return 0;
+    }
+    *src_length = header[0];
+    *dst_length = header[1];
+    *src = realloc(*src, *src_length + 1u);
+    if ((*src_length != 0u) && (fread(*src, *src_length, 1, stdin) != 1))
+    {
+        return 0;
+    }
+    (*src)[*src_length] = 0;
+    return 1;
+}
+
+/* Previous decoder, which relied on the NUL termination of the source */
+static void legacy_url_decode(char *dst, const uint8_t *src)
+{
+    char high, low;
+
+    while ((*src) && ((*src) < 128))
+    {
+        if ((*src == '%') && ((high = src[1]) && (low = src[2])) && (isxdigit(high) && isxdigit(low)))
+        {
+            if (high >= 'a') high -= 'a' - 'A';
+            if (high >= 'A') high -= ('A' - 10); else high -= '0';
+            if (low >= 'a') low -= 'a' - 'A';
+            if (low >= 'A') low -= ('A' - 10); else low -= '0';
+            *dst++ = 16 * high + low;
+            src += 3;
+        }
+        else if (*src == '+')
+        {
+            *dst++ = ' ';
+            src++;
+        }
+        else
+        {
+            *dst++ = *src++;
+        }
+    }
+    *dst++ = 0;
+}
+
+static void print_hex(const uint8_t *data, size_t length)
+{
+    printf(" ");
+    for (size_t index = 0; index < length; index++)
+    {
+        printf("%02x", data[index]);
+    }
+    if (length == 0u)
+    {
+        printf("-");
+    }
+}
+
+static double elapsed_ns(const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((double)(end.tv_sec - start->tv_sec) * 1e9) + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t *src = NULL;
+    uint8_t *dst = NULL;
+    uint32_t src_length;
+    uint32_t dst_length;
+    long iterations = (argc > 2) ? atol(argv[2]) : 0;
+    struct timespec start;
+    volatile size_t sink = 0;
+    size_t length;
+    int canary_intact;
+
+    while (read_record(&src, &src_length, &dst_length))
+    {
+        dst = realloc(dst, dst_length + CANARY_LENGTH + 1u);
+        memset(dst, CANARY_BYTE, dst_length + CANARY_LENGTH + 1u);
+
+        if ((argc > 1) && !strcmp(argv[1], "bench"))
+        {
+            double new_ns;
+            double legacy_ns;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long run = 0; run < iterations; run++)
+            {
+                sink += url_decode(dst, dst_length, src, src_length);
+                __asm__ volatile("" : : "r"(dst) : "memory");
+            }
+            new_ns = elapsed_ns(&start) / (double)iterations;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long run = 0; run < iterations; run++)
+            {
+                legacy_url_decode((char *)dst, src);
+                __asm__ volatile("" : : "r"(dst) : "memory");
+            }
+            legacy_ns = elapsed_ns(&start) / (double)iterations;
+            printf("%.2f %.2f\n", new_ns, legacy_ns);
+            continue;
+        }
+
+        length = url_decode(dst, dst_length, src, src_length);
+        canary_intact = 1;
+        for (uint32_t index = dst_length; index < (dst_length + CANARY_LENGTH); index++)
+        {
+            canary_intact &= (dst[index] == CANARY_BYTE);
+        }
+        if (length == URL_DECODE_OVERFLOW)
+        {
+            printf("-1 %d -", canary_intact);
+        }
+        else
+        {
+            printf("%zu %d", length, canary_intact && (dst[length] == 0));
+            print_hex(dst, length);
+        }
+
+        /* The previous decoder needs room for the whole source */
+        dst = realloc(dst, src_length + 1u);
+        legacy_url_decode((char *)dst, src);
+        print_hex(dst, strlen((char *)dst));
+        printf("\n");
+    }
+
+    free(src);
+    free(dst);
+    return 0;
+}
+"""
+
+
+def record(src, dst_length):
+    return struct.pack("<II", len(src), dst_length) + src
+
+
+def reference(src):
+    """Decodes an input as url_decode() is specified to."""
+    hex_digits = b"0123456789abcdefABCDEF"
+    decoded = bytearray()
+    index = 0
+    while index < len(src):
+        if (src[index] == ord("%") and index + 2 < len(src) and
+                src[index + 1] in hex_digits and src[index + 2] in hex_digits):
+            decoded.append(int(src[index + 1:index + 3], 16))
+            index += 3
+        elif src[index] == ord("+"):
+            decoded.append(ord(" "))
+            index += 1
+        else:
+            decoded.append(src[index])
+            index += 1
+    return bytes(decoded)
+
+
+def random_input(rng):
+    alphabet = INPUT_BYTES + (EXTRA_BYTES if rng.random() < 0.3 else b"")
+    length = rng.choice([rng.randint(0, 8), rng.randint(0, 40), rng.randint(0, 300)])
+    return bytes(rng.choice(alphabet) for _ in range(length))
+
+
+def build(directory, compiler):
+    harness = os.path.join(directory, "harness.c")
+    binary = os.path.join(directory, "url_decode_harness")
+    with open(harness, "w", encoding="utf-8") as source:
+        source.write(HARNESS)
+    subprocess.run([compiler, "-O2", "-std=gnu11", "-Wall", "-I", SOURCE_DIR,
+                    harness, os.path.join(SOURCE_DIR, "url_decode.c"), "-o", binary], check=True)
+    return binary
+
+
+def check(binary, args):
+    rng = random.Random(args.seed)
+    cases = []
+    for _ in range(args.cases):
+        src = random_input(rng)
+        needed = len(reference(src)) + 1
+        cases.append((src, rng.choice([needed, needed - 1, rng.randint(0, needed + 16), len(src) + 1])))
+
+    output = subprocess.run([binary], input=b"".join(record(src, dst_length) for src, dst_length in cases),
+                            stdout=subprocess.PIPE, check=True).stdout.decode().splitlines()
+
+    failures = 0
+    overflows = 0
+    legacy_compared = 0
+    for (src, dst_length), line in zip(cases, output):
+        length, intact, decoded, legacy = line.split()
+        expected = reference(src)
+        decoded = b"" if decoded == "-" else bytes.fromhex(decoded)
+        legacy = b"" if legacy == "-" else bytes.fromhex(legacy)
+        problems = []
+
+        if int(intact) != 1:
+            problems.append("wrote past the destination or missed the NUL")
+        if len(expected) + 1 > dst_length:
+            overflows += 1
+            if int(length) != OVERFLOW:
+                problems.append("decoded %s bytes into %u, expected an overflow" % (length, dst_length))
+        elif int(length) != len(expected) or decoded != expected:
+            problems.append("decoded %s, expected %s" % (decoded.hex(), expected.hex()))
+
+        if not any(byte == 0 or byte >= 128 for byte in src):
+            legacy_compared += 1
+            if int(length) != OVERFLOW and legacy != decoded.split(b"\x00")[0]:
+                problems.append("previous decoder gave %s" % legacy.hex())
+
+        if problems:
+            failures += 1
+            print("MISMATCH into %u bytes: %s" % (dst_length, src.hex()))
+            for problem in problems:
+                print("  " + problem)
+
+    print("Checked %u inputs (%u overflowing, %u compared with the previous decoder), %u mismatches" % (
+        len(cases), overflows, legacy_compared, failures))
+    return failures == 0
+
+
+def bench(binary, args):
+    inputs = []
+    for name, pattern in BENCH_PATTERNS.items():
+        for size in BENCH_SIZES:
+            inputs.append((name, (pattern * (size // len(pattern) + 1))[:size]))
+
+    output = subprocess.run([binary, "bench", str(args.iterations)],
+                            input=b"".join(record(src, len(src) + 1) for _, src in inputs),
+                            stdout=subprocess.PIPE, check=True).stdout.decode().splitlines()
+
+    print("%-14s %6s %10s %10s %12s %12s %8s" % ("input", "bytes", "new ns", "new MB/s",
+                                                 "previous ns", "previous MB/s", "speedup"))
+    for (name, src), line in zip(inputs, output):
+        new_ns, legacy_ns = (float(value) for value in line.split())
+        print("%-14s %6u %10.1f %10.1f %12.1f %12.1f %7.2fx" % (name, len(src), new_ns, len(src) * 1e3 / new_ns,
+                                                               legacy_ns, len(src) * 1e3 / legacy_ns,
+                                                               legacy_ns / new_ns))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check and benchmark the URL decoder on the host.")
+    parser.add_argument("--cases", type=int, default=20000, help="number of random inputs")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--iterations", type=int, default=200000, help="decodes timed per input")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--skip-bench", action="store_true")
+    args = parser.parse_args()
+
+    if shutil.which(args.cc) is None:
+        sys.exit("Compiler %s not found, select one with --cc" % args.cc)
+
+    directory = tempfile.mkdtemp()
+    try:
+        binary = build(directory, args.cc)
+        passed = check(binary, args)
+        if not args.skip_bench:
+            bench(binary, args)
+    finally:
+        shutil.rmtree(directory)
+
+    return 0 if passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
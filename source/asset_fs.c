@@ -0,0 +1,624 @@
+/******************************************************************************
+* File Name: asset_fs.c
+*
+* Description: This file contains the read-only filesystem which serves the
+*              files of web/assets from the image built by
+*              scripts/asset_image.py. The image carries the content type,
+*              ETag and content encoding of every file, so a file is sent
+*              with a precomputed header straight from flash. The files are
+*              served through the routes listed for them in web/routes.txt. On boards with
+*              external flash mapped for execute in place the image lives
+*              there. Paths are looked up through a minimal perfect hash: two
+*              hashes and one string compare, whatever the number of files.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include <ctype.h>
+
+#include "web_server.h"
+#include "asset_fs.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Offsets of the header fields */
+#define HEADER_MAGIC_OFFSET                 (0u)
+#define HEADER_VERSION_OFFSET               (4u)
+#define HEADER_COUNT_OFFSET                 (6u)
+#define HEADER_BUCKETS_OFFSET               (8u)
+#define HEADER_ENTRY_SIZE_OFFSET            (10u)
+#define HEADER_SEED_OFFSET                  (12u)
+#define HEADER_ENTRIES_OFFSET               (16u)
+
+/* Offsets of the entry fields */
+#define ENTRY_PATH_OFFSET                   (0u)
+#define ENTRY_TYPE_OFFSET                   (4u)
+#define ENTRY_ETAG_OFFSET                   (8u)
+#define ENTRY_DATA_OFFSET                   (12u)
+#define ENTRY_LENGTH_OFFSET                 (16u)
+#define ENTRY_IDENTITY_DATA_OFFSET          (20u)
+#define ENTRY_IDENTITY_LENGTH_OFFSET        (24u)
+#define ENTRY_PATH_LENGTH_OFFSET            (28u)
+#define ENTRY_ENCODING_OFFSET               (32u)
+
+/* 32-bit FNV-1a parameters, must match scripts/asset_image.py */
+#define FNV_OFFSET_BASIS                    (0x811C9DC5u)
+#define FNV_PRIME                           (0x01000193u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Number of files in the image, 0 if the image is not valid. */
+static uint16_t asset_count = 0;
+
+/* Number of buckets of the displacement table. */
+static uint16_t asset_buckets = 0;
+
+/* Seed of the hash selecting the bucket of a path. */
+static uint32_t asset_seed = 0;
+
+/* Offset of the first entry in the image. */
+static uint32_t asset_entries_offset = 0;
+
+/*******************************************************************************
+* Function Name: read_u16
+********************************************************************************
+* Summary:
+*  Reads a little endian 16-bit value from the image.
+*
+* Parameters:
+*  offset - Offset of the value in the image.
+*
+* Return:
+*  uint16_t - Value read.
+*
+*******************************************************************************/
+static uint16_t read_u16(uint32_t offset)
+{
+    return (uint16_t)(asset_image[offset] | (asset_image[offset + 1] << 8));
+}
+
+/*******************************************************************************
+* Function Name: read_u32
+********************************************************************************
+* Summary:
+*  Reads a little endian 32-bit value from the image.
+*
+* Parameters:
+*  offset - Offset of the value in the image.
+*
+* Return:
+*  uint32_t - Value read.
+*
+*******************************************************************************/
+static uint32_t read_u32(uint32_t offset)
+{
+    return ((uint32_t)asset_image[offset]) |
+           ((uint32_t)asset_image[offset + 1] << 8) |
+           ((uint32_t)asset_image[offset + 2] << 16) |
+           ((uint32_t)asset_image[offset + 3] << 24);
+}
+
+/*******************************************************************************
+* Function Name: asset_hash
+********************************************************************************
+* Summary:
+*  Computes the seeded 32-bit FNV-1a hash of a path.
+*
+* Parameters:
+*  seed - Value XORed into the offset basis.
+*  path - Path to be hashed.
+*  length - Length of the path.
+*
+* Return:
+*  uint32_t - Hash value.
+*
+*******************************************************************************/
+static uint32_t asset_hash(uint32_t seed, const char *path, size_t length)
+{
+    uint32_t hash = FNV_OFFSET_BASIS ^ seed;
+
+    for (size_t index = 0; index < length; index++)
+    {
+        hash ^= (uint8_t)path[index];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/*******************************************************************************
+* Function Name: asset_fs_init
+********************************************************************************
+* Summary:
+*  Checks the header of the asset image. No file is served if the image is not
+*  valid.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the image is valid.
+*
+*******************************************************************************/
+bool asset_fs_init(void)
+{
+    asset_count = 0;
+
+    if ((read_u32(HEADER_MAGIC_OFFSET) != ASSET_IMAGE_MAGIC) ||
+        (read_u16(HEADER_VERSION_OFFSET) != ASSET_IMAGE_VERSION) ||
+        (read_u16(HEADER_ENTRY_SIZE_OFFSET) != ASSET_IMAGE_ENTRY_SIZE))
+    {
+        ERR_INFO(("The asset image is not valid\r\n"));
+        return false;
+    }
+
+    asset_buckets = read_u16(HEADER_BUCKETS_OFFSET);
+    asset_seed = read_u32(HEADER_SEED_OFFSET);
+    asset_entries_offset = read_u32(HEADER_ENTRIES_OFFSET);
+    asset_count = read_u16(HEADER_COUNT_OFFSET);
+
+    APP_INFO(("Asset image at 0x%08lx holds %u files\r\n",
+              (unsigned long)(uintptr_t)asset_image, asset_count));
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: asset_fs_count
+********************************************************************************
+* Summary:
+*  Returns the number of files in the asset image.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint16_t - Number of files.
+*
+*******************************************************************************/
+uint16_t asset_fs_count(void)
+{
+    return asset_count;
+}
+
+/*******************************************************************************
+* Function Name: asset_fs_get
+********************************************************************************
+* Summary:
+*  Describes the file held in a slot of the asset image.
+*
+* Parameters:
+*  index - Slot of the file, below asset_fs_count().
+*  file - Pointer to the structure that receives the description.
+*
+* Return:
+*  bool - true if the slot exists.
+*
+*******************************************************************************/
+bool asset_fs_get(uint16_t index, asset_file_t *file)
+{
+    uint32_t entry = asset_entries_offset + ((uint32_t)index * ASSET_IMAGE_ENTRY_SIZE);
+
+    if (index >= asset_count)
+    {
+        return false;
+    }
+
+    file->path = (const char *)&asset_image[read_u32(entry + ENTRY_PATH_OFFSET)];
+    file->content_type = (const char *)&asset_image[read_u32(entry + ENTRY_TYPE_OFFSET)];
+    file->etag = (const char *)&asset_image[read_u32(entry + ENTRY_ETAG_OFFSET)];
+    file->data = &asset_image[read_u32(entry + ENTRY_DATA_OFFSET)];
+    file->length = read_u32(entry + ENTRY_LENGTH_OFFSET);
+    file->identity_data = &asset_image[read_u32(entry + ENTRY_IDENTITY_DATA_OFFSET)];
+    file->identity_length = read_u32(entry + ENTRY_IDENTITY_LENGTH_OFFSET);
+    file->path_length = read_u16(entry + ENTRY_PATH_LENGTH_OFFSET);
+    file->encoding = asset_image[entry + ENTRY_ENCODING_OFFSET];
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: asset_fs_find
+********************************************************************************
+* Summary:
+*  Looks a path up in the asset image. The perfect hash selects the only slot
+*  the path can be in, which is then compared with the path.
+*
+* Parameters:
+*  path - Request path, not necessarily NULL terminated.
+*  path_length - Length of the path.
+*  file - Pointer to the structure that receives the description.
+*
+* Return:
+*  bool - true if the file exists.
+*
+*******************************************************************************/
+bool asset_fs_find(const char *path, size_t path_length, asset_file_t *file)
+{
+    int16_t displacement;
+    uint16_t slot;
+
+    if (asset_count == 0)
+    {
+        return false;
+    }
+
+    displacement = (int16_t)read_u16(ASSET_IMAGE_HEADER_SIZE +
+                                     ((asset_hash(asset_seed, path, path_length) % asset_buckets) * 2));
+    if (displacement < 0)
+    {
+        slot = (uint16_t)(-displacement - 1);
+    }
+    else
+    {
+        slot = (uint16_t)(asset_hash((uint32_t)displacement, path, path_length) % asset_count);
+    }
+
+    return (asset_fs_get(slot, file) &&
+            (file->path_length == path_length) &&
+            (memcmp(file->path, path, path_length) == 0));
+}
+
+/*******************************************************************************
+* Function Name: next_list_item
+********************************************************************************
+* Summary:
+*  Splits the next item off a comma separated header value, such as the
+*  value of Accept-Encoding or If-None-Match, and trims its white space.
+*
+* Parameters:
+*  list - Pointer to the rest of the value, advanced past the item.
+*  list_end - End of the value.
+*  item_length - Receives the length of the item.
+*
+* Return:
+*  const char* - Start of the item, or NULL at the end of the value.
+*
+*******************************************************************************/
+static const char *next_list_item(const char **list, const char *list_end, size_t *item_length)
+{
+    const char *item;
+    const char *item_end;
+
+    while ((*list < list_end) && ((**list == ' ') || (**list == '\t') || (**list == ',')))
+    {
+        (*list)++;
+    }
+    if (*list >= list_end)
+    {
+        return NULL;
+    }
+
+    item = *list;
+    while ((*list < list_end) && (**list != ','))
+    {
+        (*list)++;
+    }
+    item_end = *list;
+    while ((item_end > item) && ((item_end[-1] == ' ') || (item_end[-1] == '\t')))
+    {
+        item_end--;
+    }
+
+    *item_length = (size_t)(item_end - item);
+    return item;
+}
+
+/*******************************************************************************
+* Function Name: strip_weak_prefix
+********************************************************************************
+* Summary:
+*  Drops the "W/" prefix of a weak entity tag, for the weak comparison of
+*  the tags of If-None-Match.
+*
+* Parameters:
+*  tag - Pointer to the tag, advanced past the prefix.
+*  tag_length - Pointer to the length of the tag, reduced accordingly.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void strip_weak_prefix(const char **tag, size_t *tag_length)
+{
+    if ((*tag_length >= 2u) && ((*tag)[0] == 'W') && ((*tag)[1] == '/'))
+    {
+        *tag += 2;
+        *tag_length -= 2u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: etag_matches
+********************************************************************************
+* Summary:
+*  Checks whether the If-None-Match header of a request lists the ETag of a
+*  file, or is "*", comparing the tags weakly.
+*
+* Parameters:
+*  url_path - Pointer to the HTTP URL path, as passed to the handler.
+*  http_message_body - Pointer to the HTTP data from the client.
+*  file - File requested.
+*
+* Return:
+*  bool - true if the copy held by the client is current.
+*
+*******************************************************************************/
+static bool etag_matches(const char *url_path, const cy_http_message_body_t *http_message_body,
+                         const asset_file_t *file)
+{
+    const char *list;
+    const char *list_end;
+    const char *item;
+    const char *etag = file->etag;
+    size_t list_length;
+    size_t item_length;
+    size_t etag_length = strlen(file->etag);
+
+    if (!router_find_header(url_path, http_message_body, "If-None-Match", &list, &list_length))
+    {
+        return false;
+    }
+
+    strip_weak_prefix(&etag, &etag_length);
+    list_end = list + list_length;
+    while ((item = next_list_item(&list, list_end, &item_length)) != NULL)
+    {
+        strip_weak_prefix(&item, &item_length);
+        if (((item_length == 1u) && (item[0] == '*')) ||
+            ((item_length == etag_length) && (memcmp(item, etag, etag_length) == 0)))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: token_equals
+********************************************************************************
+* Summary:
+*  Compares a token of a header value with a lower case name, without regard
+*  to case.
+*
+* Parameters:
+*  token - Token, not necessarily NULL terminated.
+*  token_length - Length of the token.
+*  name - NULL terminated lower case name.
+*
+* Return:
+*  bool - true if the token is the name.
+*
+*******************************************************************************/
+static bool token_equals(const char *token, size_t token_length, const char *name)
+{
+    for (size_t index = 0; index < token_length; index++)
+    {
+        if ((name[index] == '\0') || (tolower((unsigned char)token[index]) != name[index]))
+        {
+            return false;
+        }
+    }
+
+    return (name[token_length] == '\0');
+}
+
+/*******************************************************************************
+* Function Name: gzip_accepted
+********************************************************************************
+* Summary:
+*  Checks whether the Accept-Encoding header of a request accepts gzip,
+*  listed by name or through "*", without a zero quality value. A request
+*  whose header cannot be found is sent the uncompressed content.
+*
+* Parameters:
+*  url_path - Pointer to the HTTP URL path, as passed to the handler.
+*  http_message_body - Pointer to the HTTP data from the client.
+*
+* Return:
+*  bool - true if the client accepts gzip.
+*
+*******************************************************************************/
+static bool gzip_accepted(const char *url_path, const cy_http_message_body_t *http_message_body)
+{
+    const char *list;
+    const char *list_end;
+    const char *item;
+    const char *parameter;
+    size_t list_length;
+    size_t item_length;
+    size_t name_length;
+    bool accepted = false;
+    bool zero_quality;
+
+    if (!router_find_header(url_path, http_message_body, "Accept-Encoding", &list, &list_length))
+    {
+        return false;
+    }
+
+    list_end = list + list_length;
+    while ((item = next_list_item(&list, list_end, &item_length)) != NULL)
+    {
+        name_length = 0;
+        while ((name_length < item_length) && (item[name_length] != ';') &&
+               (item[name_length] != ' ') && (item[name_length] != '\t'))
+        {
+            name_length++;
+        }
+
+        /* "q=0", "q=0.0" and so on refuse the coding */
+        zero_quality = false;
+        parameter = memchr(item, ';', item_length);
+        if (parameter != NULL)
+        {
+            parameter++;
+            while ((parameter < (item + item_length)) && ((*parameter == ' ') || (*parameter == '\t')))
+            {
+                parameter++;
+            }
+            if (((item + item_length) - parameter >= 3) &&
+                ((parameter[0] == 'q') || (parameter[0] == 'Q')) && (parameter[1] == '=') && (parameter[2] == '0'))
+            {
+                zero_quality = true;
+                for (parameter += 3; parameter < (item + item_length); parameter++)
+                {
+                    if ((*parameter != '.') && (*parameter != '0'))
+                    {
+                        zero_quality = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (token_equals(item, name_length, "gzip") || token_equals(item, name_length, "x-gzip"))
+        {
+            /* The coding listed by name takes precedence over "*" */
+            return !zero_quality;
+        }
+        if (token_equals(item, name_length, "*"))
+        {
+            accepted = !zero_quality;
+        }
+    }
+
+    return accepted;
+}
+
+/*******************************************************************************
+* Function Name: asset_resource_handler
+********************************************************************************
+* Summary:
+*  Handles HTTP GET of a file of the asset image, through the routes listed
+*  for the files in web/routes.txt. The response header, with the stored
+*  content type, length, ETag and encoding, is written by this handler as the
+*  resource is registered as raw content; the content follows straight from
+*  flash. A request whose If-None-Match lists the ETag of the file is
+*  answered with "304 Not Modified", and the gzip compressed content is only
+*  sent to a client whose Accept-Encoding accepts gzip; the others are sent
+*  the uncompressed content.
+*
+* Parameters:
+*  url_path - Pointer to the HTTP URL path.
+*  url_parameters - Pointer to the HTTP URL query string.
+*  stream - Pointer to the HTTP response stream.
+*  arg - Unused.
+*  http_message_body - Pointer to the HTTP data from the client.
+*
+* Return:
+*  int32_t - Returns HTTP_REQUEST_HANDLE_SUCCESS if the request from the client
+*  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
+*
+*******************************************************************************/
+int32_t asset_resource_handler(const char *url_path, const char *url_parameters,
+                               cy_http_response_stream_t *stream, void *arg,
+                               cy_http_message_body_t *http_message_body)
+{
+    char header[ASSET_HEADER_BUFFER_LENGTH];
+    response_builder_t builder;
+    asset_file_t file;
+    size_t path_length = 0;
+    bool gzip;
+
+    while ((path_length < ASSET_PATH_MAX_LENGTH) && (url_path[path_length] != '\0') &&
+           (url_path[path_length] != '?') && (url_path[path_length] != ' '))
+    {
+        path_length++;
+    }
+
+    response_builder_init(&builder, header, sizeof(header), stream);
+
+    if (!asset_fs_find(url_path, path_length, &file))
+    {
+        /* A route listed for a file missing from web/assets */
+        response_builder_append_string(&builder, "HTTP/1.1 404 Not Found\r\n"
+                                                  "Content-Length: 0\r\n"
+                                                  HTTP_CONNECTION_HEADERS "\r\n");
+    }
+    else if (etag_matches(url_path, http_message_body, &file))
+    {
+        response_builder_append_string(&builder, "HTTP/1.1 304 Not Modified\r\nETag: ");
+        response_builder_append_string(&builder, file.etag);
+        response_builder_append_string(&builder, "\r\nCache-Control: " ASSET_CACHE_CONTROL "\r\n"
+                                                  HTTP_CONNECTION_HEADERS);
+        if (file.encoding == ASSET_ENCODING_GZIP)
+        {
+            response_builder_append_string(&builder, "Vary: Accept-Encoding\r\n");
+        }
+        response_builder_append_string(&builder, "\r\n");
+    }
+    else
+    {
+        gzip = (file.encoding == ASSET_ENCODING_GZIP) && gzip_accepted(url_path, http_message_body);
+
+        response_builder_append_string(&builder, "HTTP/1.1 200 OK\r\nContent-Type: ");
+        response_builder_append_string(&builder, file.content_type);
+        response_builder_append_string(&builder, "\r\nContent-Length: ");
+        response_builder_append_uint(&builder, gzip ? file.length : file.identity_length);
+        response_builder_append_string(&builder, "\r\nETag: ");
+        response_builder_append_string(&builder, file.etag);
+        response_builder_append_string(&builder, "\r\nCache-Control: " ASSET_CACHE_CONTROL "\r\n"
+                                                  HTTP_CONNECTION_HEADERS);
+        if (file.encoding == ASSET_ENCODING_GZIP)
+        {
+            response_builder_append_string(&builder, "Vary: Accept-Encoding\r\n");
+        }
+        if (gzip)
+        {
+            response_builder_append_string(&builder, "Content-Encoding: gzip\r\n");
+        }
+        response_builder_append_string(&builder, "\r\n");
+        if (gzip)
+        {
+            response_builder_append_const(&builder, (const char *)file.data, file.length);
+        }
+        else
+        {
+            response_builder_append_const(&builder, (const char *)file.identity_data, file.identity_length);
+        }
+    }
+
+    if (CY_RSLT_SUCCESS != response_builder_finish(&builder))
+    {
+        ERR_INFO(("Failed to send the asset response\r\n"));
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
+
+    return HTTP_REQUEST_HANDLE_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,107 @@
+/******************************************************************************
+* File Name: asset_fs.h
+*
+* Description: This file contains the macros, structures and function
+*              prototypes of the read-only asset filesystem built by
+*              scripts/asset_image.py.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef ASSET_FS_H_
+#define ASSET_FS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cy_utils.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Image identification, must match scripts/asset_image.py */
+#define ASSET_IMAGE_MAGIC                               (0x31534641u)   /* "AFS1" */
+#define ASSET_IMAGE_VERSION                             (2u)
+#define ASSET_IMAGE_HEADER_SIZE                         (24u)
+#define ASSET_IMAGE_ENTRY_SIZE                          (36u)
+
+/* Content encodings of a stored file */
+#define ASSET_ENCODING_IDENTITY                         (0u)
+#define ASSET_ENCODING_GZIP                             (1u)
+
+/* Longest request path looked up in the image */
+#define ASSET_PATH_MAX_LENGTH                           (64u)
+
+/* Size of the buffer in which the response header of a file is assembled */
+#define ASSET_HEADER_BUFFER_LENGTH                      (256u)
+
+/* Caching policy sent with every file */
+#define ASSET_CACHE_CONTROL                             "public, max-age=3600"
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    const char*     path;           /* NULL terminated request path */
+    const char*     content_type;   /* NULL terminated MIME type */
+    const char*     etag;           /* NULL terminated weak ETag, shared by both encodings */
+    const uint8_t*  data;           /* File content, as stored */
+    uint32_t        length;         /* Length of the stored content */
+    const uint8_t*  identity_data;  /* Uncompressed content, the stored content if not compressed */
+    uint32_t        identity_length;
+    uint16_t        path_length;
+    uint8_t         encoding;       /* ASSET_ENCODING_IDENTITY or ASSET_ENCODING_GZIP */
+} asset_file_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Image generated from web/assets, see asset_image.c */
+extern const uint8_t asset_image[];
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+bool asset_fs_init(void);
+uint16_t asset_fs_count(void);
+bool asset_fs_get(uint16_t index, asset_file_t *file);
+bool asset_fs_find(const char *path, size_t path_length, asset_file_t *file);
+
+#endif /* ASSET_FS_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,128 @@
+/******************************************************************************
+* File Name: asset_image.c
+*
+* Description: This file is generated by scripts/asset_image.py
+*              from web/assets. Do not edit it by hand.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "asset_fs.h"
+
+/* Boards with external flash mapped for execute in place keep the
+ * image there, the others in internal flash.
+ */
+#if defined(CY_DEVICE_PSOC6A512K)
+CY_SECTION(".cy_xip")
+#endif
+CY_ALIGN(4) const uint8_t asset_image[1212] =
+{
+    0x41, 0x46, 0x53, 0x31, 0x02, 0x00, 0x01, 0x00, 0x01, 0x00, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1c, 0x00, 0x00, 0x00, 0xbc, 0x04, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00,
+    0x4a, 0x00, 0x00, 0x00, 0x54, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x56, 0x04, 0x00, 0x00,
+    0x64, 0x00, 0x00, 0x00, 0x56, 0x04, 0x00, 0x00, 0x09, 0x00, 0x09, 0x0c, 0x00, 0x00, 0x00, 0x00,
+    0x2f, 0x6c, 0x6f, 0x67, 0x6f, 0x2e, 0x70, 0x6e, 0x67, 0x00, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x2f,
+    0x70, 0x6e, 0x67, 0x00, 0x57, 0x2f, 0x22, 0x35, 0x32, 0x34, 0x61, 0x66, 0x63, 0x32, 0x63, 0x22,
+    0x00, 0x00, 0x00, 0x00, 0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x01, 0x39, 0x00, 0x00, 0x00, 0x5c, 0x04, 0x03, 0x00, 0x00,
+    0x00, 0xe7, 0x81, 0xdf, 0x9f, 0x00, 0x00, 0x00, 0x0f, 0x50, 0x4c, 0x54, 0x45, 0xff, 0xff, 0xff,
+    0x15, 0x58, 0x96, 0xe2, 0x3a, 0x55, 0x6d, 0x90, 0xb1, 0xc8, 0xc4, 0xd9, 0xb5, 0xef, 0xb9, 0xb2,
+    0x00, 0x00, 0x04, 0x02, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0xec, 0xc1, 0x81, 0x00, 0x00, 0x00,
+    0x00, 0x80, 0xa0, 0xfd, 0xa9, 0x17, 0xa9, 0x02, 0x00, 0x00, 0x66, 0xc6, 0x0c, 0x70, 0xdb, 0xd5,
+    0x61, 0x30, 0xee, 0x16, 0x1f, 0x00, 0x2b, 0x1c, 0x00, 0x65, 0x39, 0x00, 0x69, 0x38, 0x80, 0x09,
+    0xbe, 0xff, 0x99, 0x9e, 0x63, 0xe8, 0x96, 0x76, 0xdb, 0xc2, 0x7f, 0x43, 0x7a, 0xfd, 0x84, 0x3c,
+    0xd2, 0x4a, 0xde, 0x6f, 0x9f, 0x1d, 0x93, 0xd1, 0x96, 0x64, 0x5f, 0x24, 0xc2, 0xaf, 0x87, 0xb6,
+    0x91, 0xc1, 0x2b, 0xca, 0x5c, 0x0b, 0x0c, 0xaf, 0x28, 0x34, 0x36, 0x78, 0x45, 0x75, 0xc9, 0x8a,
+    0xca, 0xf0, 0x92, 0x22, 0xea, 0x5f, 0xd4, 0x38, 0x15, 0x12, 0xb9, 0xf3, 0x8c, 0x93, 0x24, 0xa7,
+    0xc2, 0x89, 0xd2, 0x9d, 0x96, 0x2c, 0x92, 0x6a, 0x86, 0xd3, 0xe4, 0x47, 0xa2, 0xe1, 0x3d, 0xfb,
+    0xdf, 0x3c, 0xec, 0x48, 0x75, 0x26, 0x5e, 0xf6, 0x21, 0xd2, 0xf4, 0x91, 0x9d, 0x57, 0xfe, 0x4b,
+    0x8f, 0xec, 0x62, 0x38, 0x45, 0x57, 0xef, 0x3d, 0xbc, 0xe7, 0x5a, 0x88, 0x90, 0x7a, 0xf8, 0xad,
+    0x16, 0xda, 0x74, 0x5a, 0xab, 0x28, 0xdc, 0xf8, 0xb1, 0x8a, 0x4e, 0x90, 0x06, 0x38, 0xa8, 0x35,
+    0xcd, 0x5f, 0x5b, 0xa7, 0x9a, 0x4e, 0xb3, 0x0e, 0xd3, 0x3b, 0x9d, 0x92, 0xd1, 0xf4, 0x5b, 0xba,
+    0x85, 0xe8, 0x54, 0xf3, 0xd0, 0x86, 0x70, 0x47, 0x35, 0x1d, 0xc2, 0x61, 0xba, 0xb7, 0x47, 0x3a,
+    0xaa, 0xc5, 0xa7, 0x58, 0x17, 0xa0, 0xa2, 0xfb, 0xb2, 0xaa, 0x7c, 0xd0, 0xbb, 0x8e, 0x6c, 0xf3,
+    0x47, 0x47, 0x45, 0x7d, 0x35, 0x01, 0xd0, 0x82, 0xc6, 0x7a, 0x32, 0x88, 0x66, 0x6e, 0x76, 0x1d,
+    0x1b, 0x5d, 0x17, 0x3b, 0x1a, 0xf4, 0xc6, 0x25, 0x48, 0xbd, 0x5e, 0x89, 0x18, 0x60, 0x31, 0xd8,
+    0xb2, 0xa3, 0x31, 0x4a, 0x74, 0x2d, 0xba, 0x85, 0xf6, 0x75, 0xdc, 0x4b, 0x8b, 0x44, 0x93, 0xe6,
+    0x8e, 0xfd, 0xa2, 0x37, 0x10, 0xf7, 0x40, 0xe5, 0xd7, 0x30, 0x2c, 0xe4, 0x70, 0x6e, 0x16, 0x16,
+    0x36, 0x3a, 0x52, 0x95, 0xe8, 0x80, 0x7a, 0xcb, 0xd1, 0x5b, 0x93, 0xb3, 0x7d, 0x03, 0xf8, 0x65,
+    0xa3, 0xaf, 0xb7, 0x87, 0xf4, 0x91, 0x12, 0x98, 0xe6, 0x22, 0x2a, 0xb8, 0x4a, 0x40, 0x40, 0x93,
+    0xde, 0x28, 0xa4, 0xae, 0x36, 0x3a, 0xcb, 0xae, 0x61, 0x9e, 0x5a, 0x85, 0x1d, 0x2b, 0x3a, 0xd6,
+    0x38, 0xdf, 0xe9, 0x06, 0xb8, 0x90, 0x50, 0x5f, 0x1c, 0x51, 0x2e, 0xab, 0x55, 0xc3, 0x3b, 0x12,
+    0xa9, 0x56, 0x52, 0xba, 0x78, 0x55, 0x94, 0x99, 0x78, 0x71, 0x2b, 0x71, 0x59, 0x31, 0x0d, 0x22,
+    0x48, 0x73, 0x1c, 0x3a, 0x0d, 0x8d, 0xd1, 0x95, 0x2b, 0xba, 0xa9, 0x23, 0xd6, 0x7c, 0x60, 0x74,
+    0xae, 0x5c, 0x8b, 0x2b, 0x6b, 0xd2, 0xab, 0xdf, 0x62, 0xc3, 0xbb, 0x47, 0x61, 0xd9, 0xfd, 0x48,
+    0x9a, 0x88, 0x60, 0xe9, 0xf5, 0x3e, 0x4e, 0x40, 0xac, 0x01, 0x90, 0xe0, 0xe2, 0x3a, 0xfd, 0x74,
+    0x68, 0xb6, 0x1d, 0xdc, 0xe9, 0x18, 0x2b, 0xba, 0x61, 0x47, 0x5b, 0x86, 0x7d, 0xa9, 0xf6, 0xb5,
+    0xbc, 0x43, 0x61, 0xa8, 0xd4, 0xf5, 0x1b, 0xdd, 0x42, 0xee, 0x13, 0x1d, 0x77, 0x85, 0xee, 0x72,
+    0x8c, 0xee, 0xf2, 0x41, 0xd7, 0x3f, 0xd1, 0x39, 0xa4, 0xe9, 0x2b, 0x3a, 0x4c, 0x69, 0x9d, 0x6f,
+    0xb7, 0x39, 0xad, 0x69, 0xe5, 0x1d, 0x87, 0x5c, 0x0d, 0xbb, 0x16, 0x22, 0x10, 0x4d, 0x3e, 0x40,
+    0xdc, 0xe8, 0x70, 0xa3, 0xb3, 0xc9, 0x80, 0x96, 0xee, 0x0f, 0xde, 0x91, 0x6a, 0xa3, 0x73, 0x9f,
+    0xe9, 0x6e, 0xe9, 0xed, 0x96, 0xd2, 0x4d, 0x7f, 0xbc, 0x55, 0x03, 0x65, 0x52, 0xec, 0x69, 0xa3,
+    0x27, 0xa3, 0x2b, 0x1f, 0xf7, 0xea, 0x5d, 0x01, 0xb3, 0x2e, 0x74, 0xfa, 0xfd, 0x42, 0x5c, 0xf6,
+    0x10, 0xff, 0x33, 0x5d, 0x7f, 0x94, 0x2e, 0x15, 0x3c, 0xe5, 0xd3, 0xeb, 0xdd, 0x3b, 0xd3, 0x60,
+    0xcb, 0x38, 0x08, 0x6f, 0x74, 0xa8, 0xb1, 0xde, 0xb3, 0xba, 0xc4, 0x62, 0x5e, 0xa7, 0xe1, 0x4f,
+    0xde, 0x39, 0x11, 0xf9, 0xc1, 0xbb, 0x64, 0xde, 0xa5, 0xb7, 0x8a, 0xce, 0xd4, 0xd1, 0x84, 0x22,
+    0x77, 0x3a, 0x20, 0x2e, 0x74, 0x43, 0x01, 0xeb, 0x35, 0xa7, 0x9b, 0x40, 0xd7, 0x16, 0x0e, 0x0c,
+    0xe3, 0x6f, 0xbd, 0x33, 0x54, 0xf8, 0x86, 0x0e, 0xb4, 0xed, 0xb4, 0xa8, 0xa9, 0x08, 0x9e, 0xe8,
+    0xa6, 0x64, 0xb6, 0xef, 0x7d, 0x67, 0x74, 0xa5, 0x23, 0xe3, 0x14, 0x35, 0xb3, 0x01, 0x5b, 0x2e,
+    0xd4, 0xd0, 0xa2, 0x1b, 0x7f, 0xdc, 0xb3, 0xaa, 0x83, 0x7b, 0xb6, 0xa2, 0x73, 0x70, 0xb9, 0xd3,
+    0x21, 0x6d, 0x74, 0x3d, 0x14, 0xba, 0xc5, 0xf2, 0xd8, 0x44, 0x19, 0x3a, 0x07, 0xba, 0x6c, 0xcd,
+    0xbb, 0xf0, 0xbd, 0x77, 0x7a, 0x21, 0xdf, 0xe7, 0xdd, 0xd4, 0x9c, 0x77, 0x48, 0xa6, 0xbd, 0x88,
+    0x54, 0x3c, 0x7f, 0xa2, 0xbb, 0x38, 0xf3, 0xae, 0x3b, 0x36, 0xef, 0xec, 0xfc, 0xf4, 0xbd, 0x77,
+    0x17, 0x1b, 0xe7, 0x91, 0x56, 0x9a, 0x8e, 0x78, 0x07, 0xb4, 0x6b, 0x32, 0x17, 0x2d, 0xdb, 0x52,
+    0xd3, 0xf5, 0xea, 0x57, 0xf5, 0xac, 0x90, 0x38, 0xb4, 0x0f, 0x50, 0xe3, 0xb7, 0x74, 0xb8, 0x3f,
+    0xcf, 0x88, 0xe0, 0x10, 0x5d, 0xa4, 0x4d, 0xfb, 0xcd, 0xf6, 0x9c, 0xad, 0xe9, 0xd0, 0xbe, 0xb2,
+    0xd0, 0x83, 0xb9, 0xdb, 0x6c, 0xbc, 0x70, 0xa7, 0xeb, 0x9e, 0xe8, 0x2c, 0x3b, 0xeb, 0x9a, 0x66,
+    0x68, 0x55, 0xb6, 0x3e, 0x7c, 0x0e, 0x48, 0xd5, 0x19, 0xa5, 0xae, 0x2c, 0x12, 0x1b, 0x5d, 0xb7,
+    0xa1, 0xbb, 0x23, 0x47, 0x63, 0x86, 0x6f, 0x25, 0xac, 0x01, 0xe5, 0xf0, 0xf9, 0xce, 0xc4, 0x4b,
+    0x7d, 0xbe, 0xfb, 0x52, 0x68, 0xc9, 0xa1, 0x29, 0xaf, 0x82, 0x7f, 0x90, 0x34, 0xcf, 0xc6, 0x13,
+    0xa0, 0xe9, 0xac, 0xff, 0x2b, 0x46, 0x38, 0xac, 0x47, 0x33, 0xba, 0xf4, 0x48, 0xb7, 0xd2, 0x63,
+    0xb5, 0xb2, 0x30, 0x7b, 0x0c, 0x79, 0x0b, 0x28, 0x08, 0x79, 0x0c, 0x88, 0x12, 0xf2, 0xe8, 0x39,
+    0xa0, 0xb0, 0x1c, 0x31, 0xef, 0x30, 0x1e, 0x8e, 0x4f, 0x95, 0x7d, 0x4a, 0x2f, 0x1f, 0x02, 0x55,
+    0xc0, 0x10, 0x7c, 0xe6, 0x30, 0x06, 0xcf, 0x39, 0x60, 0xf6, 0x70, 0xc5, 0x7c, 0xcd, 0x7a, 0x85,
+    0x10, 0x72, 0xf6, 0xa3, 0x1c, 0x31, 0xcf, 0xf3, 0x41, 0xb8, 0x00, 0x3f, 0x6b, 0x8d, 0x9b, 0x52,
+    0x4c, 0xa0, 0xf2, 0xd9, 0x2b, 0x5d, 0x08, 0xe3, 0xa8, 0x30, 0x62, 0x74, 0xd7, 0x7c, 0xf5, 0x4a,
+    0x37, 0xfa, 0xac, 0x74, 0x0c, 0x4d, 0xe5, 0xc3, 0x78, 0xd8, 0xec, 0x50, 0x4c, 0x77, 0xb1, 0xa5,
+    0x0e, 0x52, 0xe8, 0x94, 0x45, 0x7c, 0x1e, 0xd5, 0x36, 0xf5, 0xce, 0x5f, 0x95, 0x52, 0x82, 0x9a,
+    0x8a, 0x99, 0xe1, 0x3c, 0x3c, 0xfb, 0x5b, 0x0f, 0xe2, 0xf1, 0xd9, 0xef, 0x64, 0x9b, 0xc6, 0x19,
+    0x5c, 0x1b, 0xaf, 0x14, 0x56, 0x00, 0x4e, 0xc5, 0x6b, 0xd9, 0x97, 0x0f, 0x0f, 0x1e, 0x11, 0x81,
+    0x73, 0x75, 0xf5, 0x26, 0xf9, 0xde, 0x37, 0x1f, 0xfe, 0xef, 0x97, 0xda, 0x5f, 0xbf, 0x73, 0xc7,
+    0xfc, 0x02, 0xef, 0x94, 0x8d, 0xc1, 0x14, 0x82, 0xe0, 0xc6, 0x25, 0x72, 0xff, 0xc8, 0xd6, 0x2f,
+    0xc2, 0xf7, 0xa4, 0x00, 0x2f, 0x21, 0xfc, 0x0a, 0x50, 0xe0, 0x75, 0x84, 0xf2, 0xe0, 0x9a, 0xfc,
+    0xd7, 0x1e, 0x1c, 0x13, 0x00, 0x00, 0x00, 0x20, 0x0c, 0xb2, 0x7f, 0x6a, 0x33, 0xec, 0x07, 0x96,
+    0x01, 0x00, 0x00, 0x00, 0xc0, 0x01, 0x3a, 0x3c, 0xdf, 0x3b, 0xc7, 0xc8, 0xff, 0x89, 0x00, 0x00,
+    0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82, 0x00, 0x00,
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,141 @@
+/******************************************************************************
+* File Name: boot_timeline.c
+*
+* Description: This file contains the boot timeline. Each event keeps the time
+*              at which it was first reached, in milliseconds since the
+*              scheduler started. The timeline is printed once the first
+*              request has been served, and reported by /api/stats.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "boot_timeline.h"
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Names of the events, as printed and as JSON members. */
+static const char *const boot_event_names[BOOT_EVENT_COUNT] =
+{
+    "wifi_ready",
+    "credentials_loaded",
+    "sta_connected",
+    "softap_started",
+    "server_listening",
+    "first_request",
+};
+
+/* Time of each event, valid once its bit is set in reached_events. */
+static uint32_t event_msec[BOOT_EVENT_COUNT];
+static uint32_t reached_events = 0;
+
+/*******************************************************************************
+* Function Name: boot_timeline_mark
+********************************************************************************
+* Summary:
+*  Records that an event has been reached, unless it already was, and prints
+*  the timeline once the first request has been served.
+*
+* Parameters:
+*  event - Event reached.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void boot_timeline_mark(boot_event_t event)
+{
+    bool first = false;
+
+    taskENTER_CRITICAL();
+    if (0u == (reached_events & (1u << event)))
+    {
+        event_msec[event] = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        reached_events |= (1u << event);
+        first = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (first && (BOOT_EVENT_FIRST_REQUEST == event))
+    {
+        APP_INFO(("Boot timeline, ms since the scheduler started:\r\n"));
+        for (uint8_t index = 0; index < BOOT_EVENT_COUNT; index++)
+        {
+            if (0u != (reached_events & (1u << index)))
+            {
+                APP_INFO(("  %-20s %lu\r\n", boot_event_names[index], (unsigned long)event_msec[index]));
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: boot_timeline_write_json
+********************************************************************************
+* Summary:
+*  Writes the events reached so far as a "boot" JSON member.
+*
+* Parameters:
+*  builder - Builder the member is written to.
+*
+* Return:
+*  bool - true if the member was accepted.
+*
+*******************************************************************************/
+bool boot_timeline_write_json(response_builder_t *builder)
+{
+    bool separator = false;
+
+    response_builder_append_string(builder, "\"boot\":{");
+    for (uint8_t index = 0; index < BOOT_EVENT_COUNT; index++)
+    {
+        if (0u == (reached_events & (1u << index)))
+        {
+            continue;
+        }
+        response_builder_append_string(builder, separator ? ",\"" : "\"");
+        response_builder_append_string(builder, boot_event_names[index]);
+        response_builder_append_string(builder, "_msec\":");
+        response_builder_append_uint(builder, event_msec[index]);
+        separator = true;
+    }
+
+    return response_builder_append_string(builder, "}");
+}
+
+/* [] END OF FILE */
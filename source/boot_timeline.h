@@ -0,0 +1,74 @@
+/******************************************************************************
+* File Name: boot_timeline.h
+*
+* Description: This file contains the events and function prototypes of the
+*              boot timeline, which records when the steps from reset to the
+*              first served request are reached.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef BOOT_TIMELINE_H_
+#define BOOT_TIMELINE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "response_builder.h"
+
+/*******************************************************************************
+ *                    Enumerations
+*******************************************************************************/
+typedef enum
+{
+    BOOT_EVENT_WIFI_READY,          /* Wi-Fi connection manager initialized */
+    BOOT_EVENT_CREDENTIALS_LOADED,  /* Stored credentials decrypted */
+    BOOT_EVENT_STA_CONNECTED,       /* Connected to the AP */
+    BOOT_EVENT_SOFTAP_STARTED,      /* SoftAP started for provisioning */
+    BOOT_EVENT_SERVER_LISTENING,    /* First HTTP server listening */
+    BOOT_EVENT_FIRST_REQUEST,       /* First request served */
+    BOOT_EVENT_COUNT
+} boot_event_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void boot_timeline_mark(boot_event_t event);
+bool boot_timeline_write_json(response_builder_t *builder);
+
+#endif /* BOOT_TIMELINE_H_ */
+
+/* [] END OF FILE */
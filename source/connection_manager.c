@@ -0,0 +1,543 @@
+/******************************************************************************
+* File Name: connection_manager.c
+*
+* Description: This file contains the connection manager of the web server.
+*              The HTTP server accepts only MAX_SOCKETS connections, and long
+*              lived event streams or stalled keep-alive connections could
+*              otherwise occupy all of them. The manager records the last
+*              activity of every connection seen by a resource handler and
+*              keeps CONNECTION_RESERVED_REQUEST_SLOTS connections free of
+*              event streams.
+*
+*              Connections are identified by their response stream, which the
+*              HTTP server keeps for each of its sockets. The manager is not
+*              told when the HTTP server closes a connection, and the server
+*              may hand the stream of a closed connection to a new client, so
+*              only the event streams, which the server task writes to and
+*              forgets as soon as a write fails, are ever disconnected: the
+*              least recently active one to make room for a new dashboard, or
+*              one not written for CONNECTION_EVENT_STREAM_TIMEOUT_MSEC. A
+*              request connection is forgotten once a response to it fails or
+*              closes it, once its stream carries a new connection, or after
+*              CONNECTION_IDLE_TIMEOUT_MSEC without activity.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "connection_manager.h"
+
+/* Standard C header file */
+#include <string.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CONNECTION_NOT_FOUND                         (-1)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Connections seen by the resource handlers, updated inside critical sections. */
+static connection_t connections[CONNECTION_TABLE_LENGTH];
+
+/* Number of event streams closed because they were not written for too long. */
+static uint32_t idle_evictions = 0;
+
+/* Number of event streams closed to make room for another event stream. */
+static uint32_t pressure_evictions = 0;
+
+/*******************************************************************************
+* Function Name: find_connection
+********************************************************************************
+* Summary:
+*  Returns the slot of the connection using the given stream. Must be called
+*  inside a critical section.
+*
+* Parameters:
+*  stream - Response stream of the connection.
+*
+* Return:
+*  int8_t - Index of the slot, or CONNECTION_NOT_FOUND.
+*
+*******************************************************************************/
+static int8_t find_connection(const cy_http_response_stream_t *stream)
+{
+    for (uint8_t index = 0; index < CONNECTION_TABLE_LENGTH; index++)
+    {
+        if (connections[index].stream == stream)
+        {
+            return (int8_t)index;
+        }
+    }
+
+    return CONNECTION_NOT_FOUND;
+}
+
+/*******************************************************************************
+* Function Name: count_connections
+********************************************************************************
+* Summary:
+*  Returns the number of connections of the given type held by a server.
+*  Must be called inside a critical section.
+*
+* Parameters:
+*  type - Type of the connections to count.
+*  server - Server holding the connections, or CONNECTION_ANY_SERVER.
+*
+* Return:
+*  uint8_t - Number of connections.
+*
+*******************************************************************************/
+static uint8_t count_connections(connection_type_t type, uint8_t server)
+{
+    uint8_t count = 0;
+
+    for (uint8_t index = 0; index < CONNECTION_TABLE_LENGTH; index++)
+    {
+        if ((connections[index].stream != NULL) && (connections[index].type == type) &&
+            ((server == CONNECTION_ANY_SERVER) || (connections[index].server == server)))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: find_least_recently_active
+********************************************************************************
+* Summary:
+*  Returns the slot of the connection of the given type held by a server
+*  which has been idle for the longest time, provided it has been idle for at
+*  least min_idle ticks. Must be called inside a critical section.
+*
+* Parameters:
+*  type - Type of the connection to look for.
+*  server - Server holding the connection.
+*  now - Current tick count.
+*  min_idle - Minimum idle time in ticks.
+*
+* Return:
+*  int8_t - Index of the slot, or CONNECTION_NOT_FOUND.
+*
+*******************************************************************************/
+static int8_t find_least_recently_active(connection_type_t type, uint8_t server,
+                                         uint32_t now, uint32_t min_idle)
+{
+    int8_t found = CONNECTION_NOT_FOUND;
+    uint32_t longest_idle = 0;
+    uint32_t idle;
+
+    for (uint8_t index = 0; index < CONNECTION_TABLE_LENGTH; index++)
+    {
+        if ((connections[index].stream == NULL) || (connections[index].type != type) ||
+            (connections[index].server != server))
+        {
+            continue;
+        }
+
+        idle = now - connections[index].last_activity;
+        if ((idle >= min_idle) && ((found == CONNECTION_NOT_FOUND) || (idle > longest_idle)))
+        {
+            found = (int8_t)index;
+            longest_idle = idle;
+        }
+    }
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: evict_connection
+********************************************************************************
+* Summary:
+*  Removes an event stream from the table and returns its stream, which the
+*  caller disconnects once it has left the critical section. Must be called
+*  inside a critical section, and only for an event stream, which is known
+*  to be the connection the server task writes to.
+*
+* Parameters:
+*  index - Index of the slot.
+*  counter - Pointer to the eviction counter to increment.
+*
+* Return:
+*  cy_http_response_stream_t* - Stream to be disconnected.
+*
+*******************************************************************************/
+static cy_http_response_stream_t *evict_connection(int8_t index, uint32_t *counter)
+{
+    cy_http_response_stream_t *stream = connections[index].stream;
+
+    connections[index].stream = NULL;
+    (*counter)++;
+
+    return stream;
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_init
+********************************************************************************
+* Summary:
+*  Forgets all of the connections. Called once at boot, before the HTTP
+*  servers are created; the connections of a deleted server are forgotten by
+*  connection_manager_forget_server.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void connection_manager_init(void)
+{
+    taskENTER_CRITICAL();
+    memset(connections, 0, sizeof(connections));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_request
+********************************************************************************
+* Summary:
+*  Records a request received on a connection. Called by the resource
+*  handlers before they respond. A new event stream replaces the least
+*  recently active one of its server, which is disconnected, once
+*  CONNECTION_MAX_EVENT_STREAMS are open. A new connection takes the entry of the least recently active
+*  request connection if the server already holds CONNECTION_SLOT_COUNT: the
+*  HTTP server would not have accepted the connection had all of them still
+*  been open, so that entry is forgotten rather than disconnected, as its
+*  stream may already serve another client.
+*
+* Parameters:
+*  stream - Response stream of the connection.
+*  type - CONNECTION_TYPE_EVENT_STREAM if the response is an event stream.
+*  server - Server which received the request, a route_server_t.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void connection_manager_request(cy_http_response_stream_t *stream, connection_type_t type, uint8_t server)
+{
+    uint32_t now = xTaskGetTickCount();
+    cy_http_response_stream_t *victim = NULL;
+    int8_t index;
+    int8_t evicted;
+
+    taskENTER_CRITICAL();
+    index = find_connection(stream);
+
+    if ((type == CONNECTION_TYPE_EVENT_STREAM) &&
+        ((index == CONNECTION_NOT_FOUND) || (connections[index].type != CONNECTION_TYPE_EVENT_STREAM)) &&
+        (count_connections(CONNECTION_TYPE_EVENT_STREAM, server) >= CONNECTION_MAX_EVENT_STREAMS))
+    {
+        evicted = find_least_recently_active(CONNECTION_TYPE_EVENT_STREAM, server, now, 0);
+        victim = evict_connection(evicted, &pressure_evictions);
+    }
+
+    if ((index == CONNECTION_NOT_FOUND) &&
+        ((count_connections(CONNECTION_TYPE_REQUEST, server) +
+          count_connections(CONNECTION_TYPE_EVENT_STREAM, server)) >= CONNECTION_SLOT_COUNT))
+    {
+        index = find_least_recently_active(CONNECTION_TYPE_REQUEST, server, now, 0);
+        if (index == CONNECTION_NOT_FOUND)
+        {
+            index = find_least_recently_active(CONNECTION_TYPE_EVENT_STREAM, server, now, 0);
+        }
+    }
+
+    if (index == CONNECTION_NOT_FOUND)
+    {
+        index = find_connection(NULL);
+    }
+
+    connections[index].stream = stream;
+    connections[index].last_activity = now;
+    connections[index].type = type;
+    connections[index].server = server;
+    taskEXIT_CRITICAL();
+
+    if (victim != NULL)
+    {
+        cy_http_server_response_stream_disconnect(victim);
+    }
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_activity
+********************************************************************************
+* Summary:
+*  Records a successful write to a connection. Streams which are not in the
+*  table, because they have been evicted, are ignored.
+*
+* Parameters:
+*  stream - Response stream of the connection.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void connection_manager_activity(cy_http_response_stream_t *stream)
+{
+    uint32_t now = xTaskGetTickCount();
+    int8_t index;
+
+    taskENTER_CRITICAL();
+    index = find_connection(stream);
+    if ((stream != NULL) && (index != CONNECTION_NOT_FOUND))
+    {
+        connections[index].last_activity = now;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_response_done
+********************************************************************************
+* Summary:
+*  Records the end of a response. The connection is forgotten if the
+*  response could not be sent, as the HTTP server then closes it, or if it
+*  is a request connection whose responses carry "Connection: close".
+*
+* Parameters:
+*  stream - Response stream of the connection.
+*  sent - true if the handler sent its response.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void connection_manager_response_done(cy_http_response_stream_t *stream, bool sent)
+{
+    uint32_t now = xTaskGetTickCount();
+    int8_t index;
+
+    taskENTER_CRITICAL();
+    index = find_connection(stream);
+    if ((stream != NULL) && (index != CONNECTION_NOT_FOUND))
+    {
+        if (!sent || (!HTTP_CONNECTION_PERSISTENT && (connections[index].type == CONNECTION_TYPE_REQUEST)))
+        {
+            connections[index].stream = NULL;
+        }
+        else
+        {
+            connections[index].last_activity = now;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_release
+********************************************************************************
+* Summary:
+*  Forgets a connection which has been closed, for example after a write to
+*  it failed.
+*
+* Parameters:
+*  stream - Response stream of the connection.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void connection_manager_release(cy_http_response_stream_t *stream)
+{
+    int8_t index;
+
+    taskENTER_CRITICAL();
+    index = find_connection(stream);
+    if ((stream != NULL) && (index != CONNECTION_NOT_FOUND))
+    {
+        connections[index].stream = NULL;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_forget_server
+********************************************************************************
+* Summary:
+*  Forgets the connections of a server which has been deleted, whose streams
+*  are no longer valid.
+*
+* Parameters:
+*  server - Server whose connections are forgotten, a route_server_t.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void connection_manager_forget_server(uint8_t server)
+{
+    taskENTER_CRITICAL();
+    for (uint8_t index = 0; index < CONNECTION_TABLE_LENGTH; index++)
+    {
+        if (connections[index].server == server)
+        {
+            connections[index].stream = NULL;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_poll
+********************************************************************************
+* Summary:
+*  Closes the event streams not written for
+*  CONNECTION_EVENT_STREAM_TIMEOUT_MSEC, and forgets the request connections
+*  idle for CONNECTION_IDLE_TIMEOUT_MSEC without disconnecting them, as their
+*  streams may have been handed to another client in the meantime. Called
+*  periodically by the server task.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void connection_manager_poll(void)
+{
+    uint32_t now = xTaskGetTickCount();
+    cy_http_response_stream_t *victims[CONNECTION_TABLE_LENGTH];
+    uint8_t victim_count = 0;
+
+    taskENTER_CRITICAL();
+    for (uint8_t index = 0; index < CONNECTION_TABLE_LENGTH; index++)
+    {
+        if (connections[index].stream == NULL)
+        {
+            continue;
+        }
+
+        if (connections[index].type == CONNECTION_TYPE_EVENT_STREAM)
+        {
+            if ((now - connections[index].last_activity) >= pdMS_TO_TICKS(CONNECTION_EVENT_STREAM_TIMEOUT_MSEC))
+            {
+                victims[victim_count++] = evict_connection((int8_t)index, &idle_evictions);
+            }
+        }
+        else if ((now - connections[index].last_activity) >= pdMS_TO_TICKS(CONNECTION_IDLE_TIMEOUT_MSEC))
+        {
+            connections[index].stream = NULL;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    for (uint8_t index = 0; index < victim_count; index++)
+    {
+        cy_http_server_response_stream_disconnect(victims[index]);
+    }
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_get_event_streams
+********************************************************************************
+* Summary:
+*  Copies the streams of the open event streams.
+*
+* Parameters:
+*  streams - Array that receives the streams.
+*  max_streams - Number of entries of the array.
+*
+* Return:
+*  uint8_t - Number of streams copied.
+*
+*******************************************************************************/
+uint8_t connection_manager_get_event_streams(cy_http_response_stream_t **streams, uint8_t max_streams)
+{
+    uint8_t count = 0;
+
+    taskENTER_CRITICAL();
+    for (uint8_t index = 0; (index < CONNECTION_TABLE_LENGTH) && (count < max_streams); index++)
+    {
+        if ((connections[index].stream != NULL) &&
+            (connections[index].type == CONNECTION_TYPE_EVENT_STREAM))
+        {
+            streams[count++] = connections[index].stream;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: connection_manager_write_json
+********************************************************************************
+* Summary:
+*  Writes the number of open connections and the eviction counters as the
+*  members of a JSON object, without the braces.
+*
+* Parameters:
+*  builder - Builder the members are written to.
+*
+* Return:
+*  bool - true if all of the members were accepted.
+*
+*******************************************************************************/
+bool connection_manager_write_json(response_builder_t *builder)
+{
+    uint8_t event_streams;
+    uint8_t requests;
+    uint32_t idle;
+    uint32_t pressure;
+
+    taskENTER_CRITICAL();
+    event_streams = count_connections(CONNECTION_TYPE_EVENT_STREAM, CONNECTION_ANY_SERVER);
+    requests = count_connections(CONNECTION_TYPE_REQUEST, CONNECTION_ANY_SERVER);
+    idle = idle_evictions;
+    pressure = pressure_evictions;
+    taskEXIT_CRITICAL();
+
+    response_builder_append_string(builder, "\"connections\":");
+    response_builder_append_uint(builder, requests + event_streams);
+    response_builder_append_string(builder, ",\"event_streams\":");
+    response_builder_append_uint(builder, event_streams);
+    response_builder_append_string(builder, ",\"idle_evictions\":");
+    response_builder_append_uint(builder, idle);
+    response_builder_append_string(builder, ",\"pressure_evictions\":");
+    return response_builder_append_uint(builder, pressure);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,142 @@
+/******************************************************************************
+* File Name: connection_manager.h
+*
+* Description: This file contains the configuration, structures and function
+*              prototypes of the connection manager which shares the
+*              MAX_SOCKETS connections of the HTTP server between the event
+*              streams and the request/response traffic.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CONNECTION_MANAGER_H_
+#define CONNECTION_MANAGER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cy_http_server.h"
+#include "response_builder.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of connections accepted by the HTTP server. */
+#define CONNECTION_SLOT_COUNT                        (4u)
+
+/* Number of HTTP servers whose connections are tracked: the SoftAP and STA
+ * servers run side by side during the handover.
+ */
+#define CONNECTION_SERVER_COUNT                      (2u)
+#define CONNECTION_TABLE_LENGTH                      (CONNECTION_SLOT_COUNT * CONNECTION_SERVER_COUNT)
+#define CONNECTION_ANY_SERVER                        (0xFFu)
+
+/* Number of connections kept free of event streams, so that page loads and
+ * control requests are served while the dashboards are open.
+ */
+#define CONNECTION_RESERVED_REQUEST_SLOTS            (1u)
+#define CONNECTION_MAX_EVENT_STREAMS                 (CONNECTION_SLOT_COUNT - CONNECTION_RESERVED_REQUEST_SLOTS)
+
+/* Idle time after which a client may no longer reuse a keep-alive
+ * connection, advertised in the Keep-Alive header. Written without
+ * parentheses or suffix as it is pasted into the header text.
+ */
+#define HTTP_KEEP_ALIVE_TIMEOUT_SEC                  15
+
+/* Connection headers of the responses with a known length. Define
+ * HTTP_KEEP_ALIVE_DISABLED to have the clients close the connection after
+ * every response instead.
+ */
+#define HTTP_STRINGIFY(x)                            #x
+#define HTTP_TO_STRING(x)                            HTTP_STRINGIFY(x)
+#ifdef HTTP_KEEP_ALIVE_DISABLED
+#define HTTP_CONNECTION_HEADERS                      "Connection: close\r\n"
+#define HTTP_CONNECTION_PERSISTENT                   (false)
+#else
+#define HTTP_CONNECTION_HEADERS                      "Connection: keep-alive\r\n" \
+                                                     "Keep-Alive: timeout=" HTTP_TO_STRING(HTTP_KEEP_ALIVE_TIMEOUT_SEC) "\r\n"
+#define HTTP_CONNECTION_PERSISTENT                   (true)
+#endif /* #ifdef HTTP_KEEP_ALIVE_DISABLED */
+
+/* Time after which an idle keep-alive connection is forgotten, a second
+ * later than advertised, by which time the client has closed it.
+ */
+#define CONNECTION_IDLE_TIMEOUT_MSEC                 ((HTTP_KEEP_ALIVE_TIMEOUT_SEC + 1u) * 1000u)
+
+/* Interval at which the server task polls the connections while the device
+ * is provisioned over the SoftAP.
+ */
+#define CONNECTION_POLL_INTERVAL_MSEC                (50u)
+
+/* Time after which an event stream which could not be written is closed. */
+#define CONNECTION_EVENT_STREAM_TIMEOUT_MSEC         (5000u)
+
+/*******************************************************************************
+ *                    Enumerations
+*******************************************************************************/
+typedef enum
+{
+    CONNECTION_TYPE_REQUEST,        /* Request/response traffic, may be kept alive */
+    CONNECTION_TYPE_EVENT_STREAM    /* Long-lived server sent event stream */
+} connection_type_t;
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    cy_http_response_stream_t  *stream;         /* Stream of the connection, NULL if the slot is free */
+    uint32_t                    last_activity;  /* Tick count of the last request or write */
+    connection_type_t           type;
+    uint8_t                     server;         /* Server holding the connection, a route_server_t */
+} connection_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void connection_manager_init(void);
+void connection_manager_request(cy_http_response_stream_t *stream, connection_type_t type, uint8_t server);
+void connection_manager_activity(cy_http_response_stream_t *stream);
+void connection_manager_response_done(cy_http_response_stream_t *stream, bool sent);
+void connection_manager_release(cy_http_response_stream_t *stream);
+void connection_manager_forget_server(uint8_t server);
+void connection_manager_poll(void);
+uint8_t connection_manager_get_event_streams(cy_http_response_stream_t **streams, uint8_t max_streams);
+bool connection_manager_write_json(response_builder_t *builder);
+
+#endif /* CONNECTION_MANAGER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,337 @@
+/******************************************************************************
+* File Name: credential_store.c
+*
+* Description: This file contains the store which keeps the Wi-Fi credentials
+*              of the last successful connection in a row of the emulated
+*              EEPROM region of the internal flash. The credentials are
+*              encrypted and authenticated with AES-256-GCM under a key
+*              derived from the unique ID of the device, so a copy of the
+*              flash contents does not reveal them on another device and a
+*              damaged row is detected rather than used. The key is only as
+*              secret as the unique ID, which any code running on the device
+*              can read.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "credential_store.h"
+
+/* Standard C header files */
+#include <stddef.h>
+#include <string.h>
+
+/* mbed TLS header files */
+#include "mbedtls/gcm.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/platform_util.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of bytes of the nonce taken from the record sequence number, the
+ * remaining ones are random.
+ */
+#define CREDENTIAL_NONCE_SEQUENCE_LENGTH             (sizeof(uint32_t))
+
+/* Number of bytes of the record header authenticated with the credentials. */
+#define CREDENTIAL_HEADER_LENGTH                     (offsetof(credential_record_t, nonce))
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Flash row holding the credential record, placed in the emulated EEPROM
+ * region so that programming a new application leaves it alone.
+ */
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(CY_FLASH_SIZEOF_ROW)
+const uint8_t credential_row[CY_FLASH_SIZEOF_ROW] = {0u};
+
+/* Image of the flash row, assembled before the row is written. */
+static uint32_t row_buffer[CY_FLASH_SIZEOF_ROW / sizeof(uint32_t)];
+
+static cyhal_flash_t flash_obj;
+static bool store_initialized = false;
+
+/*******************************************************************************
+* Function Name: derive_key
+********************************************************************************
+* Summary:
+*  Derives the encryption key as the SHA-256 digest of CREDENTIAL_KEY_LABEL
+*  followed by the unique ID of the device.
+*
+* Parameters:
+*  key - Buffer of CREDENTIAL_KEY_LENGTH bytes receiving the key.
+*
+* Return:
+*  int - 0 on success, an mbed TLS error code otherwise.
+*
+*******************************************************************************/
+static int derive_key(uint8_t *key)
+{
+    uint8_t material[sizeof(CREDENTIAL_KEY_LABEL) - 1u + sizeof(uint64_t)];
+    uint64_t unique_id = Cy_SysLib_GetUniqueId();
+
+    memcpy(material, CREDENTIAL_KEY_LABEL, sizeof(CREDENTIAL_KEY_LABEL) - 1u);
+    memcpy(&material[sizeof(CREDENTIAL_KEY_LABEL) - 1u], &unique_id, sizeof(unique_id));
+
+    return mbedtls_sha256_ret(material, sizeof(material), key, 0);
+}
+
+/*******************************************************************************
+* Function Name: read_record
+********************************************************************************
+* Summary:
+*  Reads the credential record from flash and decrypts it.
+*
+* Parameters:
+*  record - Receives the record as stored in flash.
+*  credentials - Receives the decrypted credentials.
+*
+* Return:
+*  bool - true if the row holds a record of this version which passed
+*  authentication.
+*
+*******************************************************************************/
+static bool read_record(credential_record_t *record, credentials_t *credentials)
+{
+    uint8_t key[CREDENTIAL_KEY_LENGTH];
+    mbedtls_gcm_context gcm;
+    int status;
+
+    if (CY_RSLT_SUCCESS != cyhal_flash_read(&flash_obj, (uint32_t)(uintptr_t)credential_row,
+                                            (uint8_t *)record, sizeof(*record)))
+    {
+        return false;
+    }
+
+    if ((record->magic != CREDENTIAL_RECORD_MAGIC) || (record->version != CREDENTIAL_RECORD_VERSION))
+    {
+        return false;
+    }
+
+    mbedtls_gcm_init(&gcm);
+    status = derive_key(key);
+    if (0 == status)
+    {
+        status = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key, CREDENTIAL_KEY_LENGTH * 8u);
+    }
+    if (0 == status)
+    {
+        status = mbedtls_gcm_auth_decrypt(&gcm, sizeof(record->ciphertext),
+                                          record->nonce, sizeof(record->nonce),
+                                          (const uint8_t *)record, CREDENTIAL_HEADER_LENGTH,
+                                          record->tag, sizeof(record->tag),
+                                          record->ciphertext, (uint8_t *)credentials);
+    }
+    mbedtls_gcm_free(&gcm);
+    mbedtls_platform_zeroize(key, sizeof(key));
+
+    if (0 != status)
+    {
+        mbedtls_platform_zeroize(credentials, sizeof(*credentials));
+        ERR_INFO(("Stored Wi-Fi credentials failed authentication\r\n"));
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: credential_store_init
+********************************************************************************
+* Summary:
+*  Initializes the flash driver used by the store.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS, or the error returned by the flash driver.
+*
+*******************************************************************************/
+cy_rslt_t credential_store_init(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (!store_initialized)
+    {
+        result = cyhal_flash_init(&flash_obj);
+        store_initialized = (CY_RSLT_SUCCESS == result);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: credential_store_load
+********************************************************************************
+* Summary:
+*  Loads the stored credentials.
+*
+* Parameters:
+*  credentials - Receives the credentials.
+*
+* Return:
+*  bool - true if credentials were stored and could be decrypted.
+*
+*******************************************************************************/
+bool credential_store_load(credentials_t *credentials)
+{
+    credential_record_t record;
+
+    if (!store_initialized)
+    {
+        return false;
+    }
+
+    return read_record(&record, credentials);
+}
+
+/*******************************************************************************
+* Function Name: credential_store_save
+********************************************************************************
+* Summary:
+*  Encrypts the credentials and writes them to flash, unless the same
+*  credentials are already stored. The nonce is made of the sequence number
+*  of the record followed by random bytes from the TRNG.
+*
+* Parameters:
+*  credentials - Credentials to store.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS, CREDENTIAL_STORE_RSLT_CRYPTO_ERROR, or the
+*  error returned by the TRNG or the flash driver.
+*
+*******************************************************************************/
+cy_rslt_t credential_store_save(const credentials_t *credentials)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    credential_record_t *record = (credential_record_t *)row_buffer;
+    credential_record_t previous;
+    credentials_t stored;
+    uint8_t key[CREDENTIAL_KEY_LENGTH];
+    mbedtls_gcm_context gcm;
+    cyhal_trng_t trng_obj;
+    uint32_t random;
+    bool unchanged;
+    int status;
+
+    result = credential_store_init();
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    /* Spare the flash if the credentials have not changed */
+    memset(&previous, 0, sizeof(previous));
+    if (read_record(&previous, &stored))
+    {
+        unchanged = (0 == memcmp(&stored, credentials, sizeof(stored)));
+        mbedtls_platform_zeroize(&stored, sizeof(stored));
+        if (unchanged)
+        {
+            return CY_RSLT_SUCCESS;
+        }
+    }
+
+    memset(row_buffer, 0, sizeof(row_buffer));
+    record->magic = CREDENTIAL_RECORD_MAGIC;
+    record->version = CREDENTIAL_RECORD_VERSION;
+    record->sequence = (previous.magic == CREDENTIAL_RECORD_MAGIC) ? (previous.sequence + 1u) : 0u;
+    memcpy(record->nonce, &record->sequence, CREDENTIAL_NONCE_SEQUENCE_LENGTH);
+
+    result = cyhal_trng_init(&trng_obj);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+    for (uint32_t offset = CREDENTIAL_NONCE_SEQUENCE_LENGTH; offset < CREDENTIAL_NONCE_LENGTH;
+         offset += sizeof(random))
+    {
+        random = cyhal_trng_generate(&trng_obj);
+        memcpy(&record->nonce[offset], &random, sizeof(random));
+    }
+    cyhal_trng_free(&trng_obj);
+
+    mbedtls_gcm_init(&gcm);
+    status = derive_key(key);
+    if (0 == status)
+    {
+        status = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key, CREDENTIAL_KEY_LENGTH * 8u);
+    }
+    if (0 == status)
+    {
+        status = mbedtls_gcm_crypt_and_tag(&gcm, MBEDTLS_GCM_ENCRYPT, sizeof(*credentials),
+                                           record->nonce, sizeof(record->nonce),
+                                           (const uint8_t *)record, CREDENTIAL_HEADER_LENGTH,
+                                           (const uint8_t *)credentials, record->ciphertext,
+                                           sizeof(record->tag), record->tag);
+    }
+    mbedtls_gcm_free(&gcm);
+    mbedtls_platform_zeroize(key, sizeof(key));
+
+    if (0 != status)
+    {
+        return CREDENTIAL_STORE_RSLT_CRYPTO_ERROR;
+    }
+
+    return cyhal_flash_write(&flash_obj, (uint32_t)(uintptr_t)credential_row, row_buffer);
+}
+
+/*******************************************************************************
+* Function Name: credential_store_erase
+********************************************************************************
+* Summary:
+*  Erases the credential row, so that the next boot provisions the device
+*  through the SoftAP again. An erased row fails the magic check of the loader.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS, or the error returned by the flash driver.
+*
+*******************************************************************************/
+cy_rslt_t credential_store_erase(void)
+{
+    cy_rslt_t result = credential_store_init();
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    return cyhal_flash_erase(&flash_obj, (uint32_t)(uintptr_t)credential_row);
+}
+
+/* [] END OF FILE */
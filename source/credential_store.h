@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name: credential_store.h
+*
+* Description: This file contains the structure and function prototypes of
+*              the store which keeps the Wi-Fi credentials of the last
+*              successful connection in flash, so that the device can connect
+*              to the AP directly after a reset.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef CREDENTIAL_STORE_H_
+#define CREDENTIAL_STORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cy_result.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Lengths of the stored credentials, WIFI_SSID_LEN and WIFI_PWD_LEN. */
+#define CREDENTIAL_SSID_LENGTH                       (32u)
+#define CREDENTIAL_PASSWORD_LENGTH                   (64u)
+#define CREDENTIAL_BSSID_LENGTH                      (6u)
+
+/* Identifies a flash row holding credentials written by this version. */
+#define CREDENTIAL_RECORD_MAGIC                      (0x43524544u)
+#define CREDENTIAL_RECORD_VERSION                    (2u)
+
+/* Sizes of the AES-GCM key, nonce and authentication tag. */
+#define CREDENTIAL_KEY_LENGTH                        (32u)
+#define CREDENTIAL_NONCE_LENGTH                      (12u)
+#define CREDENTIAL_TAG_LENGTH                        (16u)
+
+/* Returned when the credentials cannot be encrypted. */
+#define CREDENTIAL_STORE_RSLT_CRYPTO_ERROR           (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0xB1u))
+
+/* Mixed with the unique ID of the device to derive the encryption key. */
+#define CREDENTIAL_KEY_LABEL                         "wifi-web-server credentials"
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    uint8_t     ssid[CREDENTIAL_SSID_LENGTH];
+    uint8_t     password[CREDENTIAL_PASSWORD_LENGTH];
+    uint32_t    security;                       /* cy_wcm_security_t of the AP */
+    uint8_t     bssid[CREDENTIAL_BSSID_LENGTH]; /* BSSID of the AP, all zeros if unknown */
+    uint8_t     channel;
+    uint8_t     band;                           /* cy_wcm_wifi_band_t of the AP */
+} credentials_t;
+
+/* Layout of the flash row. The header is authenticated along with the
+ * encrypted credentials.
+ */
+typedef struct
+{
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    sequence;                       /* Incremented on every save */
+    uint8_t     nonce[CREDENTIAL_NONCE_LENGTH];
+    uint8_t     tag[CREDENTIAL_TAG_LENGTH];
+    uint8_t     ciphertext[sizeof(credentials_t)];
+} credential_record_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+cy_rslt_t credential_store_init(void);
+bool credential_store_load(credentials_t *credentials);
+cy_rslt_t credential_store_save(const credentials_t *credentials);
+cy_rslt_t credential_store_erase(void);
+
+#endif /* CREDENTIAL_STORE_H_ */
+
+/* [] END OF FILE */
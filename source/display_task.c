@@ -0,0 +1,231 @@
+/******************************************************************************
+* File Name: display_task.c
+*
+* Description: This file contains the task which shows the light sensor
+*              voltage and the PWM duty cycle on the TFT display. The task is
+*              fed with sensor snapshots by the server task and redraws only
+*              the fields whose value has changed, at a capped frame rate. It
+*              also adds the latest readings to the sparkline once per
+*              SPARKLINE_SAMPLE_PERIOD_MSEC.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+
+#ifdef ENABLE_TFT
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+
+#include "sparkline.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Display task handle. */
+TaskHandle_t display_task_handle;
+
+/* Single entry queue holding the latest sensor snapshot to be displayed. */
+static QueueHandle_t display_queue = NULL;
+
+/* Storage of the display task and of its queue. */
+static StackType_t display_task_stack[DISPLAY_TASK_STACK_SIZE];
+static StaticTask_t display_task_tcb;
+static uint8_t display_queue_storage[DISPLAY_QUEUE_LENGTH * sizeof(sensor_snapshot_t)];
+static StaticQueue_t display_queue_buffer;
+_Static_assert((sizeof(display_task_stack) + sizeof(display_task_tcb)) == DISPLAY_TASK_MEMORY,
+               "DISPLAY_TASK_MEMORY does not match the storage of the display task");
+_Static_assert((sizeof(display_queue_storage) + sizeof(display_queue_buffer)) == DISPLAY_QUEUE_MEMORY,
+               "DISPLAY_QUEUE_MEMORY does not match the storage of the display queue");
+
+/* Last snapshot posted to the display task. */
+static sensor_snapshot_t posted_snapshot;
+
+/* Row at which the light sensor voltage is printed. */
+static uint16_t light_sensor_row_print;
+
+/* Row at which the duty cycle is printed. */
+static uint16_t duty_cycle_row_print;
+
+/*******************************************************************************
+* Function Name: display_task
+********************************************************************************
+* Summary:
+*  Waits for a new sensor snapshot and redraws the values which differ from
+*  the ones currently shown on the display. The task then sleeps for
+*  DISPLAY_FRAME_PERIOD_MSEC so that the display is not updated more often
+*  than the configured frame rate. The wait is bounded by the next sparkline
+*  sample, which draws a single column of the graph.
+*
+* Parameters:
+*  arg - Unused.
+*
+* Return:
+*  None.
+*
+*******************************************************************************/
+static void display_task(void *arg)
+{
+    sensor_snapshot_t snapshot = {0};
+    sensor_snapshot_t drawn_snapshot = {0};
+    bool first_frame = true;
+    bool snapshot_received = false;
+    char sensor_value_buffer[SENSOR_BUFFER_LENGTH];
+    size_t length;
+    TickType_t next_sample_tick;
+    int32_t remaining_ticks;
+    TickType_t wait_ticks;
+
+    (void)arg;
+
+    sparkline_init(0, duty_cycle_row_print + ROW_OFFSET);
+#ifdef SPARKLINE_BENCHMARK
+    sparkline_benchmark();
+#endif /* #ifdef SPARKLINE_BENCHMARK */
+
+    next_sample_tick = xTaskGetTickCount() + pdMS_TO_TICKS(SPARKLINE_SAMPLE_PERIOD_MSEC);
+
+    while (true)
+    {
+        remaining_ticks = (int32_t)(next_sample_tick - xTaskGetTickCount());
+        wait_ticks = (remaining_ticks > 0) ? (TickType_t)remaining_ticks : 0;
+
+        if (pdPASS == xQueueReceive(display_queue, &snapshot, wait_ticks))
+        {
+            snapshot_received = true;
+
+            if (first_frame || (snapshot.light_sensor_voltage != drawn_snapshot.light_sensor_voltage))
+            {
+                length = format_uint_fixed(sensor_value_buffer, snapshot.light_sensor_voltage, 4);
+                format_append(sensor_value_buffer, sizeof(sensor_value_buffer), &length, " mV");
+                GUI_DispStringAt(sensor_value_buffer, SENSOR_DISPLAY_OFFSET, light_sensor_row_print);
+            }
+
+            if (first_frame || (snapshot.duty != drawn_snapshot.duty))
+            {
+                length = format_uint_fixed(sensor_value_buffer, snapshot.duty, 3);
+                format_append(sensor_value_buffer, sizeof(sensor_value_buffer), &length, " %");
+                GUI_DispStringAt(sensor_value_buffer, SENSOR_DISPLAY_OFFSET, duty_cycle_row_print);
+            }
+
+            drawn_snapshot = snapshot;
+            first_frame = false;
+
+            vTaskDelay(pdMS_TO_TICKS(DISPLAY_FRAME_PERIOD_MSEC));
+        }
+
+        /* Add the latest readings to the graph once per sample period */
+        if ((int32_t)(xTaskGetTickCount() - next_sample_tick) >= 0)
+        {
+            if (snapshot_received)
+            {
+                sparkline_add(drawn_snapshot.light_sensor_voltage, drawn_snapshot.duty);
+            }
+            next_sample_tick += pdMS_TO_TICKS(SPARKLINE_SAMPLE_PERIOD_MSEC);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: start_display_task
+********************************************************************************
+* Summary:
+*  Creates the snapshot queue and the display task. Must be called after the
+*  labels of the sensor values have been drawn, as the display task becomes
+*  the only user of the display from then on.
+*
+* Parameters:
+*  light_sensor_row - Row at which the light sensor voltage is printed.
+*  duty_cycle_row - Row at which the duty cycle is printed.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void start_display_task(uint16_t light_sensor_row, uint16_t duty_cycle_row)
+{
+    if (NULL != display_task_handle)
+    {
+        return;
+    }
+
+    light_sensor_row_print = light_sensor_row;
+    duty_cycle_row_print = duty_cycle_row;
+
+    display_queue = xQueueCreateStatic(DISPLAY_QUEUE_LENGTH, sizeof(sensor_snapshot_t),
+                                       display_queue_storage, &display_queue_buffer);
+    configASSERT(display_queue != NULL);
+
+    display_task_handle = xTaskCreateStatic(display_task, "Display", DISPLAY_TASK_STACK_SIZE, NULL,
+                                            DISPLAY_TASK_PRIORITY, display_task_stack, &display_task_tcb);
+    configASSERT(display_task_handle != NULL);
+}
+
+/*******************************************************************************
+* Function Name: display_update
+********************************************************************************
+* Summary:
+*  Hands a sensor snapshot over to the display task. The snapshot is only
+*  posted if it differs from the previous one, so the display task stays
+*  blocked while the readings are stable. A snapshot that has not been drawn
+*  yet is replaced by the newer one.
+*
+* Parameters:
+*  snapshot - Pointer to the latest sensor readings.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void display_update(const sensor_snapshot_t *snapshot)
+{
+    static bool posted = false;
+
+    if ((display_queue == NULL) ||
+        (posted && (snapshot->light_sensor_voltage == posted_snapshot.light_sensor_voltage) &&
+         (snapshot->duty == posted_snapshot.duty)))
+    {
+        return;
+    }
+
+    posted_snapshot = *snapshot;
+    posted = true;
+    xQueueOverwrite(display_queue, snapshot);
+}
+
+#endif /* #ifdef ENABLE_TFT */
+
+/* [] END OF FILE */
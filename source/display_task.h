@@ -0,0 +1,77 @@
+/******************************************************************************
+* File Name: display_task.h
+*
+* Description: This file contains the macros and function prototypes of the
+*              task which updates the sensor values on the TFT display.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef DISPLAY_TASK_H_
+#define DISPLAY_TASK_H_
+
+#include "sensors.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Display task stack size in words */
+#define DISPLAY_TASK_STACK_SIZE                         (1024u)
+
+/* Number of snapshots waiting to be drawn, only the latest one is kept. */
+#define DISPLAY_QUEUE_LENGTH                            (1u)
+
+/* RAM taken by the display task and its queue, checked against their storage. */
+#define DISPLAY_TASK_MEMORY                             RTOS_TASK_MEMORY(DISPLAY_TASK_STACK_SIZE)
+#define DISPLAY_QUEUE_MEMORY                            RTOS_QUEUE_MEMORY(DISPLAY_QUEUE_LENGTH, sizeof(sensor_snapshot_t))
+
+/* Display task priority, below the server task so that rendering never
+ * delays the network loop.
+ */
+#define DISPLAY_TASK_PRIORITY                           (tskIDLE_PRIORITY)
+
+/* Minimum time in milliseconds between two display updates */
+#define DISPLAY_FRAME_PERIOD_MSEC                       (200u)
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void start_display_task(uint16_t light_sensor_row, uint16_t duty_cycle_row);
+void display_update(const sensor_snapshot_t *snapshot);
+
+#endif /* DISPLAY_TASK_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,281 @@
+/******************************************************************************
+* File Name: fast_format.c
+*
+* Description: This file contains allocation-free formatting routines for
+*              unsigned decimal values, zero padded fixed-width values, IPv4
+*              addresses and bounded string concatenation. They replace
+*              sprintf on the paths executed for every sensor update, which
+*              keeps newlib's formatted I/O off the task stacks.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "fast_format.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Two-digit decimal representations of 0 to 99. */
+static const char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/*******************************************************************************
+* Function Name: count_digits
+********************************************************************************
+* Summary:
+*  Returns the number of decimal digits of a value.
+*
+* Parameters:
+*  value - Value to be formatted.
+*
+* Return:
+*  uint8_t - Number of digits, at least 1.
+*
+*******************************************************************************/
+static uint8_t count_digits(uint32_t value)
+{
+    uint8_t digits = 1;
+
+    while (value >= 100)
+    {
+        value /= 100;
+        digits += 2;
+    }
+
+    return (value >= 10) ? (digits + 1) : digits;
+}
+
+/*******************************************************************************
+* Function Name: write_digits
+********************************************************************************
+* Summary:
+*  Writes the digits of a value ending just before the given position,
+*  two digits per division.
+*
+* Parameters:
+*  end - Pointer one past the last digit.
+*  value - Value to be formatted.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void write_digits(char *end, uint32_t value)
+{
+    uint32_t pair;
+
+    while (value >= 100)
+    {
+        pair = (value % 100) * 2;
+        value /= 100;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    }
+
+    if (value >= 10)
+    {
+        pair = value * 2;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+}
+
+/*******************************************************************************
+* Function Name: format_uint
+********************************************************************************
+* Summary:
+*  Formats an unsigned value in decimal, as sprintf("%u") does.
+*
+* Parameters:
+*  dst - Buffer of at least FORMAT_UINT_MAX_DIGITS + 1 bytes.
+*  value - Value to be formatted.
+*
+* Return:
+*  uint8_t - Number of characters written, excluding the terminating NULL.
+*
+*******************************************************************************/
+uint8_t format_uint(char *dst, uint32_t value)
+{
+    uint8_t digits = count_digits(value);
+
+    write_digits(dst + digits, value);
+    dst[digits] = '\0';
+
+    return digits;
+}
+
+/*******************************************************************************
+* Function Name: format_uint_fixed
+********************************************************************************
+* Summary:
+*  Formats an unsigned value in decimal padded with leading zeros to the
+*  given width, as sprintf("%0*u") does. Values with more digits than the
+*  width are written in full.
+*
+* Parameters:
+*  dst - Buffer large enough for the width or the digits, whichever is larger,
+*        and the terminating NULL.
+*  value - Value to be formatted.
+*  width - Minimum number of characters written.
+*
+* Return:
+*  uint8_t - Number of characters written, excluding the terminating NULL.
+*
+*******************************************************************************/
+uint8_t format_uint_fixed(char *dst, uint32_t value, uint8_t width)
+{
+    uint8_t digits = count_digits(value);
+    uint8_t length = (digits > width) ? digits : width;
+
+    for (uint8_t index = 0; index < (length - digits); index++)
+    {
+        dst[index] = '0';
+    }
+    write_digits(dst + length, value);
+    dst[length] = '\0';
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: format_ipv4
+********************************************************************************
+* Summary:
+*  Formats an IPv4 address in dotted decimal notation. The first octet is
+*  held in the least significant byte, as in cy_wcm_ip_address_t.
+*
+* Parameters:
+*  dst - Buffer of at least FORMAT_IPV4_BUFFER_LENGTH bytes.
+*  ip_address - IPv4 address to be formatted.
+*
+* Return:
+*  uint8_t - Number of characters written, excluding the terminating NULL.
+*
+*******************************************************************************/
+uint8_t format_ipv4(char *dst, uint32_t ip_address)
+{
+    uint8_t length = 0;
+
+    for (uint8_t octet = 0; octet < 4; octet++)
+    {
+        if (octet != 0)
+        {
+            dst[length++] = '.';
+        }
+        length += format_uint(&dst[length], (ip_address >> (octet * 8)) & 0xff);
+    }
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: format_append
+********************************************************************************
+* Summary:
+*  Appends a string to a NULL terminated buffer without overrunning it. The
+*  buffer stays NULL terminated if the string has to be truncated.
+*
+* Parameters:
+*  dst - Buffer to append to.
+*  capacity - Size of the buffer in bytes, including the terminating NULL.
+*  length - Current length of the string in the buffer, updated on return.
+*  src - String to be appended.
+*
+* Return:
+*  bool - true if the whole string was appended, false if it was truncated.
+*
+*******************************************************************************/
+bool format_append(char *dst, size_t capacity, size_t *length, const char *src)
+{
+    size_t position = *length;
+
+    if (position >= capacity)
+    {
+        return false;
+    }
+
+    while ((*src != '\0') && (position < (capacity - 1)))
+    {
+        dst[position++] = *src++;
+    }
+    dst[position] = '\0';
+    *length = position;
+
+    return (*src == '\0');
+}
+
+/*******************************************************************************
+* Function Name: format_append_uint
+********************************************************************************
+* Summary:
+*  Appends an unsigned decimal value to a NULL terminated buffer without
+*  overrunning it. Nothing is appended if the value does not fit.
+*
+* Parameters:
+*  dst - Buffer to append to.
+*  capacity - Size of the buffer in bytes, including the terminating NULL.
+*  length - Current length of the string in the buffer, updated on return.
+*  value - Value to be appended.
+*
+* Return:
+*  bool - true if the value was appended, false if it did not fit.
+*
+*******************************************************************************/
+bool format_append_uint(char *dst, size_t capacity, size_t *length, uint32_t value)
+{
+    uint8_t digits = count_digits(value);
+
+    if ((*length + digits) >= capacity)
+    {
+        return false;
+    }
+
+    *length += format_uint(&dst[*length], value);
+
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,71 @@
+/******************************************************************************
+* File Name: fast_format.h
+*
+* Description: This file contains the macros and function prototypes of the
+*              allocation-free integer, IPv4 and string formatting routines
+*              used in place of sprintf on the hot paths.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef FAST_FORMAT_H_
+#define FAST_FORMAT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of digits of a 32-bit unsigned value */
+#define FORMAT_UINT_MAX_DIGITS                          (10u)
+
+/* Size of a buffer holding a dotted IPv4 address and the terminating NULL */
+#define FORMAT_IPV4_BUFFER_LENGTH                       (16u)
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+uint8_t format_uint(char *dst, uint32_t value);
+uint8_t format_uint_fixed(char *dst, uint32_t value, uint8_t width);
+uint8_t format_ipv4(char *dst, uint32_t ip_address);
+bool format_append(char *dst, size_t capacity, size_t *length, const char *src);
+bool format_append_uint(char *dst, size_t capacity, size_t *length, uint32_t value);
+
+#endif /* FAST_FORMAT_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,381 @@
+/******************************************************************************
+* File Name: form_parser.c
+*
+* Description: This file contains the streaming parser of
+*              application/x-www-form-urlencoded bodies. The body is fed in
+*              pieces as the HTTP server receives it; '+' and percent escapes
+*              are decoded on the fly and each value is written straight to
+*              the buffer of its field, whatever the order of the fields.
+*              The parser has no dependency on the platform, so it can be
+*              built on the host by scripts/form_parser_check.py.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "form_parser.h"
+#include "url_decode.h"
+
+/* Standard C header file */
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FORM_ESCAPE_DIGITS                           (2u)
+
+/*******************************************************************************
+* Function Name: start_value
+********************************************************************************
+* Summary:
+*  Selects the field named by the key just read to receive the value which
+*  follows, and clears its previous value.
+*
+* Parameters:
+*  parser - Parser.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void start_value(form_parser_t *parser)
+{
+    form_field_t *field;
+
+    parser->in_value = true;
+    parser->field = NULL;
+    if (parser->key_overflow)
+    {
+        return;
+    }
+
+    for (uint8_t index = 0; index < parser->field_count; index++)
+    {
+        field = &parser->fields[index];
+        if ((strlen(field->name) == parser->key_length) &&
+            (0 == memcmp(field->name, parser->key, parser->key_length)))
+        {
+            memset(field->value, 0, field->capacity);
+            field->length = 0;
+            field->found = true;
+            field->overflow = false;
+            parser->field = field;
+            return;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: end_field
+********************************************************************************
+* Summary:
+*  Ends the current field at a '&' or at the end of the body. A name without
+*  '=' gives the field an empty value.
+*
+* Parameters:
+*  parser - Parser.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void end_field(form_parser_t *parser)
+{
+    if (!parser->in_value && ((parser->key_length != 0u) || parser->key_overflow))
+    {
+        start_value(parser);
+    }
+
+    parser->in_value = false;
+    parser->field = NULL;
+    parser->key_length = 0;
+    parser->key_overflow = false;
+}
+
+/*******************************************************************************
+* Function Name: emit
+********************************************************************************
+* Summary:
+*  Appends a decoded character to the current key or value.
+*
+* Parameters:
+*  parser - Parser.
+*  character - Decoded character.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void emit(form_parser_t *parser, uint8_t character)
+{
+    form_field_t *field = parser->field;
+
+    if (!parser->in_value)
+    {
+        if (parser->key_length < FORM_PARSER_KEY_LENGTH)
+        {
+            parser->key[parser->key_length++] = (char)character;
+        }
+        else
+        {
+            parser->key_overflow = true;
+        }
+    }
+    else if (field != NULL)
+    {
+        if (field->length < field->capacity)
+        {
+            field->value[field->length++] = character;
+        }
+        else
+        {
+            field->overflow = true;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: append_plain_run
+********************************************************************************
+* Summary:
+*  Appends the bytes up to the next '%', '&', '+' or, in a key, '=', which
+*  need no decoding, to the current key or value in one copy.
+*
+* Parameters:
+*  parser - Parser, with no escape pending.
+*  data - Next bytes of the body.
+*  length - Number of bytes available.
+*
+* Return:
+*  size_t - Number of bytes consumed.
+*
+*******************************************************************************/
+static size_t append_plain_run(form_parser_t *parser, const uint8_t *data, size_t length)
+{
+    form_field_t *field = parser->field;
+    uint8_t key_end = parser->in_value ? '&' : '=';
+    size_t run = 0;
+    size_t room;
+
+    while ((run < length) && (data[run] != '%') && (data[run] != '&') && (data[run] != '+') &&
+           (data[run] != key_end))
+    {
+        run++;
+    }
+
+    if (!parser->in_value)
+    {
+        room = FORM_PARSER_KEY_LENGTH - parser->key_length;
+        if (run > room)
+        {
+            parser->key_overflow = true;
+        }
+        memcpy(&parser->key[parser->key_length], data, (run > room) ? room : run);
+        parser->key_length += (uint8_t)((run > room) ? room : run);
+    }
+    else if ((field != NULL) && (run != 0u))
+    {
+        room = field->capacity - field->length;
+        if (run > room)
+        {
+            field->overflow = true;
+        }
+        memcpy(&field->value[field->length], data, (run > room) ? room : run);
+        field->length += (run > room) ? room : run;
+    }
+
+    return run;
+}
+
+/*******************************************************************************
+* Function Name: form_parser_init
+********************************************************************************
+* Summary:
+*  Prepares a parser for a new body and clears the values of the fields.
+*
+* Parameters:
+*  parser - Parser to be initialized.
+*  fields - Fields of the form, filled in by the parser.
+*  field_count - Number of fields.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void form_parser_init(form_parser_t *parser, form_field_t *fields, uint8_t field_count)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->fields = fields;
+    parser->field_count = field_count;
+
+    for (uint8_t index = 0; index < field_count; index++)
+    {
+        memset(fields[index].value, 0, fields[index].capacity);
+        fields[index].length = 0;
+        fields[index].found = false;
+        fields[index].overflow = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: form_parser_feed
+********************************************************************************
+* Summary:
+*  Parses the next piece of the body. A piece may end anywhere, including
+*  inside a field name or a percent escape.
+*
+* Parameters:
+*  parser - Parser.
+*  data - Piece of the body, not NUL terminated.
+*  length - Length of the piece in bytes.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void form_parser_feed(form_parser_t *parser, const uint8_t *data, size_t length)
+{
+    uint8_t character;
+    uint8_t digit;
+    size_t index = 0;
+
+    while (index < length)
+    {
+        /* Most of a form needs no decoding */
+        if (parser->escape_digits == 0u)
+        {
+            index += append_plain_run(parser, &data[index], length - index);
+            if (index == length)
+            {
+                break;
+            }
+        }
+
+        character = data[index++];
+
+        if (parser->escape_digits != 0u)
+        {
+            digit = url_hex_digit_values[character];
+            if (digit != URL_HEX_INVALID)
+            {
+                parser->escape_value = (uint8_t)((parser->escape_value << 4) | digit);
+                if (--parser->escape_digits == 0u)
+                {
+                    emit(parser, parser->escape_value);
+                }
+                continue;
+            }
+
+            /* The character is not part of the escape, parse it on its own */
+            parser->bad_escape = true;
+            parser->escape_digits = 0;
+        }
+
+        switch (character)
+        {
+            case '%':
+                parser->escape_digits = FORM_ESCAPE_DIGITS;
+                parser->escape_value = 0;
+                break;
+
+            case '&':
+                end_field(parser);
+                break;
+
+            case '=':
+                if (!parser->in_value)
+                {
+                    start_value(parser);
+                }
+                else
+                {
+                    emit(parser, character);
+                }
+                break;
+
+            case '+':
+                emit(parser, ' ');
+                break;
+
+            default:
+                emit(parser, character);
+                break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: form_parser_finish
+********************************************************************************
+* Summary:
+*  Ends the body and checks the fields.
+*
+* Parameters:
+*  parser - Parser.
+*
+* Return:
+*  form_parser_result_t - FORM_PARSER_OK if the body was well formed, every
+*  value fit in its field and every required field was found.
+*
+*******************************************************************************/
+form_parser_result_t form_parser_finish(form_parser_t *parser)
+{
+    if (parser->escape_digits != 0u)
+    {
+        parser->bad_escape = true;
+        parser->escape_digits = 0;
+    }
+    end_field(parser);
+
+    if (parser->bad_escape)
+    {
+        return FORM_PARSER_BAD_ESCAPE;
+    }
+    for (uint8_t index = 0; index < parser->field_count; index++)
+    {
+        if (parser->fields[index].overflow)
+        {
+            return FORM_PARSER_VALUE_TOO_LONG;
+        }
+    }
+    for (uint8_t index = 0; index < parser->field_count; index++)
+    {
+        if (parser->fields[index].required && !parser->fields[index].found)
+        {
+            return FORM_PARSER_MISSING_FIELD;
+        }
+    }
+
+    return FORM_PARSER_OK;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/******************************************************************************
+* File Name: form_parser.h
+*
+* Description: This file contains the structures and function prototypes of
+*              the streaming parser of application/x-www-form-urlencoded
+*              bodies, which decodes the fields of a form into fixed size
+*              buffers in a single pass as the body arrives.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef FORM_PARSER_H_
+#define FORM_PARSER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Longest field name recognized; longer names are skipped with their value. */
+#define FORM_PARSER_KEY_LENGTH                       (16u)
+
+/*******************************************************************************
+ *                    Enumerations
+*******************************************************************************/
+typedef enum
+{
+    FORM_PARSER_OK,                 /* Every required field was found */
+    FORM_PARSER_BAD_ESCAPE,         /* A '%' was not followed by two hex digits */
+    FORM_PARSER_VALUE_TOO_LONG,     /* A value did not fit in its field */
+    FORM_PARSER_MISSING_FIELD       /* A required field was not found */
+} form_parser_result_t;
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+/* Field of a form. The value is decoded into a buffer of capacity bytes,
+ * which is zero padded and not NUL terminated when the value fills it. If a
+ * field appears more than once, its last value is kept.
+ */
+typedef struct
+{
+    const char     *name;
+    uint8_t        *value;
+    size_t          capacity;
+    bool            required;
+    size_t          length;                 /* Length of the decoded value */
+    bool            found;
+    bool            overflow;               /* The value was longer than capacity */
+} form_field_t;
+
+typedef struct
+{
+    form_field_t   *fields;
+    uint8_t         field_count;
+    form_field_t   *field;                  /* Field receiving the value, NULL to skip it */
+    char            key[FORM_PARSER_KEY_LENGTH];
+    uint8_t         key_length;
+    bool            key_overflow;
+    bool            in_value;               /* The '=' of the current field was read */
+    uint8_t         escape_digits;          /* Hex digits expected by a pending escape */
+    uint8_t         escape_value;
+    bool            bad_escape;
+} form_parser_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void form_parser_init(form_parser_t *parser, form_field_t *fields, uint8_t field_count);
+void form_parser_feed(form_parser_t *parser, const uint8_t *data, size_t length);
+form_parser_result_t form_parser_finish(form_parser_t *parser);
+
+#endif /* FORM_PARSER_H_ */
+
+/* [] END OF FILE */
@@ -62,13 +62,6 @@
 #endif
 
 
-/*******************************************************************************
-* Macros
-******************************************************************************/
-/* RTOS related macros. */
-#define SERVER_TASK_STACK_SIZE        (10 * 1024)
-#define SERVER_TASK_PRIORITY          (1)
-
 /*******************************************************************************
 * Global Variables
 ********************************************************************************/
@@ -78,6 +71,12 @@ volatile int uxTopUsedPriority;
 /* SOFTAP server task handle. */
 TaskHandle_t server_task_handle;
 
+/* Storage of the server task. */
+static StackType_t server_task_stack[SERVER_TASK_STACK_SIZE];
+static StaticTask_t server_task_tcb;
+_Static_assert((sizeof(server_task_stack) + sizeof(server_task_tcb)) == SERVER_TASK_MEMORY,
+               "SERVER_TASK_MEMORY does not match the storage of the server task");
+
 /*******************************************************************************
  * Function Name: main
  *******************************************************************************
@@ -129,9 +128,14 @@ int main(void)
     APP_INFO(("               Wi-Fi Web Server                   \n"));
     APP_INFO(("============================================================\n\n"));
 
+    /* All of the tasks, queues and mutexes of the application are allocated
+     * statically, print where the RAM goes.
+     */
+    rtos_memory_map_print();
+
     /* Starts the SoftAP and then HTTP server . */
-    xTaskCreate(server_task, "HTTP Web Server", SERVER_TASK_STACK_SIZE, NULL,
-                SERVER_TASK_PRIORITY, &server_task_handle);
+    server_task_handle = xTaskCreateStatic(server_task, "HTTP Web Server", SERVER_TASK_STACK_SIZE, NULL,
+                                           SERVER_TASK_PRIORITY, server_task_stack, &server_task_tcb);
 
     /* Start the FreeRTOS scheduler */
     vTaskStartScheduler();
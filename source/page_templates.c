@@ -0,0 +1,264 @@
+/******************************************************************************
+* File Name: page_templates.c
+*
+* Description: This file is generated by scripts/page_templates.py
+*              from web/templates. Do not edit it by hand.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stddef.h>
+
+#include "page_templates.h"
+
+/* web/templates/connect_in_progress.html */
+static const char page_connect_in_progress_text_0[] =
+    "<html><body><h1 id=\"wifi_stat\">Trying to connect to Wi-Fi. Please wait"
+    "...</h1></body></html>";
+
+static const template_segment_t page_connect_in_progress_segments[] =
+{
+    { page_connect_in_progress_text_0, 92u, 0u },
+};
+
+const page_template_t page_connect_in_progress =
+{
+    page_connect_in_progress_segments, 1u
+};
+
+/* web/templates/device_data.html */
+static const char page_device_data_text_0[] =
+    "<!DOCTYPE html><html><head><title>Wi-Fi Web Server Demo Device Status</t"
+    "itle></head><body><h1 style=\"text-align: center\"> Device Data Logger <"
+    "/h1><style>.container{position:relative}.topleft{position:absolute;top:8"
+    "px;left:16px;font-size:18px}img{width:auto;height:auto}</style><div clas"
+    "s=\"container\"><img alt=\"logo.png\" src=\"/logo.png\"/><div class=\"to"
+    "pleft\"></div></div><br><br><p>Click to increase or decrease duty cycle<"
+    "/p><button type=\"button\" onclick=\"send_command('Increase')\" id=\"inc"
+    "rease_btn\">Increase</button> <button type=\"button\" onclick=\"send_com"
+    "mand('Decrease')\" id=\"decrease_btn\">Decrease</button><br><br><br><br>"
+    "<div id=\"device_data\" value=\"100\"></div><script>function btn_disable"
+    "_function(){var buttons=[document.getElementById(\"increase_btn\"),docum"
+    "ent.getElementById(\"decrease_btn\")];var labels=[\"Increase\",\"Decreas"
+    "e\"];buttons.forEach(function(button){button.innerText=\"Please Wait..."
+    "\";button.disabled=true;});setTimeout(function(){buttons.forEach(functio"
+    "n(button,index){button.innerText=labels[index];button.disabled=false;});"
+    "},1000);}function send_command(command){btn_disable_function();var xhttp"
+    "=new XMLHttpRequest();xhttp.open(\"POST\",\"/\",true);xhttp.setRequestHe"
+    "ader(\"Content-type\",\"application/x-www-form-urlencoded\");xhttp.send("
+    "command);}if(typeof(EventSource)!==\"undefined\"){var source=new EventSo"
+    "urce(\"/events\");source.onmessage=function(event){document.getElementBy"
+    "Id(\"device_data\").innerHTML=event.data;};}else{document.getElementById"
+    "(\"device_data\").innerHTML=\"Sorry, your browser does not support serve"
+    "r-sent events...\";}</script></body></html>";
+
+static const template_segment_t page_device_data_segments[] =
+{
+    { page_device_data_text_0, 1572u, 0u },
+};
+
+const page_template_t page_device_data =
+{
+    page_device_data_segments, 1u
+};
+
+/* web/templates/device_data_redirect.html */
+static const char page_device_data_redirect_text_0[] =
+    "<!DOCTYPE html><html><head><title>Device Data - Redirect Page</title></h"
+    "ead><body><h1>Device Data - Redirect page </h1><p>To view the device dat"
+    "a please connect your PC to the same Wi-Fi network to which you have con"
+    "nected the device. Open the web browser of your choice and enter the URL"
+    " http://<i><b>IP address</i></b>:80, where <i><b>IP address</i></b> is t"
+    "he one that is displayed on the UART terminal.</p></body></html>";
+
+static const template_segment_t page_device_data_redirect_segments[] =
+{
+    { page_device_data_redirect_text_0, 424u, 0u },
+};
+
+const page_template_t page_device_data_redirect =
+{
+    page_device_data_redirect_segments, 1u
+};
+
+/* web/templates/scan_in_progress.html */
+static const char page_scan_in_progress_text_0[] =
+    "<html><body><h1 id=\"wifi_scan_stat\">Scanning for available APs. Please"
+    " wait...</h1></body></html>";
+
+static const template_segment_t page_scan_in_progress_segments[] =
+{
+    { page_scan_in_progress_text_0, 97u, 0u },
+};
+
+const page_template_t page_scan_in_progress =
+{
+    page_scan_in_progress_segments, 1u
+};
+
+/* web/templates/scan_live.html */
+static const char page_scan_live_text_0[] =
+    "<!DOCTYPE html><html><head><title>AP Scan Status</title></head><body><h1"
+    ">Available AP List - LogIn Page </h1><p id=\"scan_status\">Scanning for "
+    "available APs...</p><p>The available access points are listed below. Ple"
+    "ase enter appropriate credentials and click the <i><b>Connect to Wi-Fi</"
+    "b></i> button.</p><textarea id=\"ssid_list\" readonly rows=\"4\" cols=\""
+    "50\" style=\"font-size:large; color: rgb(11, 11, 11); background-color: "
+    "rgb(232, 221, 238);width: 450px; height: 180px;\"></textarea></br></br><"
+    "form action=\"/\" method=\"post\"><fieldset><legend>Enter Credentials</l"
+    "egend><label><b>SSID </b></label></br><input type=\"text\" placeholder="
+    "\"Enter SSID\" name=\"SSID\" size=\"30\"/></br></br><label><b> Password<"
+    "/b></label></br><input type=\"password\" placeholder=\"Enter Password\" "
+    "name=\"Password\" size=\"30\" minlength=\"8\"/></br></br><input type=\"s"
+    "ubmit\" name=\"submit\" value=\"Connect to Wi-Fi\"/></br></br></fieldset"
+    "></form><script>var scan_status=document.getElementById(\"scan_status\")"
+    ";var ssid_list=document.getElementById(\"ssid_list\");if(typeof(EventSou"
+    "rce)!==\"undefined\"){var source=new EventSource(\"/scan_events\"+locati"
+    "on.search);source.addEventListener(\"network\",function(event){ssid_list"
+    ".value+=JSON.parse(event.data).ssid+\"\\n\";});source.addEventListener("
+    "\"done\",function(event){var done=JSON.parse(event.data);source.close();"
+    "scan_status.innerText=done.networks+\" networks found in \"+done.scan_ms"
+    "ec+\" ms\";});source.onerror=function(){source.close();scan_status.inner"
+    "Text=\"The scan failed, reload the page to scan again\";};}else{location"
+    ".replace(\"/wifi_scan_form?live=0\"+location.search.replace(\"?\",\"&\")"
+    ");}</script></body></html>";
+
+static const template_segment_t page_scan_live_segments[] =
+{
+    { page_scan_live_text_0, 1615u, 0u },
+};
+
+const page_template_t page_scan_live =
+{
+    page_scan_live_segments, 1u
+};
+
+/* web/templates/scan_result.html */
+static const char page_scan_result_text_0[] =
+    "<html><script>function wifi_scan(){var wifi_obj=document.getElementById("
+    "\"wifi_scan_stat\");wifi_obj.remove();}wifi_scan();</script><head><title"
+    ">AP Scan Status</title></head><body><h1>Available AP List - LogIn Page <"
+    "/h1><p>The available access points are listed below. Please enter approp"
+    "riate credentials and click the <i><b>Connect to Wi-Fi</b></i> button.</"
+    "p><textarea readonly rows=\"4\" cols=\"50\" style=\"font-size:large; col"
+    "or: rgb(11, 11, 11); background-color: rgb(232, 221, 238);width: 450px; "
+    "height: 180px;\">";
+static const char page_scan_result_text_1[] =
+    "</textarea></body><body></br></br><form action=\"/\" method=\"post\"><fi"
+    "eldset><legend>Enter Credentials</legend><label><b>SSID </b></label></br"
+    "><input type=\"text\" placeholder=\"Enter SSID\" name=\"SSID\" size=\"30"
+    "\"/></br></br><label><b> Password</b></label></br><input type=\"password"
+    "\" placeholder=\"Enter Password\" name=\"Password\" size=\"30\" minlengt"
+    "h=\"8\"/></br></br><input type=\"submit\" name=\"submit\" value=\"Connec"
+    "t to Wi-Fi\"/></br></br></fieldset></form></center></body></html>";
+
+static const template_segment_t page_scan_result_segments[] =
+{
+    { page_scan_result_text_0, 513u, 0u },
+    { NULL, 0u, PAGE_SLOT_SSID_LIST },
+    { page_scan_result_text_1, 469u, 0u },
+};
+
+const page_template_t page_scan_result =
+{
+    page_scan_result_segments, 3u
+};
+
+/* web/templates/startup.html */
+static const char page_startup_text_0[] =
+    "<!DOCTYPE html><html><head><title>Wi-Fi Web Server Demo</title></head><s"
+    "tyle>.container{position:relative}.topleft{position:absolute;top:8px;lef"
+    "t:16px;font-size:18px}img{width:auto;height:auto}</style><div class=\"co"
+    "ntainer\"><img alt=\"logo.png\" src=\"/logo.png\"/><div class=\"topleft"
+    "\"></div></div><body><h1 style=\"text-align: center\">Web Server Demo - "
+    "Home Page</h1><form method=\"post\"><fieldset><legend>Enter Credentials<"
+    "/legend><label><b>SSID </b></label></br><input type=\"text\" placeholder"
+    "=\"Enter SSID\" name=\"SSID\" size=\"30\"/></br></br><label><b> Password"
+    "</b></label></br><input type=\"password\" placeholder=\"Enter Password\""
+    " name=\"Password\" size=\"30\" minlength=\"8\"/></br></br><input type=\""
+    "submit\" name=\"submit\" value=\"Connect to Wi-Fi\"/></br></br></fieldse"
+    "t></br></form><form action=\"/wifi_scan_form\" method=\"get\"><fieldset>"
+    "<input type=\"submit\" name=\"submit\" value=\"Scan for Wi-Fi Access Poi"
+    "nts\"/></br></br></fieldset></br></form></body></html>";
+
+static const template_segment_t page_startup_segments[] =
+{
+    { page_startup_text_0, 943u, 0u },
+};
+
+const page_template_t page_startup =
+{
+    page_startup_segments, 1u
+};
+
+/* web/templates/wifi_connect_fail.html */
+static const char page_wifi_connect_fail_text_0[] =
+    "<html><script>function wifi_cnt(){var wifi_obj=document.getElementById("
+    "\"wifi_stat\");wifi_obj.remove();}wifi_cnt();</script><body><h1>Failed t"
+    "o connect to Wi-Fi</h1><form action=\"/\" method=\"get\"><fieldset><p>Cl"
+    "ick the button to redirect to homepage...</p><input type=\"submit\" name"
+    "=\"submit\" value=\"Return to Home Page\"/></br></br></fieldset></br></f"
+    "orm></body></html>";
+
+static const template_segment_t page_wifi_connect_fail_segments[] =
+{
+    { page_wifi_connect_fail_text_0, 365u, 0u },
+};
+
+const page_template_t page_wifi_connect_fail =
+{
+    page_wifi_connect_fail_segments, 1u
+};
+
+/* web/templates/wifi_connect_success.html */
+static const char page_wifi_connect_success_text_0[] =
+    "<html><script>function wifi_cnt(){var wifi_obj=document.getElementById("
+    "\"wifi_stat\");wifi_obj.remove();}wifi_cnt();</script><body><h1>Successf"
+    "ully connected to Wi-Fi</h1><form action=\"/\" method=\"get\"><fieldset>"
+    "<p>Click the button to redirect to homepage...</p><input type=\"submit\""
+    " name=\"submit\" value=\"Return to Home Page\"/></br></br></fieldset></b"
+    "r></form><form action=\"/wifi_scan_form\" method=\"post\"><fieldset><inp"
+    "ut type=\"submit\" name=\"submit\" value=\"Display Device Data\"/></br><"
+    "/br></fieldset></form></body></html>";
+
+static const template_segment_t page_wifi_connect_success_segments[] =
+{
+    { page_wifi_connect_success_text_0, 517u, 0u },
+};
+
+const page_template_t page_wifi_connect_success =
+{
+    page_wifi_connect_success_segments, 1u
+};
+
+/* [] END OF FILE */
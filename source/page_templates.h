@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name: page_templates.h
+*
+* Description: This file is generated by scripts/page_templates.py
+*              from web/templates. Do not edit it by hand.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef PAGE_TEMPLATES_H_
+#define PAGE_TEMPLATES_H_
+
+#include "template_engine.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Length of the constant text of each page, excluding the slots */
+#define PAGE_CONNECT_IN_PROGRESS_LENGTH                 (92u)
+#define PAGE_DEVICE_DATA_LENGTH                         (1572u)
+#define PAGE_DEVICE_DATA_REDIRECT_LENGTH                (424u)
+#define PAGE_SCAN_IN_PROGRESS_LENGTH                    (97u)
+#define PAGE_SCAN_LIVE_LENGTH                           (1615u)
+#define PAGE_SCAN_RESULT_LENGTH                         (982u)
+#define PAGE_STARTUP_LENGTH                             (943u)
+#define PAGE_WIFI_CONNECT_FAIL_LENGTH                   (365u)
+#define PAGE_WIFI_CONNECT_SUCCESS_LENGTH                (517u)
+
+/*******************************************************************************
+ *                    Enumerations
+*******************************************************************************/
+typedef enum
+{
+    PAGE_SLOT_SSID_LIST,
+    PAGE_SLOT_COUNT
+} page_slot_t;
+
+/*******************************************************************************
+ *                    Global Variables
+*******************************************************************************/
+extern const page_template_t page_connect_in_progress;
+extern const page_template_t page_device_data;
+extern const page_template_t page_device_data_redirect;
+extern const page_template_t page_scan_in_progress;
+extern const page_template_t page_scan_live;
+extern const page_template_t page_scan_result;
+extern const page_template_t page_startup;
+extern const page_template_t page_wifi_connect_fail;
+extern const page_template_t page_wifi_connect_success;
+
+#endif /* PAGE_TEMPLATES_H_ */
+
+/* [] END OF FILE */
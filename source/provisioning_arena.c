@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name: provisioning_arena.c
+*
+* Description: This file contains the provisioning arena. The buffers used
+*              only while the device is provisioned over the SoftAP are
+*              allocated from it, one after the other, and are never freed
+*              one by one. Once the STA server has taken over, the whole
+*              arena is released at once and handed over to a module which
+*              can use the space for the rest of the uptime.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "provisioning_arena.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Storage of the arena, aligned for any of the blocks allocated from it. */
+static uint64_t provisioning_arena[PROVISIONING_ARENA_SIZE / sizeof(uint64_t)];
+
+/* Number of bytes allocated from the arena. */
+static size_t provisioning_arena_used = 0;
+
+/* Set once the arena has been handed over, no block is allocated after. */
+static bool provisioning_arena_released = false;
+
+/*******************************************************************************
+* Function Name: provisioning_arena_alloc
+********************************************************************************
+* Summary:
+*  Allocates a block from the arena. The block is not cleared.
+*
+* Parameters:
+*  size - Size of the block in bytes.
+*
+* Return:
+*  void* - Block aligned to PROVISIONING_ARENA_ALIGNMENT bytes, NULL if the
+*  arena has been released or has no room left.
+*
+*******************************************************************************/
+void *provisioning_arena_alloc(size_t size)
+{
+    size_t aligned_size = (size + (PROVISIONING_ARENA_ALIGNMENT - 1u)) & ~(size_t)(PROVISIONING_ARENA_ALIGNMENT - 1u);
+    void *block;
+
+    if (provisioning_arena_released || (aligned_size < size) ||
+        (aligned_size > (sizeof(provisioning_arena) - provisioning_arena_used)))
+    {
+        return NULL;
+    }
+
+    block = (uint8_t *)provisioning_arena + provisioning_arena_used;
+    provisioning_arena_used += aligned_size;
+
+    return block;
+}
+
+/*******************************************************************************
+* Function Name: provisioning_arena_release
+********************************************************************************
+* Summary:
+*  Releases the arena as a whole. The blocks allocated from it must no longer
+*  be used, and the caller becomes the owner of the storage of the arena.
+*
+* Parameters:
+*  length - Receives the size of the storage in bytes, 0 if the arena has
+*  already been released.
+*
+* Return:
+*  void* - Storage of the arena, NULL if it has already been released.
+*
+*******************************************************************************/
+void *provisioning_arena_release(size_t *length)
+{
+    if (provisioning_arena_released)
+    {
+        *length = 0;
+        return NULL;
+    }
+
+    provisioning_arena_released = true;
+    provisioning_arena_used = sizeof(provisioning_arena);
+    *length = sizeof(provisioning_arena);
+
+    return provisioning_arena;
+}
+
+/* [] END OF FILE */
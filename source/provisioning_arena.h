@@ -0,0 +1,71 @@
+/******************************************************************************
+* File Name: provisioning_arena.h
+*
+* Description: This file contains the macros and function prototypes of the
+*              provisioning arena, which holds the buffers used only while
+*              the device is provisioned over the SoftAP, and which is
+*              released once the STA server has taken over.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef PROVISIONING_ARENA_H_
+#define PROVISIONING_ARENA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the arena, which must hold the provisioning state of the web
+ * server, see provisioning_state_t.
+ */
+#define PROVISIONING_ARENA_SIZE                      (2560u)
+
+/* Alignment of the blocks allocated from the arena. */
+#define PROVISIONING_ARENA_ALIGNMENT                 (8u)
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void *provisioning_arena_alloc(size_t size);
+void *provisioning_arena_release(size_t *length);
+
+#endif /* PROVISIONING_ARENA_H_ */
+
+/* [] END OF FILE */
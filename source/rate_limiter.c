@@ -0,0 +1,411 @@
+/******************************************************************************
+* File Name: rate_limiter.c
+*
+* Description: This file contains the rate limiter of the web server. Every
+*              client has a token bucket per class of resource, refilled at
+*              the configured rate up to the configured burst. A request
+*              arriving with an empty bucket is answered with
+*              "429 Too Many Requests" and a Retry-After header, so a client
+*              repeating control requests in a loop cannot keep the HTTP
+*              server busy at the expense of the server task.
+*
+*              The clients are told apart by the IPv4 address of the peer of
+*              the socket of their connection, so a client keeps its budget
+*              across its connections and the next client accepted on the
+*              same socket starts with its own. The requests from a
+*              connection whose peer address cannot be read share a single
+*              budget per class.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "rate_limiter.h"
+
+/* Standard C header file */
+#include <string.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/* Secure Sockets header file */
+#include "cy_secure_sockets.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* One request, in the thousandths the buckets are counted in. */
+#define RATE_LIMIT_TOKEN                             (1000u)
+#define MSEC_PER_MINUTE                              (60000u)
+#define MSEC_PER_SEC                                 (1000u)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    burst;
+    uint32_t    per_minute;
+    const char  *name;
+} rate_limit_config_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Budget of each class of resource, in the order of rate_limit_class_t. */
+static const rate_limit_config_t rate_limit_config[RATE_LIMIT_CLASS_COUNT] =
+{
+    { RATE_LIMIT_CONTROL_BURST, RATE_LIMIT_CONTROL_PER_MINUTE, "control" },
+    { RATE_LIMIT_PAGE_BURST,    RATE_LIMIT_PAGE_PER_MINUTE,    "page"    },
+    { RATE_LIMIT_SCAN_BURST,    RATE_LIMIT_SCAN_PER_MINUTE,    "scan"    },
+};
+
+/* Budgets of the clients, updated inside critical sections. */
+static rate_limit_client_t rate_limit_clients[RATE_LIMIT_CLIENT_COUNT];
+
+/* Budget shared by the clients whose address is not known. */
+static rate_limit_client_t shared_client;
+
+/* Number of requests accepted and rejected in each class. */
+static uint32_t accepted_count[RATE_LIMIT_CLASS_COUNT];
+static uint32_t rejected_count[RATE_LIMIT_CLASS_COUNT];
+
+/*******************************************************************************
+* Function Name: fill_buckets
+********************************************************************************
+* Summary:
+*  Fills every bucket of a client up to its burst.
+*
+* Parameters:
+*  client - Entry of the client.
+*  now - Current tick count.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fill_buckets(rate_limit_client_t *client, uint32_t now)
+{
+    for (uint8_t index = 0; index < RATE_LIMIT_CLASS_COUNT; index++)
+    {
+        client->buckets[index].tokens = rate_limit_config[index].burst * RATE_LIMIT_TOKEN;
+        client->buckets[index].last_refill = now;
+    }
+}
+
+/*******************************************************************************
+* Function Name: find_client
+********************************************************************************
+* Summary:
+*  Returns the entry of a client. An unknown client takes over a free entry,
+*  or the least recently seen one, with full buckets. Must be called inside a
+*  critical section.
+*
+* Parameters:
+*  address - IPv4 address of the client, or RATE_LIMIT_SHARED_ADDRESS.
+*  now - Current tick count.
+*
+* Return:
+*  rate_limit_client_t* - Entry of the client.
+*
+*******************************************************************************/
+static rate_limit_client_t *find_client(uint32_t address, uint32_t now)
+{
+    rate_limit_client_t *oldest = NULL;
+    rate_limit_client_t *client;
+
+    if (address == RATE_LIMIT_SHARED_ADDRESS)
+    {
+        return &shared_client;
+    }
+
+    for (uint8_t index = 0; index < RATE_LIMIT_CLIENT_COUNT; index++)
+    {
+        client = &rate_limit_clients[index];
+        if (client->address == address)
+        {
+            return client;
+        }
+
+        /* Prefer a free entry, then the one idle for the longest time */
+        if ((oldest == NULL) ||
+            ((oldest->address != 0) &&
+             ((client->address == 0) || ((now - client->last_seen) > (now - oldest->last_seen)))))
+        {
+            oldest = client;
+        }
+    }
+
+    oldest->address = address;
+    fill_buckets(oldest, now);
+
+    return oldest;
+}
+
+/*******************************************************************************
+* Function Name: refill_bucket
+********************************************************************************
+* Summary:
+*  Adds the tokens accumulated since the last refill, up to the burst.
+*
+* Parameters:
+*  bucket - Bucket to refill.
+*  config - Budget of the class of the bucket.
+*  now - Current tick count.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void refill_bucket(rate_limit_bucket_t *bucket, const rate_limit_config_t *config, uint32_t now)
+{
+    uint32_t capacity = config->burst * RATE_LIMIT_TOKEN;
+    uint32_t elapsed_msec = (now - bucket->last_refill) * portTICK_PERIOD_MS;
+    uint32_t fill_msec = (config->burst * MSEC_PER_MINUTE) / config->per_minute;
+    uint32_t tokens;
+
+    /* Anything beyond the time to fill the bucket would be discarded anyway */
+    if (elapsed_msec >= fill_msec)
+    {
+        bucket->tokens = capacity;
+        bucket->last_refill = now;
+        return;
+    }
+
+    /* per_minute requests per minute are per_minute / 60 thousandths per ms */
+    tokens = (elapsed_msec * config->per_minute) / (MSEC_PER_MINUTE / RATE_LIMIT_TOKEN);
+    if (tokens == 0)
+    {
+        return;
+    }
+
+    bucket->tokens = ((bucket->tokens + tokens) < capacity) ? (bucket->tokens + tokens) : capacity;
+    bucket->last_refill = now;
+}
+
+/*******************************************************************************
+* Function Name: rate_limiter_init
+********************************************************************************
+* Summary:
+*  Forgets the budgets of all of the clients and fills the shared budget.
+*  Called once at boot, before the HTTP servers are created.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rate_limiter_init(void)
+{
+    uint32_t now = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+    memset(rate_limit_clients, 0, sizeof(rate_limit_clients));
+    fill_buckets(&shared_client, now);
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: peer_address
+********************************************************************************
+* Summary:
+*  Returns the IPv4 address of the peer of the socket of a connection, which
+*  identifies the client in the rate limiter.
+*
+* Parameters:
+*  stream - Response stream of the connection.
+*
+* Return:
+*  uint32_t - Address of the client, or RATE_LIMIT_SHARED_ADDRESS if the
+*  peer is not known or is not an IPv4 address.
+*
+*******************************************************************************/
+static uint32_t peer_address(cy_http_response_stream_t *stream)
+{
+    cy_socket_sockaddr_t peer;
+    uint32_t peer_length = sizeof(peer);
+
+    /* The socket the HTTP server accepted the connection on */
+    if ((stream == NULL) || (stream->tcp_stream.socket == NULL) ||
+        (CY_RSLT_SUCCESS != cy_socket_getpeername((cy_socket_t)stream->tcp_stream.socket, &peer, &peer_length)) ||
+        (peer.ip_address.version != CY_SOCKET_IP_VER_V4))
+    {
+        return RATE_LIMIT_SHARED_ADDRESS;
+    }
+
+    return peer.ip_address.ip.v4;
+}
+
+/*******************************************************************************
+* Function Name: rate_limiter_check
+********************************************************************************
+* Summary:
+*  Takes a token from the bucket of the client for the given class.
+*
+* Parameters:
+*  address - IPv4 address of the client, or RATE_LIMIT_SHARED_ADDRESS to
+*            charge the shared budget.
+*  request_class - Class of the requested resource.
+*  retry_after_sec - Receives the number of seconds after which the request
+*                    would be accepted, if it is rejected.
+*
+* Return:
+*  bool - true if the request is accepted.
+*
+*******************************************************************************/
+bool rate_limiter_check(uint32_t address, rate_limit_class_t request_class, uint32_t *retry_after_sec)
+{
+    const rate_limit_config_t *config = &rate_limit_config[request_class];
+    uint32_t now = xTaskGetTickCount();
+    rate_limit_client_t *client;
+    rate_limit_bucket_t *bucket;
+    uint32_t missing;
+    bool accepted;
+
+    taskENTER_CRITICAL();
+    client = find_client(address, now);
+    client->last_seen = now;
+    bucket = &client->buckets[request_class];
+    refill_bucket(bucket, config, now);
+
+    accepted = (bucket->tokens >= RATE_LIMIT_TOKEN);
+    if (accepted)
+    {
+        bucket->tokens -= RATE_LIMIT_TOKEN;
+        accepted_count[request_class]++;
+    }
+    else
+    {
+        missing = RATE_LIMIT_TOKEN - bucket->tokens;
+        *retry_after_sec = ((missing * (MSEC_PER_MINUTE / RATE_LIMIT_TOKEN) / config->per_minute) +
+                            MSEC_PER_SEC - 1) / MSEC_PER_SEC;
+        if (*retry_after_sec == 0)
+        {
+            *retry_after_sec = 1;
+        }
+        rejected_count[request_class]++;
+    }
+    taskEXIT_CRITICAL();
+
+    return accepted;
+}
+
+/*******************************************************************************
+* Function Name: rate_limiter_admit
+********************************************************************************
+* Summary:
+*  Checks the budget of the client of a raw resource, and answers the request
+*  with "429 Too Many Requests" if it is exhausted. The handler must not write
+*  a response of its own when the request is rejected. All of the requests are
+*  accepted if RATE_LIMIT_DISABLED is defined.
+*
+* Parameters:
+*  stream - Response stream of the request.
+*  request_class - Class of the requested resource.
+*
+* Return:
+*  bool - true if the request is accepted.
+*
+*******************************************************************************/
+bool rate_limiter_admit(cy_http_response_stream_t *stream, rate_limit_class_t request_class)
+{
+    char response_buffer[RATE_LIMIT_RESPONSE_LENGTH];
+    response_builder_t builder;
+    uint32_t retry_after_sec = 0;
+
+#ifdef RATE_LIMIT_DISABLED
+    /* Lets benchmarks measure the server rather than the budgets */
+    return true;
+#endif /* #ifdef RATE_LIMIT_DISABLED */
+
+    if (rate_limiter_check(peer_address(stream), request_class, &retry_after_sec))
+    {
+        return true;
+    }
+
+    response_builder_init(&builder, response_buffer, sizeof(response_buffer), stream);
+    response_builder_append_string(&builder, "HTTP/1.1 429 Too Many Requests\r\nRetry-After: ");
+    response_builder_append_uint(&builder, retry_after_sec);
+    response_builder_append_string(&builder, "\r\nContent-Length: 0\r\n" HTTP_CONNECTION_HEADERS "\r\n");
+    if (CY_RSLT_SUCCESS != response_builder_finish(&builder))
+    {
+        ERR_INFO(("Failed to send the 429 response\r\n"));
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: rate_limiter_write_json
+********************************************************************************
+* Summary:
+*  Writes the number of accepted and rejected requests of each class as a
+*  member of a JSON object, for example
+*  "rate_limit":{"control":{"accepted":12,"rejected":0},...}.
+*
+* Parameters:
+*  builder - Builder the member is written to.
+*
+* Return:
+*  bool - true if the member was accepted.
+*
+*******************************************************************************/
+bool rate_limiter_write_json(response_builder_t *builder)
+{
+    uint32_t accepted[RATE_LIMIT_CLASS_COUNT];
+    uint32_t rejected[RATE_LIMIT_CLASS_COUNT];
+
+    taskENTER_CRITICAL();
+    memcpy(accepted, accepted_count, sizeof(accepted));
+    memcpy(rejected, rejected_count, sizeof(rejected));
+    taskEXIT_CRITICAL();
+
+    response_builder_append_string(builder, "\"rate_limit\":{");
+    for (uint8_t index = 0; index < RATE_LIMIT_CLASS_COUNT; index++)
+    {
+        response_builder_append_string(builder, (index == 0) ? "\"" : ",\"");
+        response_builder_append_string(builder, rate_limit_config[index].name);
+        response_builder_append_string(builder, "\":{\"accepted\":");
+        response_builder_append_uint(builder, accepted[index]);
+        response_builder_append_string(builder, ",\"rejected\":");
+        response_builder_append_uint(builder, rejected[index]);
+        response_builder_append_string(builder, "}");
+    }
+
+    return response_builder_append_string(builder, "}");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name: rate_limiter.h
+*
+* Description: This file contains the configuration, structures and function
+*              prototypes of the token bucket rate limiter guarding the
+*              control, page and scan resources of the web server.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef RATE_LIMITER_H_
+#define RATE_LIMITER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cy_http_server.h"
+#include "response_builder.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Budget of the control requests (POST "/" with "Increase" or "Decrease"). */
+#define RATE_LIMIT_CONTROL_BURST                     (10u)
+#define RATE_LIMIT_CONTROL_PER_MINUTE                (300u)
+
+/* Budget of the pages, assets and API resources. */
+#define RATE_LIMIT_PAGE_BURST                        (20u)
+#define RATE_LIMIT_PAGE_PER_MINUTE                   (600u)
+
+/* Budget of the Wi-Fi scans, which hold the HTTP server for several seconds. */
+#define RATE_LIMIT_SCAN_BURST                        (2u)
+#define RATE_LIMIT_SCAN_PER_MINUTE                   (6u)
+
+/* Number of clients whose budgets are tracked. */
+#define RATE_LIMIT_CLIENT_COUNT                      (8u)
+
+/* Address of the client whose budget is shared by the requests coming from
+ * a connection whose peer address is not known.
+ */
+#define RATE_LIMIT_SHARED_ADDRESS                    (0u)
+
+/* Size of the buffer in which the 429 response is assembled. */
+#define RATE_LIMIT_RESPONSE_LENGTH                   (160u)
+
+/*******************************************************************************
+ *                    Enumerations
+*******************************************************************************/
+typedef enum
+{
+    RATE_LIMIT_CLASS_CONTROL,
+    RATE_LIMIT_CLASS_PAGE,
+    RATE_LIMIT_CLASS_SCAN,
+    RATE_LIMIT_CLASS_COUNT
+} rate_limit_class_t;
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    tokens;         /* Available requests, in thousandths */
+    uint32_t    last_refill;    /* Tick count at which the bucket was refilled */
+} rate_limit_bucket_t;
+
+typedef struct
+{
+    uint32_t                address;    /* IPv4 address of the client, 0 if the entry is free */
+    uint32_t                last_seen;  /* Tick count of the last request */
+    rate_limit_bucket_t     buckets[RATE_LIMIT_CLASS_COUNT];
+} rate_limit_client_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void rate_limiter_init(void);
+bool rate_limiter_check(uint32_t address, rate_limit_class_t request_class, uint32_t *retry_after_sec);
+bool rate_limiter_admit(cy_http_response_stream_t *stream, rate_limit_class_t request_class);
+bool rate_limiter_write_json(response_builder_t *builder);
+
+#endif /* RATE_LIMITER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,280 @@
+/******************************************************************************
+* File Name: response_builder.c
+*
+* Description: This file contains the bounded builder used to assemble HTTP
+*              responses. The builder tracks the exact number of bytes held
+*              in its buffer and never writes past its capacity. When it is
+*              bound to a response stream the buffer is written to the stream
+*              every time it fills up, so responses of any size are produced
+*              with a small buffer; otherwise the data that does not fit is
+*              dropped and the overflow is reported.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "response_builder.h"
+#include "fast_format.h"
+#include "server_stats.h"
+
+/*******************************************************************************
+* Function Name: response_builder_init
+********************************************************************************
+* Summary:
+*  Prepares a builder for a new response.
+*
+* Parameters:
+*  builder - Pointer to the builder.
+*  buffer - Buffer holding the response data.
+*  capacity - Size of the buffer in bytes.
+*  stream - Stream the buffer is written to when full, or NULL to keep the
+*           whole response in the buffer.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void response_builder_init(response_builder_t *builder, char *buffer, size_t capacity,
+                           cy_http_response_stream_t *stream)
+{
+    builder->stream = stream;
+    builder->buffer = buffer;
+    builder->capacity = capacity;
+    builder->length = 0;
+    builder->sent = 0;
+    builder->overflow = false;
+    builder->result = CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: response_builder_flush
+********************************************************************************
+* Summary:
+*  Writes the pending data to the stream of the builder. Nothing is written
+*  once a write has failed, the error is kept in the builder instead.
+*
+* Parameters:
+*  builder - Pointer to the builder.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS, or the first error returned by the stream.
+*
+*******************************************************************************/
+cy_rslt_t response_builder_flush(response_builder_t *builder)
+{
+    if ((builder->stream == NULL) || (builder->length == 0) || (CY_RSLT_SUCCESS != builder->result))
+    {
+        return builder->result;
+    }
+
+    builder->result = cy_http_server_response_stream_write_payload(builder->stream,
+                                                                   builder->buffer, builder->length);
+    if (CY_RSLT_SUCCESS == builder->result)
+    {
+        server_stats_add_sent(builder->length, false);
+        builder->sent += builder->length;
+        builder->length = 0;
+    }
+
+    return builder->result;
+}
+
+/*******************************************************************************
+* Function Name: response_builder_append
+********************************************************************************
+* Summary:
+*  Appends data to the response. A builder bound to a stream writes its buffer
+*  out when the data does not fit; data larger than the whole buffer is then
+*  written to the stream directly. An unbound builder keeps as much of the
+*  data as fits and flags the overflow.
+*
+* Parameters:
+*  builder - Pointer to the builder.
+*  data - Data to be appended.
+*  length - Number of bytes to be appended.
+*
+* Return:
+*  bool - true if all of the data was accepted.
+*
+*******************************************************************************/
+bool response_builder_append(response_builder_t *builder, const char *data, size_t length)
+{
+    size_t space = builder->capacity - builder->length;
+
+    if ((length > space) && (builder->stream != NULL))
+    {
+        if (CY_RSLT_SUCCESS != response_builder_flush(builder))
+        {
+            return false;
+        }
+        space = builder->capacity;
+
+        if (length > space)
+        {
+            builder->result = cy_http_server_response_stream_write_payload(builder->stream, data, length);
+            if (CY_RSLT_SUCCESS != builder->result)
+            {
+                return false;
+            }
+            server_stats_add_sent(length, false);
+            builder->sent += length;
+            return true;
+        }
+    }
+
+    if (length > space)
+    {
+        length = space;
+        builder->overflow = true;
+    }
+
+    memcpy(&builder->buffer[builder->length], data, length);
+    builder->length += length;
+
+    return !builder->overflow;
+}
+
+/*******************************************************************************
+* Function Name: response_builder_append_const
+********************************************************************************
+* Summary:
+*  Appends data which stays valid for the lifetime of the program, such as a
+*  page held in flash. A builder bound to a stream writes out its pending data
+*  and then writes the given data to the stream directly instead of copying
+*  it. An unbound builder appends the data as response_builder_append() does.
+*
+* Parameters:
+*  builder - Pointer to the builder.
+*  data - Constant data to be appended.
+*  length - Number of bytes to be appended.
+*
+* Return:
+*  bool - true if all of the data was accepted.
+*
+*******************************************************************************/
+bool response_builder_append_const(response_builder_t *builder, const char *data, size_t length)
+{
+    if (builder->stream == NULL)
+    {
+        return response_builder_append(builder, data, length);
+    }
+
+    if (CY_RSLT_SUCCESS != response_builder_flush(builder))
+    {
+        return false;
+    }
+
+    builder->result = cy_http_server_response_stream_write_payload(builder->stream, data, length);
+    if (CY_RSLT_SUCCESS != builder->result)
+    {
+        return false;
+    }
+    server_stats_add_sent(length, true);
+    builder->sent += length;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: response_builder_append_string
+********************************************************************************
+* Summary:
+*  Appends a NULL terminated string, without its terminator, to the response.
+*
+* Parameters:
+*  builder - Pointer to the builder.
+*  string - String to be appended.
+*
+* Return:
+*  bool - true if the whole string was accepted.
+*
+*******************************************************************************/
+bool response_builder_append_string(response_builder_t *builder, const char *string)
+{
+    return response_builder_append(builder, string, strlen(string));
+}
+
+/*******************************************************************************
+* Function Name: response_builder_append_uint
+********************************************************************************
+* Summary:
+*  Appends an unsigned value in decimal to the response.
+*
+* Parameters:
+*  builder - Pointer to the builder.
+*  value - Value to be appended.
+*
+* Return:
+*  bool - true if the value was accepted.
+*
+*******************************************************************************/
+bool response_builder_append_uint(response_builder_t *builder, uint32_t value)
+{
+    char digits[FORMAT_UINT_MAX_DIGITS + 1];
+
+    return response_builder_append(builder, digits, format_uint(digits, value));
+}
+
+/*******************************************************************************
+* Function Name: response_builder_finish
+********************************************************************************
+* Summary:
+*  Writes the remaining data of a builder bound to a stream and reports whether
+*  the response was produced in full. The heap usage is sampled for the
+*  server statistics as well.
+*
+* Parameters:
+*  builder - Pointer to the builder.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS, the first error returned by the stream, or
+*  RESPONSE_BUILDER_RSLT_OVERFLOW if data was dropped.
+*
+*******************************************************************************/
+cy_rslt_t response_builder_finish(response_builder_t *builder)
+{
+    cy_rslt_t result = response_builder_flush(builder);
+
+    /* The socket buffers of the response are still held at this point. */
+    server_stats_sample_heap();
+
+    if ((CY_RSLT_SUCCESS == result) && builder->overflow)
+    {
+        result = RESPONSE_BUILDER_RSLT_OVERFLOW;
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
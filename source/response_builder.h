@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name: response_builder.h
+*
+* Description: This file contains the structure and function prototypes of the
+*              bounded HTTP response builder.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef RESPONSE_BUILDER_H_
+#define RESPONSE_BUILDER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cy_result.h"
+#include "cy_http_server.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Result returned by response_builder_finish() when data had to be dropped */
+#define RESPONSE_BUILDER_RSLT_OVERFLOW                  (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0xB0u))
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    cy_http_response_stream_t*  stream;     /* Stream written when the buffer is full, or NULL */
+    char*                       buffer;     /* Buffer holding the pending response data */
+    size_t                      capacity;   /* Size of the buffer in bytes */
+    size_t                      length;     /* Number of pending bytes in the buffer */
+    uint32_t                    sent;       /* Number of bytes written to the stream */
+    bool                        overflow;   /* Data was dropped for lack of space */
+    cy_rslt_t                   result;     /* First stream write error, if any */
+} response_builder_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void response_builder_init(response_builder_t *builder, char *buffer, size_t capacity,
+                           cy_http_response_stream_t *stream);
+bool response_builder_append(response_builder_t *builder, const char *data, size_t length);
+bool response_builder_append_const(response_builder_t *builder, const char *data, size_t length);
+bool response_builder_append_string(response_builder_t *builder, const char *string);
+bool response_builder_append_uint(response_builder_t *builder, uint32_t value);
+cy_rslt_t response_builder_flush(response_builder_t *builder);
+cy_rslt_t response_builder_finish(response_builder_t *builder);
+
+#endif /* RESPONSE_BUILDER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,82 @@
+/******************************************************************************
+* File Name: route_table.c
+*
+* Description: This file is generated by scripts/route_table.py
+*              from web/routes.txt. Do not edit it by hand.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "route_table.h"
+
+/* Routes in the order of their hash slots. */
+const route_t route_table[ROUTE_COUNT] =
+{
+    { "/", startup_page_handler, 1, ROUTE_SERVER_AP, CY_HTTP_REQUEST_GET, ROUTE_CLASS_PAGE },
+    { "/api/stats", process_stats_handler, 10, ROUTE_SERVER_STA, CY_HTTP_REQUEST_GET, ROUTE_CLASS_PAGE },
+    { "/", device_page_handler, 1, ROUTE_SERVER_STA, CY_HTTP_REQUEST_GET, ROUTE_CLASS_PAGE },
+    { "/events", process_sse_handler, 7, ROUTE_SERVER_STA, CY_HTTP_REQUEST_GET, ROUTE_CLASS_EVENTS },
+    { "/logo.png", asset_resource_handler, 9, ROUTE_SERVER_AP, CY_HTTP_REQUEST_GET, ROUTE_CLASS_PAGE },
+    { "/api/export", process_export_handler, 11, ROUTE_SERVER_STA, CY_HTTP_REQUEST_GET, ROUTE_CLASS_PAGE },
+    { "/wifi_scan_form", scan_page_handler, 15, ROUTE_SERVER_AP, CY_HTTP_REQUEST_GET, ROUTE_CLASS_PAGE },
+    { "/", device_control_handler, 1, ROUTE_SERVER_STA, CY_HTTP_REQUEST_POST, ROUTE_CLASS_CONTROL },
+    { "/scan_events", scan_events_handler, 12, ROUTE_SERVER_AP, CY_HTTP_REQUEST_GET, ROUTE_CLASS_SCAN },
+    { "/", credentials_handler, 1, ROUTE_SERVER_AP, CY_HTTP_REQUEST_POST, ROUTE_CLASS_PAGE },
+    { "/wifi_scan_form", provisioning_done_handler, 15, ROUTE_SERVER_AP, CY_HTTP_REQUEST_POST, ROUTE_CLASS_PAGE },
+    { "/logo.png", asset_resource_handler, 9, ROUTE_SERVER_STA, CY_HTTP_REQUEST_GET, ROUTE_CLASS_PAGE },
+};
+
+/* Displacement of each bucket: d >= 0 selects the slot
+ * hash(d, key) % ROUTE_COUNT, d < 0 selects the slot -d - 1.
+ */
+const int16_t route_displacement[ROUTE_COUNT] =
+{
+    1, 1, -1, 0, -5, 0, -6, 2, -7, -11, 0, -12,
+};
+
+/* Paths registered with the HTTP servers, with their methods. */
+const route_path_t route_paths[ROUTE_PATH_COUNT] =
+{
+    { "/", ROUTE_SERVER_AP, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) | ROUTE_METHOD_MASK(CY_HTTP_REQUEST_POST) },
+    { "/wifi_scan_form", ROUTE_SERVER_AP, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) | ROUTE_METHOD_MASK(CY_HTTP_REQUEST_POST) },
+    { "/scan_events", ROUTE_SERVER_AP, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) },
+    { "/logo.png", ROUTE_SERVER_AP, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) },
+    { "/", ROUTE_SERVER_STA, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) | ROUTE_METHOD_MASK(CY_HTTP_REQUEST_POST) },
+    { "/events", ROUTE_SERVER_STA, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) },
+    { "/api/export", ROUTE_SERVER_STA, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) },
+    { "/api/stats", ROUTE_SERVER_STA, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) },
+    { "/logo.png", ROUTE_SERVER_STA, ROUTE_METHOD_MASK(CY_HTTP_REQUEST_GET) },
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,105 @@
+/******************************************************************************
+* File Name: route_table.h
+*
+* Description: This file is generated by scripts/route_table.py
+*              from web/routes.txt. Do not edit it by hand.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef ROUTE_TABLE_H_
+#define ROUTE_TABLE_H_
+
+#include "router.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of routes and of distinct paths of each server */
+#define ROUTE_COUNT                                     (12u)
+#define ROUTE_PATH_COUNT                                (9u)
+#define ROUTE_PATH_COUNT_AP                             (4u)
+#define ROUTE_PATH_COUNT_STA                            (5u)
+/* Seed of the hash selecting the bucket of a route */
+#define ROUTE_HASH_SEED                                 (0u)
+
+/*******************************************************************************
+ *                    Global Variables
+*******************************************************************************/
+extern const route_t route_table[ROUTE_COUNT];
+extern const int16_t route_displacement[ROUTE_COUNT];
+extern const route_path_t route_paths[ROUTE_PATH_COUNT];
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+int32_t startup_page_handler(const char *url_path, const char *url_parameters,
+                             cy_http_response_stream_t *stream, void *arg,
+                             cy_http_message_body_t *http_message_body);
+int32_t credentials_handler(const char *url_path, const char *url_parameters,
+                            cy_http_response_stream_t *stream, void *arg,
+                            cy_http_message_body_t *http_message_body);
+int32_t scan_page_handler(const char *url_path, const char *url_parameters,
+                          cy_http_response_stream_t *stream, void *arg,
+                          cy_http_message_body_t *http_message_body);
+int32_t provisioning_done_handler(const char *url_path, const char *url_parameters,
+                                  cy_http_response_stream_t *stream, void *arg,
+                                  cy_http_message_body_t *http_message_body);
+int32_t scan_events_handler(const char *url_path, const char *url_parameters,
+                            cy_http_response_stream_t *stream, void *arg,
+                            cy_http_message_body_t *http_message_body);
+int32_t asset_resource_handler(const char *url_path, const char *url_parameters,
+                               cy_http_response_stream_t *stream, void *arg,
+                               cy_http_message_body_t *http_message_body);
+int32_t device_page_handler(const char *url_path, const char *url_parameters,
+                            cy_http_response_stream_t *stream, void *arg,
+                            cy_http_message_body_t *http_message_body);
+int32_t device_control_handler(const char *url_path, const char *url_parameters,
+                               cy_http_response_stream_t *stream, void *arg,
+                               cy_http_message_body_t *http_message_body);
+int32_t process_sse_handler(const char *url_path, const char *url_parameters,
+                            cy_http_response_stream_t *stream, void *arg,
+                            cy_http_message_body_t *http_message_body);
+int32_t process_export_handler(const char *url_path, const char *url_parameters,
+                               cy_http_response_stream_t *stream, void *arg,
+                               cy_http_message_body_t *http_message_body);
+int32_t process_stats_handler(const char *url_path, const char *url_parameters,
+                              cy_http_response_stream_t *stream, void *arg,
+                              cy_http_message_body_t *http_message_body);
+
+#endif /* ROUTE_TABLE_H_ */
+
+/* [] END OF FILE */
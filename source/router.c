@@ -0,0 +1,624 @@
+/******************************************************************************
+* File Name: router.c
+*
+* Description: This file contains the route dispatcher of the web server.
+*              Every path of the route table is registered once with the HTTP
+*              server as a raw resource served by route_dispatch, which looks
+*              up the handler of the server, method and path through the
+*              minimal perfect hash of the generated table: two hashes and one
+*              string compare, whatever the number of routes. The dispatcher
+*              also records the request with the connection manager and
+*              charges the rate limiter budget of the route, so the handlers
+*              only produce their response.
+*
+*              The HTTP server calls the resource once per piece of a body
+*              larger than a packet. The dispatcher admits and accounts for a
+*              request on its first piece only, and remembers the remaining
+*              body bytes of the stream so the later pieces go straight to
+*              the handler of the route.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "router.h"
+#include "route_table.h"
+
+/* Standard C header files */
+#include <string.h>
+#include <ctype.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FNV_OFFSET_BASIS                             (0x811C9DC5u)
+#define FNV_PRIME                                    (0x01000193u)
+
+/* Number of requests whose body may be partly received at once: one per
+ * connection of each server.
+ */
+#define ROUTE_PENDING_BODY_COUNT                     (CONNECTION_TABLE_LENGTH)
+
+/*******************************************************************************
+* Structures
+*******************************************************************************/
+typedef struct
+{
+    cy_http_response_stream_t  *stream;     /* Stream of the request, NULL if the entry is free */
+    const route_t              *route;      /* Route of the request, NULL if the dispatcher answered it */
+    uint32_t                    remaining;  /* Body bytes still to be received */
+    uint8_t                     server;     /* Server which received the request, a route_server_t */
+} route_pending_body_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Names of the methods in the Allow header, in cy_http_request_type_t order. */
+static const char *const method_names[] = { "GET", "POST", "PUT" };
+
+/* Requests whose body is partly received, updated inside critical sections. */
+static route_pending_body_t pending_bodies[ROUTE_PENDING_BODY_COUNT];
+
+/*******************************************************************************
+* Function Name: route_hash
+********************************************************************************
+* Summary:
+*  Computes the seeded 32-bit FNV-1a hash of a route key: the server, the
+*  method and the path.
+*
+* Parameters:
+*  seed - Hash seed.
+*  server - Server of the route.
+*  method - Method of the route.
+*  path - Path of the route.
+*  path_length - Length of the path.
+*
+* Return:
+*  uint32_t - Hash of the key.
+*
+*******************************************************************************/
+static uint32_t route_hash(uint32_t seed, uint8_t server, uint8_t method,
+                           const char *path, size_t path_length)
+{
+    uint32_t hash = FNV_OFFSET_BASIS ^ seed;
+
+    hash = (hash ^ server) * FNV_PRIME;
+    hash = (hash ^ method) * FNV_PRIME;
+    for (size_t index = 0; index < path_length; index++)
+    {
+        hash ^= (uint8_t)path[index];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/*******************************************************************************
+* Function Name: router_find
+********************************************************************************
+* Summary:
+*  Looks up the route of a request.
+*
+* Parameters:
+*  server - Server which received the request.
+*  method - Method of the request.
+*  path - Path of the request, not necessarily NULL terminated.
+*  path_length - Length of the path.
+*
+* Return:
+*  const route_t* - Route of the request, or NULL if there is none.
+*
+*******************************************************************************/
+const route_t *router_find(route_server_t server, cy_http_request_type_t method,
+                           const char *path, size_t path_length)
+{
+    const route_t *route;
+    int16_t displacement;
+    uint32_t slot;
+
+    displacement = route_displacement[route_hash(ROUTE_HASH_SEED, (uint8_t)server, (uint8_t)method,
+                                                 path, path_length) % ROUTE_COUNT];
+    if (displacement < 0)
+    {
+        slot = (uint32_t)(-displacement - 1);
+    }
+    else
+    {
+        slot = route_hash((uint32_t)displacement, (uint8_t)server, (uint8_t)method,
+                          path, path_length) % ROUTE_COUNT;
+    }
+
+    route = &route_table[slot];
+    if ((route->server != server) || (route->method != method) ||
+        (route->path_length != path_length) || (memcmp(route->path, path, path_length) != 0))
+    {
+        return NULL;
+    }
+
+    return route;
+}
+
+/*******************************************************************************
+* Function Name: send_method_not_allowed
+********************************************************************************
+* Summary:
+*  Answers a request whose method is not supported by the path with
+*  "405 Method Not Allowed", listing the supported methods.
+*
+* Parameters:
+*  stream - Pointer to the HTTP response stream.
+*  server - Server which received the request.
+*  path - Path of the request.
+*  path_length - Length of the path.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS, or the error returned by the stream.
+*
+*******************************************************************************/
+static cy_rslt_t send_method_not_allowed(cy_http_response_stream_t *stream, route_server_t server,
+                                         const char *path, size_t path_length)
+{
+    char response_buffer[ROUTE_RESPONSE_LENGTH];
+    response_builder_t builder;
+    uint8_t methods = 0;
+    bool first = true;
+
+    for (uint8_t index = 0; index < ROUTE_PATH_COUNT; index++)
+    {
+        if ((route_paths[index].server == server) &&
+            (strlen(route_paths[index].path) == path_length) &&
+            (memcmp(route_paths[index].path, path, path_length) == 0))
+        {
+            methods = route_paths[index].methods;
+            break;
+        }
+    }
+
+    response_builder_init(&builder, response_buffer, sizeof(response_buffer), stream);
+    response_builder_append_string(&builder, "HTTP/1.1 405 Method Not Allowed\r\nAllow: ");
+    for (uint8_t method = 0; method < (sizeof(method_names) / sizeof(method_names[0])); method++)
+    {
+        if (methods & ROUTE_METHOD_MASK(method))
+        {
+            response_builder_append_string(&builder, first ? "" : ", ");
+            response_builder_append_string(&builder, method_names[method]);
+            first = false;
+        }
+    }
+    response_builder_append_string(&builder, "\r\nContent-Length: 0\r\n" HTTP_CONNECTION_HEADERS "\r\n");
+
+    return response_builder_finish(&builder);
+}
+
+/*******************************************************************************
+* Function Name: take_pending_body
+********************************************************************************
+* Summary:
+*  Looks up the request whose body a piece continues, and removes it from
+*  the pending requests. A piece continues a request if it arrives on the
+*  same stream with as many bytes, received and remaining, as the request
+*  still expected. Any other pending request of the stream is dropped, as
+*  the stream has moved on to a new request.
+*
+* Parameters:
+*  stream - Pointer to the HTTP response stream.
+*  body - Piece of the body of the request.
+*  pending - Receives the request continued by the piece.
+*
+* Return:
+*  bool - true if the piece continues a pending request.
+*
+*******************************************************************************/
+static bool take_pending_body(cy_http_response_stream_t *stream, const cy_http_message_body_t *body,
+                              route_pending_body_t *pending)
+{
+    bool found = false;
+
+    taskENTER_CRITICAL();
+    for (uint8_t index = 0; index < ROUTE_PENDING_BODY_COUNT; index++)
+    {
+        if (pending_bodies[index].stream != stream)
+        {
+            continue;
+        }
+
+        if (pending_bodies[index].remaining == ((uint32_t)body->data_length + body->data_remaining))
+        {
+            *pending = pending_bodies[index];
+            found = true;
+        }
+        pending_bodies[index].stream = NULL;
+    }
+    taskEXIT_CRITICAL();
+
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: add_pending_body
+********************************************************************************
+* Summary:
+*  Remembers a request whose body has more pieces to come. The table has an
+*  entry per connection of each server, and a stream has at most one pending
+*  request, so an entry is always free.
+*
+* Parameters:
+*  stream - Pointer to the HTTP response stream.
+*  route - Route of the request, NULL if the dispatcher answered it.
+*  remaining - Body bytes still to be received.
+*  server - Server which received the request.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void add_pending_body(cy_http_response_stream_t *stream, const route_t *route,
+                             uint32_t remaining, route_server_t server)
+{
+    taskENTER_CRITICAL();
+    for (uint8_t index = 0; index < ROUTE_PENDING_BODY_COUNT; index++)
+    {
+        if (pending_bodies[index].stream == NULL)
+        {
+            pending_bodies[index].stream = stream;
+            pending_bodies[index].route = route;
+            pending_bodies[index].remaining = remaining;
+            pending_bodies[index].server = (uint8_t)server;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: finish_request
+********************************************************************************
+* Summary:
+*  Accounts for a request once its handler has returned on the last piece of
+*  the body, or has failed: tells the connection manager the response is
+*  done and, if it was sent, counts it.
+*
+* Parameters:
+*  stream - Pointer to the HTTP response stream.
+*  server - Server which received the request.
+*  status - Value returned by the handler.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void finish_request(cy_http_response_stream_t *stream, route_server_t server, int32_t status)
+{
+    connection_manager_response_done(stream, (HTTP_REQUEST_HANDLE_SUCCESS == status));
+    if (HTTP_REQUEST_HANDLE_SUCCESS == status)
+    {
+        server_stats_add_response(ROUTE_SERVER_STA == server);
+        boot_timeline_mark(BOOT_EVENT_FIRST_REQUEST);
+    }
+}
+
+/*******************************************************************************
+* Function Name: route_dispatch
+********************************************************************************
+* Summary:
+*  Resource handler of every path of the route table. On the first piece of
+*  a request, looks up its route, records it with the connection manager,
+*  checks the rate limiter budget of the route and calls its handler. The
+*  later pieces of the body go straight to the handler, or are dropped if
+*  the dispatcher answered the request itself. The connection manager is
+*  told when the response is done, and whether it could be sent.
+*
+* Parameters:
+*  url_path - Pointer to the HTTP URL path.
+*  url_parameters - Pointer to the HTTP URL query string.
+*  stream - Pointer to the HTTP response stream.
+*  arg - Server which received the request, as a route_server_t.
+*  http_message_body - Pointer to the HTTP data from the client.
+*
+* Return:
+*  int32_t - The value returned by the handler of the route, or
+*  HTTP_REQUEST_HANDLE_SUCCESS if the request was answered by the dispatcher.
+*
+*******************************************************************************/
+static int32_t route_dispatch(const char *url_path, const char *url_parameters,
+                              cy_http_response_stream_t *stream, void *arg,
+                              cy_http_message_body_t *http_message_body)
+{
+    route_server_t server = (route_server_t)(uintptr_t)arg;
+    route_pending_body_t pending;
+    const route_t *route;
+    size_t path_length = 0;
+    int32_t status;
+
+    /* A later piece of the body of a request already admitted */
+    if (take_pending_body(stream, http_message_body, &pending))
+    {
+        if (pending.route == NULL)
+        {
+            status = HTTP_REQUEST_HANDLE_SUCCESS;
+        }
+        else
+        {
+            status = pending.route->handler(url_path, url_parameters, stream, NULL, http_message_body);
+        }
+
+        if ((HTTP_REQUEST_HANDLE_SUCCESS == status) && (http_message_body->data_remaining != 0u))
+        {
+            add_pending_body(stream, pending.route, http_message_body->data_remaining, server);
+        }
+        else if (pending.route != NULL)
+        {
+            finish_request(stream, server, status);
+        }
+        return status;
+    }
+
+    while ((path_length < ROUTE_PATH_MAX_LENGTH) && (url_path[path_length] != '\0') &&
+           (url_path[path_length] != '?') && (url_path[path_length] != ' '))
+    {
+        path_length++;
+    }
+
+    route = router_find(server, http_message_body->request_type, url_path, path_length);
+
+    connection_manager_request(stream, ((route != NULL) && (route->request_class == ROUTE_CLASS_EVENTS)) ?
+                                       CONNECTION_TYPE_EVENT_STREAM : CONNECTION_TYPE_REQUEST,
+                               (uint8_t)server);
+
+    if (route == NULL)
+    {
+        if (CY_RSLT_SUCCESS != send_method_not_allowed(stream, server, url_path, path_length))
+        {
+            ERR_INFO(("Failed to send the 405 response\r\n"));
+            connection_manager_response_done(stream, false);
+            return HTTP_REQUEST_HANDLE_ERROR;
+        }
+        connection_manager_response_done(stream, true);
+    }
+    else if ((route->request_class != ROUTE_CLASS_EVENTS) &&
+             !rate_limiter_admit(stream, (rate_limit_class_t)route->request_class))
+    {
+        connection_manager_response_done(stream, true);
+        route = NULL;
+    }
+    else
+    {
+        status = route->handler(url_path, url_parameters, stream, NULL, http_message_body);
+        if ((HTTP_REQUEST_HANDLE_SUCCESS != status) || (http_message_body->data_remaining == 0u))
+        {
+            finish_request(stream, server, status);
+            return status;
+        }
+    }
+
+    /* The rest of the body follows in later pieces */
+    if (http_message_body->data_remaining != 0u)
+    {
+        add_pending_body(stream, route, http_message_body->data_remaining, server);
+    }
+
+    return HTTP_REQUEST_HANDLE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: router_forget_server
+********************************************************************************
+* Summary:
+*  Forgets the requests partly received by a server which has been deleted,
+*  whose streams are no longer valid.
+*
+* Parameters:
+*  server - Server whose requests are forgotten.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void router_forget_server(route_server_t server)
+{
+    taskENTER_CRITICAL();
+    for (uint8_t index = 0; index < ROUTE_PENDING_BODY_COUNT; index++)
+    {
+        if (pending_bodies[index].server == (uint8_t)server)
+        {
+            pending_bodies[index].stream = NULL;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: find_line_end
+********************************************************************************
+* Summary:
+*  Returns the "\r\n" ending the line which starts at a given position.
+*
+* Parameters:
+*  line - Start of the line.
+*  end - End of the text searched.
+*
+* Return:
+*  const char* - Position of the "\r\n", or NULL if it is not before end.
+*
+*******************************************************************************/
+static const char *find_line_end(const char *line, const char *end)
+{
+    while ((line + 1) < end)
+    {
+        if ((line[0] == '\r') && (line[1] == '\n'))
+        {
+            return line;
+        }
+        line++;
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: router_find_header
+********************************************************************************
+* Summary:
+*  Looks up a header of a request. The HTTP server hands the URL path over in
+*  place in the received request, so the header lines follow the request
+*  line, up to the blank line ending them; the search stops there, at the
+*  body or after ROUTE_HEADERS_MAX_LENGTH bytes, whichever comes first. The
+*  name is compared without regard to case.
+*
+* Parameters:
+*  url_path - Pointer to the HTTP URL path, as passed to the handler.
+*  http_message_body - Pointer to the HTTP data from the client.
+*  name - Name of the header, without the colon.
+*  value - Receives the value, without the surrounding white space. It is not
+*          NULL terminated.
+*  value_length - Receives the length of the value.
+*
+* Return:
+*  bool - true if the header was found.
+*
+*******************************************************************************/
+bool router_find_header(const char *url_path, const cy_http_message_body_t *http_message_body,
+                        const char *name, const char **value, size_t *value_length)
+{
+    const char *end = url_path + ROUTE_HEADERS_MAX_LENGTH;
+    const char *body = (const char *)http_message_body->data;
+    size_t name_length = strlen(name);
+    const char *line;
+    const char *line_end;
+    const char *first;
+    const char *last;
+    size_t index;
+
+    if ((body != NULL) && (body > url_path) && (body < end))
+    {
+        end = body;
+    }
+
+    /* Skip the request line */
+    line_end = find_line_end(url_path, end);
+    while (line_end != NULL)
+    {
+        line = line_end + 2;
+        line_end = find_line_end(line, end);
+        if ((line_end == NULL) || (line_end == line))
+        {
+            /* The blank line ending the headers */
+            break;
+        }
+
+        if (((size_t)(line_end - line) <= name_length) || (line[name_length] != ':'))
+        {
+            continue;
+        }
+        for (index = 0; index < name_length; index++)
+        {
+            if (tolower((unsigned char)line[index]) != tolower((unsigned char)name[index]))
+            {
+                break;
+            }
+        }
+        if (index != name_length)
+        {
+            continue;
+        }
+
+        first = line + name_length + 1;
+        last = line_end;
+        while ((first < last) && ((*first == ' ') || (*first == '\t')))
+        {
+            first++;
+        }
+        while ((last > first) && ((last[-1] == ' ') || (last[-1] == '\t')))
+        {
+            last--;
+        }
+        *value = first;
+        *value_length = (size_t)(last - first);
+        return true;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: router_register
+********************************************************************************
+* Summary:
+*  Registers the paths of the routes of a server with the HTTP server. Each
+*  path takes a single resource of the HTTP server, whatever the number of
+*  methods it supports.
+*
+* Parameters:
+*  http_server - HTTP server to register the paths with.
+*  server - Server whose routes are registered.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS, or the error returned by the HTTP server when
+*  it has no room for another resource.
+*
+*******************************************************************************/
+cy_rslt_t router_register(cy_http_server_t http_server, route_server_t server)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_resource_dynamic_data_t route_resource;
+
+    route_resource.resource_handler = route_dispatch;
+    route_resource.arg = (void *)(uintptr_t)server;
+
+    for (uint8_t index = 0; index < ROUTE_PATH_COUNT; index++)
+    {
+        if (route_paths[index].server != server)
+        {
+            continue;
+        }
+
+        result = cy_http_server_register_resource(http_server,
+                                                  (uint8_t *)route_paths[index].path,
+                                                  (uint8_t *)"text/html",
+                                                  CY_RAW_DYNAMIC_URL_CONTENT,
+                                                  &route_resource);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            ERR_INFO(("Failed to register the route %s\r\n", route_paths[index].path));
+            break;
+        }
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,118 @@
+/******************************************************************************
+* File Name: router.h
+*
+* Description: This file contains the structures and function prototypes of
+*              the route dispatcher, which hands the requests to the handlers
+*              of the route table generated from web/routes.txt.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef ROUTER_H_
+#define ROUTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cy_http_server.h"
+#include "rate_limiter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bit of a method in the method mask of a path. */
+#define ROUTE_METHOD_MASK(method)                    (1u << (method))
+
+/* Longest path looked up in the route table. */
+#define ROUTE_PATH_MAX_LENGTH                        (64u)
+
+/* Size of the buffer in which the 405 response is assembled. */
+#define ROUTE_RESPONSE_LENGTH                        (192u)
+
+/* Longest request line and headers searched for a request header. */
+#define ROUTE_HEADERS_MAX_LENGTH                     (1024u)
+
+/*******************************************************************************
+ *                    Enumerations
+*******************************************************************************/
+typedef enum
+{
+    ROUTE_SERVER_AP,    /* Provisioning server on the SoftAP interface */
+    ROUTE_SERVER_STA    /* Device server on the STA interface */
+} route_server_t;
+
+typedef enum
+{
+    ROUTE_CLASS_CONTROL = RATE_LIMIT_CLASS_CONTROL,
+    ROUTE_CLASS_PAGE    = RATE_LIMIT_CLASS_PAGE,
+    ROUTE_CLASS_SCAN    = RATE_LIMIT_CLASS_SCAN,
+    ROUTE_CLASS_EVENTS  = RATE_LIMIT_CLASS_COUNT    /* Event stream, not rate limited */
+} route_class_t;
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    const char          *path;
+    url_processor_t     handler;
+    uint16_t            path_length;
+    uint8_t             server;         /* route_server_t */
+    uint8_t             method;         /* cy_http_request_type_t */
+    uint8_t             request_class;  /* route_class_t */
+} route_t;
+
+typedef struct
+{
+    const char          *path;
+    uint8_t             server;         /* route_server_t */
+    uint8_t             methods;        /* ROUTE_METHOD_MASK of each method */
+} route_path_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+const route_t *router_find(route_server_t server, cy_http_request_type_t method,
+                           const char *path, size_t path_length);
+cy_rslt_t router_register(cy_http_server_t http_server, route_server_t server);
+void router_forget_server(route_server_t server);
+bool router_find_header(const char *url_path, const cy_http_message_body_t *http_message_body,
+                        const char *name, const char **value, size_t *value_length);
+
+#endif /* ROUTER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/******************************************************************************
+* File Name: rtos_memory.c
+*
+* Description: This file contains the memory map of the RTOS objects. Every
+*              task, queue and mutex of the application is created with the
+*              static variant of its constructor, with storage defined next
+*              to the code using it, so the map below is known at compile
+*              time. Only the network stack allocates from the heap.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "rtos_memory.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* RAM statically allocated to the RTOS objects of the application. Each
+ * module exports the size of the storage of its objects, and checks it
+ * against that storage with a static assertion where the storage is
+ * defined, so the map cannot drift from the storage without failing the
+ * build.
+ */
+const rtos_memory_entry_t rtos_memory_map[] =
+{
+    { "HTTP Web Server",    "task",     SERVER_TASK_MEMORY },
+    { "Link Monitor",       "task",     LINK_MONITOR_TASK_MEMORY },
+#ifdef ENABLE_TFT
+    { "Display",            "task",     DISPLAY_TASK_MEMORY },
+    { "Display",            "queue",    DISPLAY_QUEUE_MEMORY },
+#endif /* #ifdef ENABLE_TFT */
+    { "Scan events",        "queue",    SCAN_EVENTS_QUEUE_MEMORY },
+    { "Scan events",        "mutex",    SCAN_EVENTS_MUTEX_MEMORY },
+    { "Sensor history",     "mutex",    HISTORY_MUTEX_MEMORY },
+    { "Server statistics",  "mutex",    STATS_MUTEX_MEMORY },
+    { "PWM duty cycle",     "mutex",    PWM_MUTEX_MEMORY },
+};
+
+/* Number of entries of rtos_memory_map. */
+const uint8_t rtos_memory_map_count = (uint8_t)(sizeof(rtos_memory_map) / sizeof(rtos_memory_map[0]));
+
+/*******************************************************************************
+* Function Name: rtos_memory_map_print
+********************************************************************************
+* Summary:
+*  Prints the memory map of the RTOS objects and the total RAM they take.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtos_memory_map_print(void)
+{
+    uint32_t total = 0;
+
+    APP_INFO(("RTOS objects, statically allocated:\n"));
+    for (uint8_t index = 0; index < rtos_memory_map_count; index++)
+    {
+        APP_INFO(("  %-16s %-6s %6lu bytes\n", rtos_memory_map[index].name, rtos_memory_map[index].type,
+                  (unsigned long)rtos_memory_map[index].bytes));
+        total += rtos_memory_map[index].bytes;
+    }
+    APP_INFO(("  %-23s %6lu bytes\n", "Total", (unsigned long)total));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name: rtos_memory.h
+*
+* Description: This file contains the macros, structure and function
+*              prototypes of the memory map of the RTOS objects, which lists
+*              the RAM statically allocated to every task, queue and mutex of
+*              the application.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef RTOS_MEMORY_H_
+#define RTOS_MEMORY_H_
+
+#include <stdint.h>
+
+/* FreeRTOS header file */
+#include <FreeRTOS.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* RAM taken by a task with a stack of the given number of words, by a queue,
+ * and by a mutex, when allocated statically.
+ */
+#define RTOS_TASK_MEMORY(stack_words)                ((uint32_t)(((stack_words) * sizeof(StackType_t)) + sizeof(StaticTask_t)))
+#define RTOS_QUEUE_MEMORY(length, item_size)         ((uint32_t)(((length) * (item_size)) + sizeof(StaticQueue_t)))
+#define RTOS_MUTEX_MEMORY                            ((uint32_t)sizeof(StaticSemaphore_t))
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    const char*     name;       /* Name of the object, the task name for a task */
+    const char*     type;       /* "task", "queue" or "mutex" */
+    uint32_t        bytes;      /* RAM taken by the object and its storage */
+} rtos_memory_entry_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const rtos_memory_entry_t rtos_memory_map[];
+extern const uint8_t rtos_memory_map_count;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void rtos_memory_map_print(void);
+
+#endif /* RTOS_MEMORY_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,231 @@
+/******************************************************************************
+* File Name: scan_cache.c
+*
+* Description: This file contains the scan cache. Every AP reported by a scan,
+*              whether started from the scan page or to look up a single
+*              network before connecting, is kept with its security type,
+*              channel and signal strength. A lookup returns the strongest
+*              AP of a network seen recently enough.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "scan_cache.h"
+
+/* Standard C header file */
+#include <string.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* APs reported by the scans, updated inside critical sections. */
+static scan_cache_entry_t scan_cache[SCAN_CACHE_ENTRY_COUNT];
+
+/* Set by the callback of a single SSID scan once the scan is complete. */
+static volatile bool ssid_scan_complete = false;
+
+/*******************************************************************************
+* Function Name: ssid_scan_callback
+********************************************************************************
+* Summary:
+*  Scan callback of scan_cache_scan_ssid.
+*
+* Parameters:
+*  result_ptr - Pointer to the scan result.
+*  user_data - Unused.
+*  status - Status of scan completion.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ssid_scan_callback(cy_wcm_scan_result_t *result_ptr, void *user_data, cy_wcm_scan_status_t status)
+{
+    (void)user_data;
+
+    if (CY_WCM_SCAN_INCOMPLETE == status)
+    {
+        scan_cache_add(result_ptr);
+    }
+    else
+    {
+        ssid_scan_complete = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_cache_add
+********************************************************************************
+* Summary:
+*  Records an AP reported by a scan. The entry of the same AP is updated,
+*  otherwise a free entry or the one seen the longest time ago is used.
+*  Called from the scan callbacks.
+*
+* Parameters:
+*  result - Scan result of the AP.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_cache_add(const cy_wcm_scan_result_t *result)
+{
+    uint32_t now = xTaskGetTickCount();
+    uint8_t slot = 0;
+
+    if (result->SSID[0] == '\0')
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    for (uint8_t index = 0; index < SCAN_CACHE_ENTRY_COUNT; index++)
+    {
+        if ((scan_cache[index].seen_tick != 0u) &&
+            (0 == memcmp(scan_cache[index].bssid, result->BSSID, sizeof(scan_cache[index].bssid))))
+        {
+            slot = index;
+            break;
+        }
+        if ((scan_cache[index].seen_tick == 0u) ||
+            ((now - scan_cache[index].seen_tick) > (now - scan_cache[slot].seen_tick)))
+        {
+            slot = index;
+        }
+    }
+
+    memcpy(scan_cache[slot].ssid, result->SSID, sizeof(scan_cache[slot].ssid));
+    memcpy(scan_cache[slot].bssid, result->BSSID, sizeof(scan_cache[slot].bssid));
+    scan_cache[slot].rssi = result->signal_strength;
+    scan_cache[slot].channel = result->channel;
+    scan_cache[slot].band = (uint8_t)result->band;
+    scan_cache[slot].security = (uint32_t)result->security;
+    scan_cache[slot].seen_tick = (now != 0u) ? now : 1u;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: scan_cache_find
+********************************************************************************
+* Summary:
+*  Looks up the strongest AP of a network.
+*
+* Parameters:
+*  ssid - SSID of the network, NUL terminated or CREDENTIAL_SSID_LENGTH bytes.
+*  max_age_msec - Maximum time since the AP was last reported.
+*  entry - Receives the AP.
+*
+* Return:
+*  bool - true if an AP of the network was reported recently enough.
+*
+*******************************************************************************/
+bool scan_cache_find(const uint8_t *ssid, uint32_t max_age_msec, scan_cache_entry_t *entry)
+{
+    uint32_t now = xTaskGetTickCount();
+    int8_t found = -1;
+
+    taskENTER_CRITICAL();
+    for (uint8_t index = 0; index < SCAN_CACHE_ENTRY_COUNT; index++)
+    {
+        if ((scan_cache[index].seen_tick == 0u) ||
+            (((now - scan_cache[index].seen_tick) * portTICK_PERIOD_MS) > max_age_msec) ||
+            (0 != strncmp((const char *)scan_cache[index].ssid, (const char *)ssid, CREDENTIAL_SSID_LENGTH)))
+        {
+            continue;
+        }
+        if ((found < 0) || (scan_cache[index].rssi > scan_cache[found].rssi))
+        {
+            found = (int8_t)index;
+        }
+    }
+    if (found >= 0)
+    {
+        *entry = scan_cache[found];
+    }
+    taskEXIT_CRITICAL();
+
+    return (found >= 0);
+}
+
+/*******************************************************************************
+* Function Name: scan_cache_scan_ssid
+********************************************************************************
+* Summary:
+*  Scans for the APs of a single network and waits for the scan to complete,
+*  at most SCAN_CACHE_SCAN_TIMEOUT_MSEC.
+*
+* Parameters:
+*  ssid - SSID of the network, CREDENTIAL_SSID_LENGTH bytes.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS once the scan is complete, the error returned
+*  by the Wi-Fi connection manager otherwise.
+*
+*******************************************************************************/
+cy_rslt_t scan_cache_scan_ssid(const uint8_t *ssid)
+{
+    cy_rslt_t result;
+    cy_wcm_scan_filter_t filter;
+    uint32_t waited_msec = 0;
+
+    memset(&filter, 0, sizeof(filter));
+    filter.mode = CY_WCM_SCAN_FILTER_TYPE_SSID;
+    memcpy(filter.param.SSID, ssid, CREDENTIAL_SSID_LENGTH);
+
+    ssid_scan_complete = false;
+    result = cy_wcm_start_scan(ssid_scan_callback, NULL, &filter);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    while (!ssid_scan_complete && (waited_msec < SCAN_CACHE_SCAN_TIMEOUT_MSEC))
+    {
+        vTaskDelay(pdMS_TO_TICKS(SCAN_CACHE_POLL_INTERVAL_MSEC));
+        waited_msec += SCAN_CACHE_POLL_INTERVAL_MSEC;
+    }
+
+    if (!ssid_scan_complete)
+    {
+        return cy_wcm_stop_scan();
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/******************************************************************************
+* File Name: scan_cache.h
+*
+* Description: This file contains the structure and function prototypes of
+*              the scan cache, which keeps the APs reported by the most
+*              recent Wi-Fi scans so that a connection can be made with the
+*              security type and band of the target network.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SCAN_CACHE_H_
+#define SCAN_CACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cy_wcm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of APs kept, the oldest one is replaced when the cache is full. */
+#define SCAN_CACHE_ENTRY_COUNT                       (16u)
+
+/* Age beyond which a cached AP is no longer used to connect. */
+#define SCAN_CACHE_MAX_AGE_MSEC                      (60000u)
+
+/* Maximum duration of a scan for a single SSID, and the interval at which
+ * its completion is polled.
+ */
+#define SCAN_CACHE_SCAN_TIMEOUT_MSEC                 (5000u)
+#define SCAN_CACHE_POLL_INTERVAL_MSEC                (50u)
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    cy_wcm_ssid_t       ssid;
+    cy_wcm_mac_t        bssid;
+    int16_t             rssi;
+    uint8_t             channel;
+    uint8_t             band;                   /* cy_wcm_wifi_band_t */
+    uint32_t            security;               /* cy_wcm_security_t */
+    uint32_t            seen_tick;              /* Tick count of the last report, 0 if free */
+} scan_cache_entry_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void scan_cache_add(const cy_wcm_scan_result_t *result);
+bool scan_cache_find(const uint8_t *ssid, uint32_t max_age_msec, scan_cache_entry_t *entry);
+cy_rslt_t scan_cache_scan_ssid(const uint8_t *ssid);
+
+#endif /* SCAN_CACHE_H_ */
+
+/* [] END OF FILE */
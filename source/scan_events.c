@@ -0,0 +1,460 @@
+/******************************************************************************
+* File Name: scan_events.c
+*
+* Description: This file contains the scan event queue. The callback of a
+*              scan started for the /scan_events stream queues every network
+*              satisfying the scan options the first time it is reported,
+*              and the HTTP handler of the stream sends them as server sent
+*              events while the scan goes on, followed by a completion
+*              event.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "scan_events.h"
+
+/* Standard C header file */
+#include <string.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Networks waiting to be sent. An entry with an empty SSID marks the end of
+ * the scan, hidden networks being ignored.
+ */
+static QueueHandle_t scan_event_queue = NULL;
+static uint8_t scan_event_queue_storage[SCAN_EVENTS_QUEUE_LENGTH * sizeof(scan_event_t)];
+static StaticQueue_t scan_event_queue_buffer;
+_Static_assert((sizeof(scan_event_queue_storage) + sizeof(scan_event_queue_buffer)) == SCAN_EVENTS_QUEUE_MEMORY,
+               "SCAN_EVENTS_QUEUE_MEMORY does not match the storage of the scan event queue");
+
+/* Options of the scan in progress. */
+static scan_options_t scan_event_options;
+
+/* SSIDs queued by the scan in progress, padded with NUL bytes so that they
+ * compare as a whole, written by the scan callback only.
+ */
+static cy_wcm_ssid_t seen_networks[SCAN_EVENTS_MAX_NETWORKS];
+static uint8_t seen_count = 0;
+
+/* Held by the handler of the scan running for the HTTP server, so that a
+ * second scan does not reset the queue and the SSIDs of the first.
+ */
+static SemaphoreHandle_t scan_mutex = NULL;
+static StaticSemaphore_t scan_mutex_buffer;
+_Static_assert(sizeof(scan_mutex_buffer) == SCAN_EVENTS_MUTEX_MEMORY,
+               "SCAN_EVENTS_MUTEX_MEMORY does not match the storage of the scan mutex");
+
+/* Set by the scan callback once the scan is complete. */
+static volatile bool scan_events_complete = true;
+
+/*******************************************************************************
+* Function Name: scan_events_callback
+********************************************************************************
+* Summary:
+*  Scan callback of scan_events_start. Records every AP in the scan cache and
+*  queues the networks satisfying the scan options which have not been
+*  queued yet. Runs in the context of the Wi-Fi connection manager, so it
+*  never waits for room in the queue.
+*
+* Parameters:
+*  result_ptr - Pointer to the scan result.
+*  user_data - Unused.
+*  status - Status of scan completion.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void scan_events_callback(cy_wcm_scan_result_t *result_ptr, void *user_data, cy_wcm_scan_status_t status)
+{
+    scan_event_t event;
+
+    (void)user_data;
+
+    if (CY_WCM_SCAN_COMPLETE == status)
+    {
+        scan_events_complete = true;
+        memset(&event, 0, sizeof(event));
+        xQueueSend(scan_event_queue, &event, 0);
+        return;
+    }
+
+    if (result_ptr->SSID[0] == '\0')
+    {
+        return;
+    }
+
+    /* Keep the security type and channel for the connection */
+    scan_cache_add(result_ptr);
+    if (!scan_options_match(&scan_event_options, result_ptr))
+    {
+        return;
+    }
+
+    memset(event.ssid, 0, sizeof(event.ssid));
+    for (uint8_t index = 0; (index < CREDENTIAL_SSID_LENGTH) && (result_ptr->SSID[index] != '\0'); index++)
+    {
+        event.ssid[index] = result_ptr->SSID[index];
+    }
+    for (uint8_t index = 0; index < seen_count; index++)
+    {
+        if (0 == memcmp(seen_networks[index], event.ssid, sizeof(event.ssid)))
+        {
+            return;
+        }
+    }
+    if (seen_count >= SCAN_EVENTS_MAX_NETWORKS)
+    {
+        return;
+    }
+
+    event.rssi = result_ptr->signal_strength;
+    event.channel = result_ptr->channel;
+    event.security = (uint32_t)result_ptr->security;
+    if (pdPASS == xQueueSend(scan_event_queue, &event, 0))
+    {
+        memcpy(seen_networks[seen_count++], event.ssid, sizeof(event.ssid));
+    }
+}
+
+/*******************************************************************************
+* Function Name: append_escaped
+********************************************************************************
+* Summary:
+*  Appends an SSID as the content of a JSON string. Quotes, backslashes and
+*  control characters are escaped; the other bytes are copied as they are.
+*
+* Parameters:
+*  dst - Destination buffer.
+*  capacity - Size of the destination buffer.
+*  length - Length of the text in the buffer, updated.
+*  ssid - SSID, NUL terminated unless it is CREDENTIAL_SSID_LENGTH bytes long.
+*
+* Return:
+*  bool - true if the SSID fit in the buffer.
+*
+*******************************************************************************/
+static bool append_escaped(char *dst, size_t capacity, size_t *length, const uint8_t *ssid)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+    uint8_t character;
+
+    for (uint8_t index = 0; (index < CREDENTIAL_SSID_LENGTH) && (ssid[index] != '\0'); index++)
+    {
+        character = ssid[index];
+        if ((*length + 6u) >= capacity)
+        {
+            return false;
+        }
+        if ((character == '"') || (character == '\\'))
+        {
+            dst[(*length)++] = '\\';
+            dst[(*length)++] = (char)character;
+        }
+        else if (character < 0x20u)
+        {
+            memcpy(&dst[*length], "\\u00", 4);
+            *length += 4u;
+            dst[(*length)++] = hex_digits[character >> 4];
+            dst[(*length)++] = hex_digits[character & 0x0Fu];
+        }
+        else
+        {
+            dst[(*length)++] = (char)character;
+        }
+    }
+    dst[*length] = '\0';
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: scan_events_init
+********************************************************************************
+* Summary:
+*  Creates the scan event queue and the scan mutex.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_events_init(void)
+{
+    scan_event_queue = xQueueCreateStatic(SCAN_EVENTS_QUEUE_LENGTH, sizeof(scan_event_t),
+                                          scan_event_queue_storage, &scan_event_queue_buffer);
+    configASSERT(scan_event_queue != NULL);
+    scan_mutex = xSemaphoreCreateMutexStatic(&scan_mutex_buffer);
+    configASSERT(scan_mutex != NULL);
+}
+
+/*******************************************************************************
+* Function Name: scan_events_lock
+********************************************************************************
+* Summary:
+*  Takes the scan mutex without waiting for it, and answers the request with
+*  "503 Service Unavailable" and a Retry-After header if another scan is
+*  running. The handler must not write a response of its own when the
+*  mutex is not taken, and must call scan_events_unlock otherwise.
+*
+* Parameters:
+*  stream - Response stream of the request.
+*
+* Return:
+*  bool - true if the mutex was taken.
+*
+*******************************************************************************/
+bool scan_events_lock(cy_http_response_stream_t *stream)
+{
+    char response_buffer[SCAN_EVENTS_RESPONSE_LENGTH];
+    response_builder_t builder;
+
+    if (pdTRUE == xSemaphoreTake(scan_mutex, 0))
+    {
+        return true;
+    }
+
+    response_builder_init(&builder, response_buffer, sizeof(response_buffer), stream);
+    response_builder_append_string(&builder, "HTTP/1.1 503 Service Unavailable\r\nRetry-After: ");
+    response_builder_append_uint(&builder, SCAN_EVENTS_RETRY_AFTER_SEC);
+    response_builder_append_string(&builder, "\r\nContent-Length: 0\r\n" HTTP_CONNECTION_HEADERS "\r\n");
+    if (CY_RSLT_SUCCESS != response_builder_finish(&builder))
+    {
+        ERR_INFO(("Failed to send the 503 response\r\n"));
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: scan_events_unlock
+********************************************************************************
+* Summary:
+*  Gives the scan mutex taken by scan_events_lock back once the scan is over.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_events_unlock(void)
+{
+    xSemaphoreGive(scan_mutex);
+}
+
+/*******************************************************************************
+* Function Name: scan_events_start
+********************************************************************************
+* Summary:
+*  Starts a scan whose networks are queued for scan_events_next. The options
+*  are applied by the scan filter of the Wi-Fi connection manager as far as
+*  it supports them, and by the scan callback for the rest.
+*
+* Parameters:
+*  options - Options the queued networks must satisfy.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS if the scan was started, otherwise the error
+*  returned by the Wi-Fi connection manager.
+*
+*******************************************************************************/
+cy_rslt_t scan_events_start(const scan_options_t *options)
+{
+    cy_wcm_scan_filter_t filter;
+    bool filtered;
+    cy_rslt_t result;
+
+    xQueueReset(scan_event_queue);
+    scan_event_options = *options;
+    seen_count = 0;
+    scan_events_complete = false;
+
+    filtered = scan_options_to_wcm_filter(options, &filter);
+    result = cy_wcm_start_scan(scan_events_callback, NULL, filtered ? &filter : NULL);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        scan_events_complete = true;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: scan_events_next
+********************************************************************************
+* Summary:
+*  Waits for the next network found by the scan, or for the end of the scan.
+*
+* Parameters:
+*  event - Receives the network.
+*  timeout_msec - Time to wait for a report.
+*
+* Return:
+*  scan_events_status_t - SCAN_EVENTS_NETWORK if a network was received,
+*  SCAN_EVENTS_COMPLETE once the scan is complete and every network has
+*  been received, or SCAN_EVENTS_TIMEOUT.
+*
+*******************************************************************************/
+scan_events_status_t scan_events_next(scan_event_t *event, uint32_t timeout_msec)
+{
+    uint32_t waited_msec = 0;
+
+    while (true)
+    {
+        if (pdPASS == xQueueReceive(scan_event_queue, event, pdMS_TO_TICKS(SCAN_EVENTS_POLL_MSEC)))
+        {
+            return (event->ssid[0] == '\0') ? SCAN_EVENTS_COMPLETE : SCAN_EVENTS_NETWORK;
+        }
+
+        /* The completion was not queued, the last networks may have been */
+        if (scan_events_complete)
+        {
+            if (pdPASS == xQueueReceive(scan_event_queue, event, 0))
+            {
+                return (event->ssid[0] == '\0') ? SCAN_EVENTS_COMPLETE : SCAN_EVENTS_NETWORK;
+            }
+            return SCAN_EVENTS_COMPLETE;
+        }
+
+        waited_msec += SCAN_EVENTS_POLL_MSEC;
+        if (waited_msec >= timeout_msec)
+        {
+            return SCAN_EVENTS_TIMEOUT;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_events_stop
+********************************************************************************
+* Summary:
+*  Stops the scan if it is still running, for example when the client has
+*  gone away.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_events_stop(void)
+{
+    if (!scan_events_complete)
+    {
+        cy_wcm_stop_scan();
+        scan_events_complete = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_events_format_network
+********************************************************************************
+* Summary:
+*  Formats a "network" server sent event, whose data is a JSON object with
+*  the SSID, RSSI and channel of the network and whether it is open.
+*
+* Parameters:
+*  dst - Destination buffer, SCAN_EVENTS_FRAME_LENGTH bytes fit any network.
+*  capacity - Size of the destination buffer.
+*  event - Network to be formatted.
+*
+* Return:
+*  size_t - Length of the event, 0 if it did not fit.
+*
+*******************************************************************************/
+size_t scan_events_format_network(char *dst, size_t capacity, const scan_event_t *event)
+{
+    size_t length = 0;
+    bool fits;
+
+    fits = format_append(dst, capacity, &length, "event: network\ndata: {\"ssid\":\"") &&
+           append_escaped(dst, capacity, &length, event->ssid) &&
+           format_append(dst, capacity, &length, (event->rssi < 0) ? "\",\"rssi\":-" : "\",\"rssi\":") &&
+           format_append_uint(dst, capacity, &length, (uint32_t)((event->rssi < 0) ? -event->rssi : event->rssi)) &&
+           format_append(dst, capacity, &length, ",\"channel\":") &&
+           format_append_uint(dst, capacity, &length, event->channel) &&
+           format_append(dst, capacity, &length, (CY_WCM_SECURITY_OPEN == event->security) ?
+                                                 ",\"open\":true}\n\n" : ",\"open\":false}\n\n");
+
+    return fits ? length : 0u;
+}
+
+/*******************************************************************************
+* Function Name: scan_events_format_done
+********************************************************************************
+* Summary:
+*  Formats the "done" server sent event which ends the stream.
+*
+* Parameters:
+*  dst - Destination buffer.
+*  capacity - Size of the destination buffer.
+*  networks - Number of networks sent.
+*  first_msec - Time from the start of the scan to the first network sent.
+*  scan_msec - Duration of the scan.
+*  complete - false if the scan could not be started or was given up.
+*
+* Return:
+*  size_t - Length of the event, 0 if it did not fit.
+*
+*******************************************************************************/
+size_t scan_events_format_done(char *dst, size_t capacity, uint32_t networks, uint32_t first_msec,
+                               uint32_t scan_msec, bool complete)
+{
+    size_t length = 0;
+    bool fits;
+
+    fits = format_append(dst, capacity, &length, "event: done\ndata: {\"networks\":") &&
+           format_append_uint(dst, capacity, &length, networks) &&
+           format_append(dst, capacity, &length, ",\"first_result_msec\":") &&
+           format_append_uint(dst, capacity, &length, first_msec) &&
+           format_append(dst, capacity, &length, ",\"scan_msec\":") &&
+           format_append_uint(dst, capacity, &length, scan_msec) &&
+           format_append(dst, capacity, &length, complete ? ",\"complete\":true}\n\n" : ",\"complete\":false}\n\n");
+
+    return fits ? length : 0u;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,132 @@
+/******************************************************************************
+* File Name: scan_events.h
+*
+* Description: This file contains the structure and function prototypes of
+*              the scan event queue, which hands the networks found by a
+*              Wi-Fi scan over to the /scan_events stream as they are
+*              reported.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SCAN_EVENTS_H_
+#define SCAN_EVENTS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cy_wcm.h"
+#include "cy_http_server.h"
+#include "scan_filter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of networks waiting to be sent. A network reported while the queue
+ * is full is not marked as seen, so a later report of it is sent.
+ */
+#define SCAN_EVENTS_QUEUE_LENGTH                     (8u)
+
+/* RAM taken by the queue of the networks, checked against its storage. */
+#define SCAN_EVENTS_QUEUE_MEMORY                     RTOS_QUEUE_MEMORY(SCAN_EVENTS_QUEUE_LENGTH, sizeof(scan_event_t))
+
+/* RAM taken by the mutex which lets a single scan run for the HTTP server. */
+#define SCAN_EVENTS_MUTEX_MEMORY                     RTOS_MUTEX_MEMORY
+
+/* Number of distinct SSIDs remembered by a scan to drop the repeated
+ * reports; the SSIDs beyond are not sent.
+ */
+#define SCAN_EVENTS_MAX_NETWORKS                     (32u)
+
+/* Time a client is asked to wait before retrying a scan refused with "503
+ * Service Unavailable" because another scan is running.
+ */
+#define SCAN_EVENTS_RETRY_AFTER_SEC                  (5u)
+
+/* Size of the buffer in which the 503 response is assembled. */
+#define SCAN_EVENTS_RESPONSE_LENGTH                  (160u)
+
+/* Time without any report after which the scan is given up. */
+#define SCAN_EVENTS_TIMEOUT_MSEC                     (10000u)
+
+/* Interval at which the completion of the scan is checked while no network
+ * is reported, in case the completion could not be queued.
+ */
+#define SCAN_EVENTS_POLL_MSEC                        (100u)
+
+/* Size of the buffer of one event: the event line, and the data line with
+ * an SSID whose every byte is escaped.
+ */
+#define SCAN_EVENTS_FRAME_LENGTH                     (288u)
+
+/*******************************************************************************
+ *                    Enumerations
+*******************************************************************************/
+typedef enum
+{
+    SCAN_EVENTS_NETWORK,            /* A network was received */
+    SCAN_EVENTS_COMPLETE,           /* The scan is complete */
+    SCAN_EVENTS_TIMEOUT             /* Nothing was reported in time */
+} scan_events_status_t;
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    cy_wcm_ssid_t       ssid;
+    int16_t             rssi;
+    uint8_t             channel;
+    uint32_t            security;               /* cy_wcm_security_t */
+} scan_event_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void scan_events_init(void);
+bool scan_events_lock(cy_http_response_stream_t *stream);
+void scan_events_unlock(void);
+cy_rslt_t scan_events_start(const scan_options_t *options);
+scan_events_status_t scan_events_next(scan_event_t *event, uint32_t timeout_msec);
+void scan_events_stop(void);
+size_t scan_events_format_network(char *dst, size_t capacity, const scan_event_t *event);
+size_t scan_events_format_done(char *dst, size_t capacity, uint32_t networks, uint32_t first_msec,
+                               uint32_t scan_msec, bool complete);
+
+#endif /* SCAN_EVENTS_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,358 @@
+/******************************************************************************
+* File Name: scan_filter.c
+*
+* Description: This file contains the scan options of the scan page. The
+*              Wi-Fi connection manager applies a single scan filter, by
+*              SSID, band or RSSI range, so the options are mapped onto the
+*              most selective filter it supports and the rest is checked
+*              against every result reported by the scan:
+*              - an exact SSID is passed as the SSID filter;
+*              - a channel list within one band is passed as the band filter;
+*              - an RSSI floor is passed as the tightest RSSI range below it.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "scan_filter.h"
+
+/* Standard C header files */
+#include <ctype.h>
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: parse_channels
+********************************************************************************
+* Summary:
+*  Parses a comma separated list of channel numbers.
+*
+* Parameters:
+*  value - Value of the query parameter, not NUL terminated.
+*  length - Length of the value.
+*  options - Receives the channel list.
+*
+* Return:
+*  bool - true if the list is valid.
+*
+*******************************************************************************/
+static bool parse_channels(const char *value, uint32_t length, scan_options_t *options)
+{
+    uint32_t channel = 0;
+    uint8_t digits = 0;
+    uint8_t count = 0;
+
+    for (uint32_t index = 0; index <= length; index++)
+    {
+        if ((index == length) || (value[index] == ','))
+        {
+            if ((digits == 0) || (channel == 0) || (count == SCAN_FILTER_MAX_CHANNELS))
+            {
+                return false;
+            }
+            options->channels[count++] = (uint8_t)channel;
+            channel = 0;
+            digits = 0;
+        }
+        else if (isdigit((unsigned char)value[index]))
+        {
+            channel = (channel * 10u) + (uint32_t)(value[index] - '0');
+            if (channel > SCAN_FILTER_MAX_CHANNEL)
+            {
+                return false;
+            }
+            digits++;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    options->channel_count = count;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: parse_ssid
+********************************************************************************
+* Summary:
+*  URL decodes an SSID query parameter.
+*
+* Parameters:
+*  value - Value of the query parameter, not NUL terminated.
+*  length - Length of the value.
+*  options - Receives the SSID.
+*
+* Return:
+*  bool - true if the SSID is valid.
+*
+*******************************************************************************/
+static bool parse_ssid(const char *value, uint32_t length, scan_options_t *options)
+{
+    size_t decoded_length;
+
+    if ((length == 0) || (length > SCAN_FILTER_ENCODED_SSID_LENGTH))
+    {
+        return false;
+    }
+
+    decoded_length = url_decode((uint8_t *)options->ssid, sizeof(options->ssid), (const uint8_t *)value, length);
+
+    /* An SSID which does not fit, or with an encoded NUL, is rejected */
+    if ((decoded_length == URL_DECODE_OVERFLOW) || (decoded_length == 0) ||
+        (memchr(options->ssid, '\0', decoded_length) != NULL))
+    {
+        options->ssid[0] = '\0';
+        return false;
+    }
+
+    options->ssid_length = (uint8_t)decoded_length;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: parse_rssi
+********************************************************************************
+* Summary:
+*  Parses an RSSI floor in dBm, such as -70.
+*
+* Parameters:
+*  value - Value of the query parameter, not NUL terminated.
+*  length - Length of the value.
+*  options - Receives the RSSI floor.
+*
+* Return:
+*  bool - true if the RSSI floor is valid.
+*
+*******************************************************************************/
+static bool parse_rssi(const char *value, uint32_t length, scan_options_t *options)
+{
+    int32_t rssi = 0;
+    uint32_t index = 0;
+    bool negative = false;
+
+    if ((length > 0) && (value[0] == '-'))
+    {
+        negative = true;
+        index++;
+    }
+    if ((index == length) || ((length - index) > 3u))
+    {
+        return false;
+    }
+
+    for (; index < length; index++)
+    {
+        if (!isdigit((unsigned char)value[index]))
+        {
+            return false;
+        }
+        rssi = (rssi * 10) + (value[index] - '0');
+    }
+    rssi = negative ? -rssi : rssi;
+
+    if ((rssi < SCAN_FILTER_MIN_RSSI) || (rssi > 0))
+    {
+        return false;
+    }
+
+    options->rssi_floor = (int16_t)rssi;
+    options->rssi_floor_set = true;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: scan_options_parse
+********************************************************************************
+* Summary:
+*  Reads the scan options from the URL query string. An invalid option is
+*  reported and ignored, so that the scan still takes place.
+*
+* Parameters:
+*  url_parameters - Pointer to the HTTP URL query string, may be NULL.
+*  options - Receives the scan options.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scan_options_parse(const char *url_parameters, scan_options_t *options)
+{
+    char *value = NULL;
+    uint32_t length = 0;
+
+    memset(options, 0, sizeof(*options));
+    if (url_parameters == NULL)
+    {
+        return;
+    }
+
+    if ((CY_RSLT_SUCCESS == cy_http_server_get_query_parameter_value(url_parameters, SCAN_QUERY_CHANNELS, &value, &length)) &&
+        !parse_channels(value, length, options))
+    {
+        ERR_INFO(("Ignoring invalid scan option '" SCAN_QUERY_CHANNELS "'\r\n"));
+        options->channel_count = 0;
+    }
+
+    if (CY_RSLT_SUCCESS == cy_http_server_get_query_parameter_value(url_parameters, SCAN_QUERY_SSID, &value, &length))
+    {
+        options->ssid_prefix = false;
+    }
+    else if (CY_RSLT_SUCCESS == cy_http_server_get_query_parameter_value(url_parameters, SCAN_QUERY_SSID_PREFIX, &value, &length))
+    {
+        options->ssid_prefix = true;
+    }
+    else
+    {
+        value = NULL;
+    }
+    if ((value != NULL) && !parse_ssid(value, length, options))
+    {
+        ERR_INFO(("Ignoring invalid scan option '" SCAN_QUERY_SSID "'\r\n"));
+        options->ssid_length = 0;
+    }
+
+    if ((CY_RSLT_SUCCESS == cy_http_server_get_query_parameter_value(url_parameters, SCAN_QUERY_MIN_RSSI, &value, &length)) &&
+        !parse_rssi(value, length, options))
+    {
+        ERR_INFO(("Ignoring invalid scan option '" SCAN_QUERY_MIN_RSSI "'\r\n"));
+        options->rssi_floor_set = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: scan_options_to_wcm_filter
+********************************************************************************
+* Summary:
+*  Selects the scan filter of the Wi-Fi connection manager which applies the
+*  most selective of the options.
+*
+* Parameters:
+*  options - Scan options.
+*  filter - Receives the scan filter.
+*
+* Return:
+*  bool - true if a filter applies, false to scan without a filter.
+*
+*******************************************************************************/
+bool scan_options_to_wcm_filter(const scan_options_t *options, cy_wcm_scan_filter_t *filter)
+{
+    uint8_t channels_2_4ghz = 0;
+
+    memset(filter, 0, sizeof(*filter));
+
+    if ((options->ssid_length != 0) && !options->ssid_prefix)
+    {
+        filter->mode = CY_WCM_SCAN_FILTER_TYPE_SSID;
+        memcpy(filter->param.SSID, options->ssid, options->ssid_length);
+        return true;
+    }
+
+    if (options->channel_count != 0)
+    {
+        for (uint8_t index = 0; index < options->channel_count; index++)
+        {
+            channels_2_4ghz += (options->channels[index] <= WIFI_LINK_MAX_2_4GHZ_CHANNEL) ? 1u : 0u;
+        }
+        if ((channels_2_4ghz == 0) || (channels_2_4ghz == options->channel_count))
+        {
+            filter->mode = CY_WCM_SCAN_FILTER_TYPE_BAND;
+            filter->param.band = (channels_2_4ghz != 0) ? CY_WCM_WIFI_BAND_2_4GHZ : CY_WCM_WIFI_BAND_5GHZ;
+            return true;
+        }
+    }
+
+    if (options->rssi_floor_set && (options->rssi_floor >= CY_WCM_SCAN_RSSI_FAIR))
+    {
+        filter->mode = CY_WCM_SCAN_FILTER_TYPE_RSSI;
+        if (options->rssi_floor >= CY_WCM_SCAN_RSSI_EXCELLENT)
+        {
+            filter->param.rssi_range = CY_WCM_SCAN_RSSI_EXCELLENT;
+        }
+        else if (options->rssi_floor >= CY_WCM_SCAN_RSSI_GOOD)
+        {
+            filter->param.rssi_range = CY_WCM_SCAN_RSSI_GOOD;
+        }
+        else
+        {
+            filter->param.rssi_range = CY_WCM_SCAN_RSSI_FAIR;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: scan_options_match
+********************************************************************************
+* Summary:
+*  Checks a scan result against all of the options.
+*
+* Parameters:
+*  options - Scan options.
+*  result - Scan result.
+*
+* Return:
+*  bool - true if the result satisfies every option.
+*
+*******************************************************************************/
+bool scan_options_match(const scan_options_t *options, const cy_wcm_scan_result_t *result)
+{
+    bool channel_listed = (options->channel_count == 0);
+
+    for (uint8_t index = 0; (index < options->channel_count) && !channel_listed; index++)
+    {
+        channel_listed = (options->channels[index] == result->channel);
+    }
+    if (!channel_listed)
+    {
+        return false;
+    }
+
+    if (options->ssid_length != 0)
+    {
+        if (0 != strncmp((const char *)result->SSID, options->ssid, options->ssid_length))
+        {
+            return false;
+        }
+        if (!options->ssid_prefix && (result->SSID[options->ssid_length] != '\0'))
+        {
+            return false;
+        }
+    }
+
+    return !options->rssi_floor_set || (result->signal_strength >= options->rssi_floor);
+}
+
+/* [] END OF FILE */
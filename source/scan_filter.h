@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name: scan_filter.h
+*
+* Description: This file contains the structure and function prototypes of
+*              the scan options accepted by the scan page: a channel list, an
+*              SSID or SSID prefix, and an RSSI floor.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SCAN_FILTER_H_
+#define SCAN_FILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cy_wcm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of channels in the "channels" query parameter. */
+#define SCAN_FILTER_MAX_CHANNELS                     (16u)
+
+/* Highest channel number accepted in the channel list. */
+#define SCAN_FILTER_MAX_CHANNEL                      (196u)
+
+/* Maximum length of the SSID parameters before URL decoding, and after. */
+#define SCAN_FILTER_ENCODED_SSID_LENGTH              (96u)
+#define SCAN_FILTER_SSID_LENGTH                      (32u)
+
+/* Lowest RSSI accepted as an RSSI floor, in dBm. */
+#define SCAN_FILTER_MIN_RSSI                         (-127)
+
+/* Query parameters of the scan page */
+#define SCAN_QUERY_CHANNELS                          "channels"
+#define SCAN_QUERY_SSID                              "ssid"
+#define SCAN_QUERY_SSID_PREFIX                       "ssid_prefix"
+#define SCAN_QUERY_MIN_RSSI                          "min_rssi"
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    uint8_t     channels[SCAN_FILTER_MAX_CHANNELS];
+    uint8_t     channel_count;                  /* 0 for every channel */
+    char        ssid[SCAN_FILTER_SSID_LENGTH + 1u];
+    uint8_t     ssid_length;                    /* 0 for every SSID */
+    bool        ssid_prefix;                    /* Match SSIDs starting with ssid */
+    bool        rssi_floor_set;
+    int16_t     rssi_floor;                     /* Minimum RSSI in dBm */
+} scan_options_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void scan_options_parse(const char *url_parameters, scan_options_t *options);
+bool scan_options_to_wcm_filter(const scan_options_t *options, cy_wcm_scan_filter_t *filter);
+bool scan_options_match(const scan_options_t *options, const cy_wcm_scan_result_t *result);
+
+#endif /* SCAN_FILTER_H_ */
+
+/* [] END OF FILE */
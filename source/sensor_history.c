@@ -0,0 +1,274 @@
+/******************************************************************************
+* File Name: sensor_history.c
+*
+* Description: This file contains the ring buffer which records the light
+*              sensor voltage and the PWM duty cycle at a fixed interval so
+*              that the readings can be exported over HTTP.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+
+#include "sensor_history.h"
+#include "rtos_memory.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Ring buffer holding the recorded sensor values. */
+static history_record_t history_records[HISTORY_MAX_RECORDS];
+
+/* Storage added by history_add_storage(), which extends history_records. */
+static history_record_t *history_extension = NULL;
+
+/* Number of slots of the ring, in history_records and then in
+ * history_extension.
+ */
+static uint32_t history_capacity = HISTORY_MAX_RECORDS;
+
+/* Slot of the next record, and number of records held. */
+static uint32_t history_head = 0;
+static uint32_t history_count = 0;
+
+/* Tick count at which the last record was written. */
+static TickType_t history_last_tick = 0;
+
+/* Mutex guarding the ring buffer against the HTTP server thread. */
+static SemaphoreHandle_t history_mutex = NULL;
+static StaticSemaphore_t history_mutex_buffer;
+_Static_assert(sizeof(history_mutex_buffer) == HISTORY_MUTEX_MEMORY,
+               "HISTORY_MUTEX_MEMORY does not match the storage of the history mutex");
+
+/********************************************************************************
+ * Function Name: history_slot
+ ********************************************************************************
+ * Summary:
+ *  The function returns a slot of the ring buffer.
+ *
+ * Parameters:
+ *  slot - Index of the slot, less than history_capacity.
+ *
+ * Return:
+ *  history_record_t* - Pointer to the slot.
+ *
+ *******************************************************************************/
+static history_record_t *history_slot(uint32_t slot)
+{
+    if (slot < HISTORY_MAX_RECORDS)
+    {
+        return &history_records[slot];
+    }
+
+    return &history_extension[slot - HISTORY_MAX_RECORDS];
+}
+
+/********************************************************************************
+ * Function Name: initialize_history
+ ********************************************************************************
+ * Summary:
+ *  The function creates the mutex guarding the history ring buffer.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void initialize_history(void)
+{
+    history_mutex = xSemaphoreCreateMutexStatic(&history_mutex_buffer);
+    configASSERT(history_mutex != NULL);
+}
+
+/********************************************************************************
+ * Function Name: history_add_storage
+ ********************************************************************************
+ * Summary:
+ *  The function extends the history with the given storage, such as the
+ *  provisioning arena once it has been released, so that more records are
+ *  held before the oldest one is overwritten. The records already held are
+ *  kept. Storage can only be added once.
+ *
+ * Parameters:
+ *  storage - Storage aligned for history_record_t, owned by the history
+ *            from now on.
+ *  length - Size of the storage in bytes.
+ *
+ * Return:
+ *  uint32_t - Number of records added to the capacity of the history.
+ *
+ *******************************************************************************/
+uint32_t history_add_storage(void *storage, size_t length)
+{
+    uint32_t added = (uint32_t)(length / sizeof(history_record_t));
+    uint32_t moved;
+
+    if ((storage == NULL) || (added == 0) || (history_extension != NULL))
+    {
+        return 0;
+    }
+
+    xSemaphoreTake(history_mutex, portMAX_DELAY);
+    history_extension = (history_record_t *)storage;
+
+    if ((history_count == history_capacity) && (history_head == 0))
+    {
+        /* The ring is full and its oldest record is in the first slot: the
+         * next record goes to the first slot of the extension.
+         */
+        history_head = history_capacity;
+    }
+    else if (history_count == history_capacity)
+    {
+        /* The ring has wrapped: move the oldest records, from the head to
+         * the end of the ring, up to the end of the extended ring, last
+         * first.
+         */
+        moved = history_capacity - history_head;
+        for (uint32_t index = 1; index <= moved; index++)
+        {
+            *history_slot(history_capacity + added - index) = *history_slot(history_capacity - index);
+        }
+    }
+    history_capacity += added;
+    xSemaphoreGive(history_mutex);
+
+    return added;
+}
+
+/********************************************************************************
+ * Function Name: history_update
+ ********************************************************************************
+ * Summary:
+ *  The function stores the given sensor values in the history if
+ *  HISTORY_SAMPLE_INTERVAL_MSEC has elapsed since the previous record. The
+ *  oldest record is overwritten once the history is full.
+ *
+ * Parameters:
+ *  light_sensor_voltage - Light sensor voltage in mV.
+ *  duty - PWM duty cycle in percent.
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+void history_update(uint16_t light_sensor_voltage, uint8_t duty)
+{
+    TickType_t now = xTaskGetTickCount();
+    history_record_t *record;
+
+    if ((history_count != 0) &&
+        ((now - history_last_tick) < pdMS_TO_TICKS(HISTORY_SAMPLE_INTERVAL_MSEC)))
+    {
+        return;
+    }
+
+    xSemaphoreTake(history_mutex, portMAX_DELAY);
+    record = history_slot(history_head);
+    record->timestamp = now / configTICK_RATE_HZ;
+    record->light_sensor_voltage = light_sensor_voltage;
+    record->duty = duty;
+    record->reserved = 0;
+    history_head = (history_head + 1u) % history_capacity;
+    if (history_count < history_capacity)
+    {
+        history_count++;
+    }
+    xSemaphoreGive(history_mutex);
+
+    history_last_tick = now;
+}
+
+/********************************************************************************
+ * Function Name: history_get_count
+ ********************************************************************************
+ * Summary:
+ *  The function returns the number of records currently held in the history.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t - Number of records available, at most the capacity of the
+ *  history.
+ *
+ *******************************************************************************/
+uint32_t history_get_count(void)
+{
+    uint32_t count;
+
+    xSemaphoreTake(history_mutex, portMAX_DELAY);
+    count = history_count;
+    xSemaphoreGive(history_mutex);
+
+    return count;
+}
+
+/********************************************************************************
+ * Function Name: history_get_record
+ ********************************************************************************
+ * Summary:
+ *  The function copies a record out of the history. Index 0 is the oldest
+ *  record held.
+ *
+ * Parameters:
+ *  index - Index of the record, counted from the oldest record.
+ *  record - Pointer to the structure that receives the record.
+ *
+ * Return:
+ *  bool - true if the record exists, false if the index is out of range.
+ *
+ *******************************************************************************/
+bool history_get_record(uint32_t index, history_record_t *record)
+{
+    uint32_t oldest;
+    bool found = false;
+
+    xSemaphoreTake(history_mutex, portMAX_DELAY);
+    if (index < history_count)
+    {
+        oldest = (history_head + history_capacity - history_count) % history_capacity;
+        *record = *history_slot((oldest + index) % history_capacity);
+        found = true;
+    }
+    xSemaphoreGive(history_mutex);
+
+    return found;
+}
+
+/* [] END OF FILE */
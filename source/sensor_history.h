@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name: sensor_history.h
+*
+* Description: This file contains the macros, structures and function
+*              prototypes of the sensor history ring buffer.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SENSOR_HISTORY_H_
+#define SENSOR_HISTORY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The interval in milliseconds between two records stored in the history. */
+#define HISTORY_SAMPLE_INTERVAL_MSEC                    (60000u)
+
+/* Number of records held in the history, 24 hours at one record per minute.
+ * The history holds more records once history_add_storage() has been called.
+ */
+#define HISTORY_MAX_RECORDS                             (1440u)
+
+/* RAM taken by the mutex of the history, checked against its storage. */
+#define HISTORY_MUTEX_MEMORY                            RTOS_MUTEX_MEMORY
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t        timestamp;              /* Seconds since boot */
+    uint16_t        light_sensor_voltage;   /* Light sensor voltage in mV */
+    uint8_t         duty;                   /* PWM duty cycle in percent */
+    uint8_t         reserved;
+} history_record_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void initialize_history(void);
+uint32_t history_add_storage(void *storage, size_t length);
+void history_update(uint16_t light_sensor_voltage, uint8_t duty);
+uint32_t history_get_count(void);
+bool history_get_record(uint32_t index, history_record_t *record);
+
+#endif /* SENSOR_HISTORY_H_ */
+
+/* [] END OF FILE */
@@ -44,6 +44,11 @@
 
  pwm_duty_t pwm_duty;
 
+/* Storage of the mutex guarding pwm_duty. */
+static StaticSemaphore_t pwm_mutex_buffer;
+_Static_assert(sizeof(pwm_mutex_buffer) == PWM_MUTEX_MEMORY,
+               "PWM_MUTEX_MEMORY does not match the storage of the PWM mutex");
+
  /* PWM used to change LED brightness */
  cyhal_pwm_t pwm_led;
 
@@ -417,7 +422,8 @@ void initialize_sensors(void)
 
     pwm_duty.duty = DEFAULT_DUTYCYCLE;
 
-    pwm_duty.xpwm_mutex = xSemaphoreCreateRecursiveMutex();;
+    pwm_duty.xpwm_mutex = xSemaphoreCreateRecursiveMutexStatic(&pwm_mutex_buffer);
+    configASSERT(pwm_duty.xpwm_mutex != NULL);
 
     result = initialize_led();
     PRINT_AND_ASSERT(result, "Failed to initialize led.\r\n");
@@ -68,6 +68,9 @@
 /* Capsense task priority */
 #define CAPSENSE_TASK_PRIORITY                          (1u)
 
+/* RAM taken by the mutex of pwm_duty, checked against its storage. */
+#define PWM_MUTEX_MEMORY                                RTOS_MUTEX_MEMORY
+
 /* CapSense interrupt priority */
 #define CAPSENSE_INTR_PRIORITY                          (7u)
 
@@ -97,6 +100,12 @@ typedef struct
     SemaphoreHandle_t xpwm_mutex;
 } pwm_duty_t;
 
+typedef struct
+{
+    uint16_t        light_sensor_voltage;
+    uint8_t         duty;
+} sensor_snapshot_t;
+
 /*******************************************************************************
  * Function Prototypes
 *******************************************************************************/
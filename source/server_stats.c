@@ -0,0 +1,329 @@
+/******************************************************************************
+* File Name: server_stats.c
+*
+* Description: This file contains the heap and transmit statistics of the
+*              web server. The heap is sampled by the server task and after
+*              every response, and the payload written to the response streams
+*              is split between the bytes sent straight from flash and the
+*              bytes which had to be staged in a RAM buffer first. Together
+*              they show the memory cost of serving several clients at once.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "server_stats.h"
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#include <malloc.h>
+#endif
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Statistics, updated inside critical sections. */
+static server_stats_t stats;
+
+/* Tick counts of the last response of the SoftAP server and of the first
+ * response of the STA server, from which the handover gap is measured.
+ */
+static TickType_t last_ap_response;
+static TickType_t first_sta_response;
+static bool ap_answered = false;
+static bool sta_answered = false;
+
+#if (configUSE_TRACE_FACILITY == 1)
+/* State of the tasks, filled in with the scheduler suspended. */
+static TaskStatus_t task_status[SERVER_STATS_MAX_TASKS];
+#endif /* #if (configUSE_TRACE_FACILITY == 1) */
+
+/*******************************************************************************
+* Function Name: server_stats_sample_heap
+********************************************************************************
+* Summary:
+*  Samples the heap usage and updates the peak. The heap is only inspected
+*  with the newlib allocator used by the GCC toolchain; with the other
+*  toolchains the heap figures stay at 0.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void server_stats_sample_heap(void)
+{
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+    struct mallinfo heap = mallinfo();
+
+    taskENTER_CRITICAL();
+    stats.heap_used = (uint32_t)heap.uordblks;
+    stats.heap_arena = (uint32_t)heap.arena;
+    if (stats.heap_used > stats.heap_peak)
+    {
+        stats.heap_peak = stats.heap_used;
+    }
+    taskEXIT_CRITICAL();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: server_stats_add_sent
+********************************************************************************
+* Summary:
+*  Accounts for payload written to a response stream.
+*
+* Parameters:
+*  length - Number of bytes written.
+*  by_reference - true if the bytes were written straight from flash, false
+*                 if they were staged in a RAM buffer.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void server_stats_add_sent(uint32_t length, bool by_reference)
+{
+    taskENTER_CRITICAL();
+    if (by_reference)
+    {
+        stats.sent_by_reference += length;
+    }
+    else
+    {
+        stats.sent_buffered += length;
+        if (length > stats.buffer_peak)
+        {
+            stats.buffer_peak = length;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: server_stats_reset_peaks
+********************************************************************************
+* Summary:
+*  Restarts the peak measurements from the current heap usage, so the peak of
+*  a given load can be measured.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void server_stats_reset_peaks(void)
+{
+    taskENTER_CRITICAL();
+    stats.heap_peak = stats.heap_used;
+    stats.buffer_peak = 0;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: server_stats_set_handover
+********************************************************************************
+* Summary:
+*  Records the timing of the handover from the SoftAP server to the STA
+*  server.
+*
+* Parameters:
+*  listen_msec - Time from the start of the handover until the STA server
+*                was listening.
+*  overlap_msec - Time both servers were listening.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void server_stats_set_handover(uint32_t listen_msec, uint32_t overlap_msec)
+{
+    taskENTER_CRITICAL();
+    stats.handover_listen_msec = listen_msec;
+    stats.handover_overlap_msec = overlap_msec;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: server_stats_add_response
+********************************************************************************
+* Summary:
+*  Records a response sent by one of the HTTP servers. The handover gap is
+*  the time from the last response of the SoftAP server to the first
+*  response of the STA server, that is the time the clients went without an
+*  answer, and is 0 if the SoftAP server answered after the STA server had
+*  or never answered at all, as after a fast boot.
+*
+* Parameters:
+*  sta_server - true if the response was sent by the STA server.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void server_stats_add_response(bool sta_server)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+    if (!sta_server)
+    {
+        last_ap_response = now;
+        ap_answered = true;
+    }
+    else if (!sta_answered)
+    {
+        first_sta_response = now;
+        sta_answered = true;
+        if (ap_answered && ((int32_t)(first_sta_response - last_ap_response) > 0))
+        {
+            stats.handover_gap_msec = (uint32_t)(first_sta_response - last_ap_response) * portTICK_PERIOD_MS;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: server_stats_get
+********************************************************************************
+* Summary:
+*  Takes a consistent copy of the statistics.
+*
+* Parameters:
+*  copy - Pointer to the structure that receives the statistics.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void server_stats_get(server_stats_t *copy)
+{
+    taskENTER_CRITICAL();
+    *copy = stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: write_stacks_json
+********************************************************************************
+* Summary:
+*  Writes the stack high-water mark of every task, that is the smallest
+*  amount of free stack the task has had, in bytes, as a JSON object keyed by
+*  the task name. The object is empty if the state of the tasks cannot be
+*  read.
+*
+* Parameters:
+*  builder - Builder the object is written to.
+*
+* Return:
+*  bool - true if the object was accepted.
+*
+*******************************************************************************/
+static bool write_stacks_json(response_builder_t *builder)
+{
+#if (configUSE_TRACE_FACILITY == 1)
+    UBaseType_t count;
+
+    response_builder_append_string(builder, "{");
+
+    /* task_status is shared by the servers, keep the other tasks out while
+     * it is filled in and written.
+     */
+    vTaskSuspendAll();
+    count = uxTaskGetSystemState(task_status, SERVER_STATS_MAX_TASKS, NULL);
+    for (UBaseType_t index = 0; index < count; index++)
+    {
+        response_builder_append_string(builder, (index == 0) ? "\"" : ",\"");
+        response_builder_append_string(builder, task_status[index].pcTaskName);
+        response_builder_append_string(builder, "\":");
+        response_builder_append_uint(builder, (uint32_t)task_status[index].usStackHighWaterMark * sizeof(StackType_t));
+    }
+    (void)xTaskResumeAll();
+
+    return response_builder_append_string(builder, "}");
+#else
+    return response_builder_append_string(builder, "{}");
+#endif /* #if (configUSE_TRACE_FACILITY == 1) */
+}
+
+/*******************************************************************************
+* Function Name: server_stats_write_json
+********************************************************************************
+* Summary:
+*  Writes the statistics as the members of a JSON object, without the braces,
+*  so the caller can add members of its own.
+*
+* Parameters:
+*  builder - Builder the members are written to.
+*
+* Return:
+*  bool - true if all of the members were accepted.
+*
+*******************************************************************************/
+bool server_stats_write_json(response_builder_t *builder)
+{
+    server_stats_t copy;
+
+    server_stats_sample_heap();
+    server_stats_get(&copy);
+
+    response_builder_append_string(builder, "\"heap_used\":");
+    response_builder_append_uint(builder, copy.heap_used);
+    response_builder_append_string(builder, ",\"heap_peak\":");
+    response_builder_append_uint(builder, copy.heap_peak);
+    response_builder_append_string(builder, ",\"heap_arena\":");
+    response_builder_append_uint(builder, copy.heap_arena);
+    response_builder_append_string(builder, ",\"sent_by_reference\":");
+    response_builder_append_uint(builder, copy.sent_by_reference);
+    response_builder_append_string(builder, ",\"sent_buffered\":");
+    response_builder_append_uint(builder, copy.sent_buffered);
+    response_builder_append_string(builder, ",\"buffer_peak\":");
+    response_builder_append_uint(builder, copy.buffer_peak);
+    response_builder_append_string(builder, ",\"handover_listen_msec\":");
+    response_builder_append_uint(builder, copy.handover_listen_msec);
+    response_builder_append_string(builder, ",\"handover_overlap_msec\":");
+    response_builder_append_uint(builder, copy.handover_overlap_msec);
+    response_builder_append_string(builder, ",\"handover_gap_msec\":");
+    response_builder_append_uint(builder, copy.handover_gap_msec);
+    response_builder_append_string(builder, ",\"stack_free\":");
+    return write_stacks_json(builder);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name: server_stats.h
+*
+* Description: This file contains the structure and function prototypes of the
+*              heap and transmit statistics reported by the /api/stats
+*              resource.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SERVER_STATS_H_
+#define SERVER_STATS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "response_builder.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of tasks whose stack high-water mark is reported. */
+#define SERVER_STATS_MAX_TASKS                       (20u)
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    heap_used;          /* Bytes allocated from the heap */
+    uint32_t    heap_peak;          /* Largest heap_used seen since the last reset */
+    uint32_t    heap_arena;         /* Bytes obtained by the allocator from the system */
+    uint32_t    sent_by_reference;  /* Payload bytes written straight from flash */
+    uint32_t    sent_buffered;      /* Payload bytes written from a RAM buffer */
+    uint32_t    buffer_peak;        /* Largest RAM buffer written in one go */
+    uint32_t    handover_listen_msec;   /* Time until the STA server was listening */
+    uint32_t    handover_overlap_msec;  /* Time both servers were listening */
+    uint32_t    handover_gap_msec;      /* Time from the last SoftAP response to the first STA response */
+} server_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void server_stats_sample_heap(void);
+void server_stats_add_sent(uint32_t length, bool by_reference);
+void server_stats_reset_peaks(void);
+void server_stats_set_handover(uint32_t listen_msec, uint32_t overlap_msec);
+void server_stats_add_response(bool sta_server);
+void server_stats_get(server_stats_t *stats);
+bool server_stats_write_json(response_builder_t *builder);
+
+#endif /* SERVER_STATS_H_ */
+
+/* [] END OF FILE */
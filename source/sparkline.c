@@ -0,0 +1,290 @@
+/******************************************************************************
+* File Name: sparkline.c
+*
+* Description: This file contains the sparkline showing the recent light
+*              sensor voltage and PWM duty cycle on the TFT display. The graph
+*              is drawn in sweep mode: each new sample draws only its own
+*              column and clears a small gap ahead of it, so the cost of a
+*              frame does not depend on the width of the graph.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+
+#ifdef ENABLE_TFT
+
+#include "sparkline.h"
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Top left corner of the graph on the display. */
+static uint16_t sparkline_x0;
+static uint16_t sparkline_y0;
+
+/* Pixel offsets of the samples from the top of the graph, one per column. */
+static uint8_t light_y[SPARKLINE_WIDTH];
+static uint8_t duty_y[SPARKLINE_WIDTH];
+
+/* Column of the next sample. */
+static uint16_t sparkline_cursor = 0;
+
+/* Number of columns holding a sample. */
+static uint16_t sparkline_count = 0;
+
+/*******************************************************************************
+* Function Name: sparkline_scale
+********************************************************************************
+* Summary:
+*  Converts a value to a pixel offset from the top of the graph.
+*
+* Parameters:
+*  value - Value to be plotted.
+*  max_value - Value plotted at the top of the graph.
+*
+* Return:
+*  uint8_t - Offset in pixels from the top of the graph.
+*
+*******************************************************************************/
+static uint8_t sparkline_scale(uint32_t value, uint32_t max_value)
+{
+    if (value > max_value)
+    {
+        value = max_value;
+    }
+
+    return (uint8_t)((SPARKLINE_HEIGHT - 1) - ((value * (SPARKLINE_HEIGHT - 1)) / max_value));
+}
+
+/*******************************************************************************
+* Function Name: sparkline_draw_column
+********************************************************************************
+* Summary:
+*  Draws the sample at the given column, joined to the sample on its left.
+*
+* Parameters:
+*  x - Column of the sample.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sparkline_draw_column(uint16_t x)
+{
+    uint16_t x_screen = sparkline_x0 + x;
+
+    GUI_SetColor(SPARKLINE_LIGHT_COLOR);
+    if (x == 0)
+    {
+        GUI_DrawPixel(x_screen, sparkline_y0 + light_y[x]);
+    }
+    else
+    {
+        GUI_DrawLine(x_screen - 1, sparkline_y0 + light_y[x - 1], x_screen, sparkline_y0 + light_y[x]);
+    }
+
+    GUI_SetColor(SPARKLINE_DUTY_COLOR);
+    if (x == 0)
+    {
+        GUI_DrawPixel(x_screen, sparkline_y0 + duty_y[x]);
+    }
+    else
+    {
+        GUI_DrawLine(x_screen - 1, sparkline_y0 + duty_y[x - 1], x_screen, sparkline_y0 + duty_y[x]);
+    }
+
+    GUI_SetColor(GUI_WHITE);
+}
+
+/*******************************************************************************
+* Function Name: sparkline_init
+********************************************************************************
+* Summary:
+*  Places the graph on the display and clears its area.
+*
+* Parameters:
+*  x0 - Left edge of the graph.
+*  y0 - Top edge of the graph.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sparkline_init(uint16_t x0, uint16_t y0)
+{
+    sparkline_x0 = x0;
+    sparkline_y0 = y0;
+    sparkline_cursor = 0;
+    sparkline_count = 0;
+
+    GUI_ClearRect(sparkline_x0, sparkline_y0,
+                  sparkline_x0 + SPARKLINE_WIDTH - 1, sparkline_y0 + SPARKLINE_HEIGHT - 1);
+}
+
+/*******************************************************************************
+* Function Name: sparkline_add
+********************************************************************************
+* Summary:
+*  Adds a sample to the graph. Only the column of the new sample and the gap
+*  ahead of it are drawn; the cursor wraps to the left edge once it reaches
+*  the right edge of the graph.
+*
+* Parameters:
+*  light_sensor_voltage - Light sensor voltage in mV.
+*  duty - PWM duty cycle in percent.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sparkline_add(uint16_t light_sensor_voltage, uint8_t duty)
+{
+    uint16_t x = sparkline_cursor;
+    uint16_t gap_end = x + SPARKLINE_GAP_WIDTH;
+
+    light_y[x] = sparkline_scale(light_sensor_voltage, LIGHTSENSOR_ADC_MAX_VOLTAGE);
+    duty_y[x] = sparkline_scale(duty, MAX_DUTYCYCLE);
+
+    /* Clear the gap ahead of the new sample, it separates the newest sample
+     * from the oldest one still shown.
+     */
+    if (gap_end >= SPARKLINE_WIDTH)
+    {
+        gap_end = SPARKLINE_WIDTH - 1;
+    }
+    if (gap_end > x)
+    {
+        GUI_ClearRect(sparkline_x0 + x + 1, sparkline_y0,
+                      sparkline_x0 + gap_end, sparkline_y0 + SPARKLINE_HEIGHT - 1);
+    }
+    if (x == 0)
+    {
+        GUI_ClearRect(sparkline_x0, sparkline_y0,
+                      sparkline_x0, sparkline_y0 + SPARKLINE_HEIGHT - 1);
+    }
+
+    sparkline_draw_column(x);
+
+    if (sparkline_count < SPARKLINE_WIDTH)
+    {
+        sparkline_count++;
+    }
+    sparkline_cursor = (x + 1) % SPARKLINE_WIDTH;
+}
+
+/*******************************************************************************
+* Function Name: sparkline_redraw
+********************************************************************************
+* Summary:
+*  Clears the graph area and draws every sample again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sparkline_redraw(void)
+{
+    GUI_ClearRect(sparkline_x0, sparkline_y0,
+                  sparkline_x0 + SPARKLINE_WIDTH - 1, sparkline_y0 + SPARKLINE_HEIGHT - 1);
+
+    for (uint16_t x = 0; x < sparkline_count; x++)
+    {
+        if ((sparkline_count == SPARKLINE_WIDTH) &&
+            (x > sparkline_cursor) && (x <= (sparkline_cursor + SPARKLINE_GAP_WIDTH)))
+        {
+            continue;
+        }
+        sparkline_draw_column(x);
+    }
+}
+
+#ifdef SPARKLINE_BENCHMARK
+/*******************************************************************************
+* Function Name: sparkline_benchmark
+********************************************************************************
+* Summary:
+*  Renders SPARKLINE_BENCHMARK_FRAMES frames incrementally and then as full
+*  redraws of a filled graph, and prints the time taken by each method.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sparkline_benchmark(void)
+{
+    TickType_t start;
+    TickType_t incremental_ticks;
+    TickType_t full_ticks;
+
+    for (uint16_t x = 0; x < SPARKLINE_WIDTH; x++)
+    {
+        sparkline_add((x * LIGHTSENSOR_ADC_MAX_VOLTAGE) / SPARKLINE_WIDTH, x % MAX_DUTYCYCLE);
+    }
+
+    start = xTaskGetTickCount();
+    for (uint32_t frame = 0; frame < SPARKLINE_BENCHMARK_FRAMES; frame++)
+    {
+        sparkline_add((frame * 37u) % LIGHTSENSOR_ADC_MAX_VOLTAGE, frame % MAX_DUTYCYCLE);
+    }
+    incremental_ticks = xTaskGetTickCount() - start;
+
+    start = xTaskGetTickCount();
+    for (uint32_t frame = 0; frame < SPARKLINE_BENCHMARK_FRAMES; frame++)
+    {
+        sparkline_redraw();
+    }
+    full_ticks = xTaskGetTickCount() - start;
+
+    APP_INFO(("Sparkline: %u frames, incremental %lu ms, full redraw %lu ms\r\n",
+              SPARKLINE_BENCHMARK_FRAMES,
+              (unsigned long)(incremental_ticks * portTICK_PERIOD_MS),
+              (unsigned long)(full_ticks * portTICK_PERIOD_MS)));
+
+    sparkline_init(sparkline_x0, sparkline_y0);
+}
+#endif /* #ifdef SPARKLINE_BENCHMARK */
+
+#endif /* #ifdef ENABLE_TFT */
+
+/* [] END OF FILE */
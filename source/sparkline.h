@@ -0,0 +1,82 @@
+/******************************************************************************
+* File Name: sparkline.h
+*
+* Description: This file contains the macros and function prototypes of the
+*              light level and duty cycle sparkline drawn on the TFT display.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef SPARKLINE_H_
+#define SPARKLINE_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of samples shown, one column per sample */
+#define SPARKLINE_WIDTH                                 (320u)
+
+/* Height of the graph in pixels */
+#define SPARKLINE_HEIGHT                                (60u)
+
+/* Number of blank columns drawn ahead of the newest sample */
+#define SPARKLINE_GAP_WIDTH                             (4u)
+
+/* Interval in milliseconds between two samples added to the graph */
+#define SPARKLINE_SAMPLE_PERIOD_MSEC                    (1000u)
+
+/* Colours of the light level and duty cycle traces */
+#define SPARKLINE_LIGHT_COLOR                           (GUI_YELLOW)
+#define SPARKLINE_DUTY_COLOR                            (GUI_GREEN)
+
+/* Number of frames rendered by sparkline_benchmark() */
+#define SPARKLINE_BENCHMARK_FRAMES                      (100u)
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void sparkline_init(uint16_t x0, uint16_t y0);
+void sparkline_add(uint16_t light_sensor_voltage, uint8_t duty);
+void sparkline_redraw(void);
+#ifdef SPARKLINE_BENCHMARK
+void sparkline_benchmark(void);
+#endif /* #ifdef SPARKLINE_BENCHMARK */
+
+#endif /* SPARKLINE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/******************************************************************************
+* File Name: template_engine.c
+*
+* Description: This file contains the renderer for the page templates compiled
+*              at build time by scripts/page_templates.py. The constant text of
+*              a page is written to the response stream straight from flash
+*              and only the slot values pass through the response builder, so
+*              a page is never assembled in RAM.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "template_engine.h"
+
+/*******************************************************************************
+* Function Name: template_render
+********************************************************************************
+* Summary:
+*  Writes a page to the response. The constant segments are written as they
+*  are and the slot writer is called for every slot, in page order.
+*
+* Parameters:
+*  page - Page template to be rendered.
+*  builder - Builder the page is written to, normally bound to a stream.
+*  slot_writer - Function writing the slot values, may be NULL if the page
+*                has no slots.
+*  arg - Argument passed to the slot writer.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS if the whole page was written, otherwise the
+*  error reported by response_builder_finish().
+*
+*******************************************************************************/
+cy_rslt_t template_render(const page_template_t *page, response_builder_t *builder,
+                          template_slot_writer_t slot_writer, void *arg)
+{
+    const template_segment_t *segment;
+
+    for (uint8_t index = 0; index < page->segment_count; index++)
+    {
+        segment = &page->segments[index];
+
+        if (segment->text != NULL)
+        {
+            if (!response_builder_append_const(builder, segment->text, segment->length))
+            {
+                break;
+            }
+        }
+        else if ((slot_writer != NULL) && !slot_writer(builder, segment->slot, arg))
+        {
+            break;
+        }
+    }
+
+    return response_builder_finish(builder);
+}
+
+/*******************************************************************************
+* Function Name: template_send
+********************************************************************************
+* Summary:
+*  Writes a page without slots to a response stream. The page is written
+*  straight from flash, so no buffer is needed.
+*
+* Parameters:
+*  page - Page template to be sent.
+*  stream - Response stream the page is written to.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS if the whole page was written, otherwise the
+*  error returned by the stream.
+*
+*******************************************************************************/
+cy_rslt_t template_send(const page_template_t *page, cy_http_response_stream_t *stream)
+{
+    response_builder_t builder;
+
+    response_builder_init(&builder, NULL, 0, stream);
+
+    return template_render(page, &builder, NULL, NULL);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/******************************************************************************
+* File Name: template_engine.h
+*
+* Description: This file contains the structures and function prototypes of
+*              the renderer for the page templates compiled at build time by
+*              scripts/page_templates.py.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef TEMPLATE_ENGINE_H_
+#define TEMPLATE_ENGINE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "response_builder.h"
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+typedef struct
+{
+    const char*     text;       /* Constant text, or NULL for a slot */
+    uint16_t        length;     /* Length of the constant text */
+    uint8_t         slot;       /* Slot filled in by the caller when text is NULL */
+} template_segment_t;
+
+typedef struct
+{
+    const template_segment_t*   segments;
+    uint8_t                     segment_count;
+} page_template_t;
+
+/* Writes the value of a slot to the response. Returns false on failure. */
+typedef bool (*template_slot_writer_t)(response_builder_t *builder, uint8_t slot, void *arg);
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+cy_rslt_t template_render(const page_template_t *page, response_builder_t *builder,
+                          template_slot_writer_t slot_writer, void *arg);
+cy_rslt_t template_send(const page_template_t *page, cy_http_response_stream_t *stream);
+
+#endif /* TEMPLATE_ENGINE_H_ */
+
+/* [] END OF FILE */
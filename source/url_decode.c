@@ -0,0 +1,171 @@
+/******************************************************************************
+* File Name: url_decode.c
+*
+* Description: This file contains the decoder of URL encoded text, such as
+*              the values of query parameters. Escapes are decoded through a
+*              table of hexadecimal digit values, and runs of bytes without
+*              '%' or '+' are copied a machine word at a time. Both the
+*              source and the destination are bounded by explicit lengths.
+*              The decoder has no dependency on the platform, so it can be
+*              built on the host by scripts/url_decode_bench.py.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "url_decode.h"
+
+/* Standard C header file */
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A machine word with every byte set to 0x01, and to 0x80 */
+#define URL_WORD_ONES                                ((size_t)-1 / 0xFFu)
+#define URL_WORD_HIGHS                               (URL_WORD_ONES * 0x80u)
+
+/* Non-zero if a byte of the word is zero */
+#define URL_WORD_HAS_ZERO(word)                      (((word) - URL_WORD_ONES) & ~(word) & URL_WORD_HIGHS)
+
+/* Non-zero if a byte of the word is equal to byte */
+#define URL_WORD_HAS_BYTE(word, byte)                URL_WORD_HAS_ZERO((word) ^ (URL_WORD_ONES * (uint8_t)(byte)))
+
+/* Shorthand of URL_HEX_INVALID in the table of digit values */
+#define XX                                           URL_HEX_INVALID
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+const uint8_t url_hex_digit_values[256] =
+{
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u, XX, XX, XX, XX, XX, XX,
+    XX, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX
+};
+
+#undef XX
+
+/*******************************************************************************
+* Function Name: url_decode
+********************************************************************************
+* Summary:
+*  Decodes URL encoded text: "+" becomes a space and "%" followed by two
+*  hexadecimal digits becomes the byte they encode. A "%" which is not
+*  followed by two hexadecimal digits is copied as it is. The decoded text is
+*  NUL terminated.
+*
+* Parameters:
+*  dst - Destination buffer.
+*  dst_length - Size of the destination buffer, including the NUL.
+*  src - URL encoded text, which need not be NUL terminated.
+*  src_length - Length of the encoded text in bytes.
+*
+* Return:
+*  size_t - Length of the decoded text, or URL_DECODE_OVERFLOW if it does not
+*  fit in the destination buffer.
+*
+*******************************************************************************/
+size_t url_decode(uint8_t *dst, size_t dst_length, const uint8_t *src, size_t src_length)
+{
+    size_t src_index = 0;
+    size_t dst_index = 0;
+    size_t word;
+    uint8_t high;
+    uint8_t low;
+
+    if (dst_length == 0u)
+    {
+        return URL_DECODE_OVERFLOW;
+    }
+
+    while (src_index < src_length)
+    {
+        /* Copy the words with neither '%' nor '+' as they are */
+        while (((src_length - src_index) >= sizeof(word)) && ((dst_length - dst_index) > sizeof(word)))
+        {
+            memcpy(&word, &src[src_index], sizeof(word));
+            if (URL_WORD_HAS_BYTE(word, '%') || URL_WORD_HAS_BYTE(word, '+'))
+            {
+                break;
+            }
+            memcpy(&dst[dst_index], &word, sizeof(word));
+            src_index += sizeof(word);
+            dst_index += sizeof(word);
+        }
+        if (src_index == src_length)
+        {
+            break;
+        }
+
+        if ((dst_length - dst_index) <= 1u)
+        {
+            dst[dst_index] = '\0';
+            return URL_DECODE_OVERFLOW;
+        }
+
+        if ((src[src_index] == '%') && ((src_length - src_index) > 2u) &&
+            ((high = url_hex_digit_values[src[src_index + 1u]]) != URL_HEX_INVALID) &&
+            ((low = url_hex_digit_values[src[src_index + 2u]]) != URL_HEX_INVALID))
+        {
+            dst[dst_index++] = (uint8_t)((high << 4) | low);
+            src_index += 3u;
+        }
+        else if (src[src_index] == '+')
+        {
+            dst[dst_index++] = ' ';
+            src_index++;
+        }
+        else
+        {
+            dst[dst_index++] = src[src_index++];
+        }
+    }
+
+    dst[dst_index] = '\0';
+    return dst_index;
+}
+
+/* [] END OF FILE */
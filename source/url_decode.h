@@ -0,0 +1,72 @@
+/******************************************************************************
+* File Name: url_decode.h
+*
+* Description: This file contains the macros and function prototypes of the
+*              length-bounded decoder of URL encoded text and of the table of
+*              hexadecimal digit values it shares with the form parser.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef URL_DECODE_H_
+#define URL_DECODE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Value of url_hex_digit_values for a byte which is not a hex digit. */
+#define URL_HEX_INVALID                              (0xFFu)
+
+/* Returned by url_decode when the decoded text does not fit. */
+#define URL_DECODE_OVERFLOW                          ((size_t)-1)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Value of every byte as a hexadecimal digit, or URL_HEX_INVALID. */
+extern const uint8_t url_hex_digit_values[256];
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+size_t url_decode(uint8_t *dst, size_t dst_length, const uint8_t *src, size_t src_length);
+
+#endif /* URL_DECODE_H_ */
+
+/* [] END OF FILE */
@@ -49,6 +49,7 @@
 /* FreeRTOS header file */
 #include <FreeRTOS.h>
 #include <task.h>
+#include <semphr.h>
 
 /* Secure Sockets header file */
 #include "cy_secure_sockets.h"
@@ -69,7 +70,6 @@
 
 /* HTTP server task header file. */
 #include "cy_http_server.h"
-#include "html_web_page.h"
 #include "web_server.h"
 
 /*******************************************************************************
@@ -117,40 +117,69 @@ const mtb_st7789v_pins_t tft_pins =
 /* Holds the IP address and port number details of the socket for the HTTP server. */
 cy_socket_sockaddr_t http_server_ip_address;
 
-/* Pointer to HTTP event stream used to send device data to client. */
-cy_http_response_stream_t* http_event_stream;
-
 /* Wi-Fi network interface. */
 cy_network_interface_t nw_interface;
 
+/* Socket address and network interface of the STA server, which is created
+ * while the SoftAP server still uses its own.
+ */
+cy_socket_sockaddr_t http_sta_server_ip_address;
+cy_network_interface_t sta_nw_interface;
+
 /* HTTP server instance. */
 cy_http_server_t http_ap_server;
 
 /* HTTP server instance. */
 cy_http_server_t http_sta_server;
 
-/*Buffer to store SSID*/
-uint8_t wifi_ssid[WIFI_SSID_LEN] = {0};
+/*Buffer to store SSID, a byte longer than the longest SSID so that it is
+ * always NUL terminated when displayed.
+ */
+uint8_t wifi_ssid[WIFI_SSID_LEN + 1u] = {0};
 
 /*Buffer to store Password*/
 uint8_t wifi_pwd[WIFI_PWD_LEN] = {0}; 
 
-/*Buffer to store HTTP data*/
-char buffer[BUFFER_LENGTH] = {0};
+/* Buffers used only while the device is provisioned over the SoftAP,
+ * allocated from the provisioning arena. NULL once the arena has been handed
+ * over to the sensor history, when the SoftAP server is gone.
+ */
+static provisioning_state_t *provisioning = NULL;
+
+/* The provisioning state is the only block allocated from the arena. */
+_Static_assert(sizeof(provisioning_state_t) <= PROVISIONING_ARENA_SIZE,
+               "provisioning_state_t does not fit in the provisioning arena");
 
-/* Holds the response handler for HTTP GET and POST request from the client 
-* to implement Wi-Fi scan and Wi-Fi connect funtionality. 
-*/
-cy_resource_dynamic_data_t http_wifi_resource;
+/* Stream whose credentials form is being received, NULL between forms, and
+ * the number of bytes of the form still to come on it.
+ */
+static cy_http_response_stream_t *credentials_stream = NULL;
+static uint32_t credentials_remaining = 0;
 
 /* Flag to indicate if scan has completed.*/
 volatile bool scan_complete_flag = false;
 
+/* Set while scan_for_available_aps waits for its scan. */
+static volatile bool scan_running = false;
+
 /* Flag to indicate if device has been configured. */
 volatile bool device_configured = false;
 
-/* Buffer to store ssid  */
-static char ssid_buff[BUFFER_LENGTH];
+/* Set while http_ap_server is running, which it does not after a fast boot. */
+static bool http_ap_server_running = false;
+
+/* Telemetry event sent to the event streams of the device data page. */
+static char telemetry_frame[TELEMETRY_FRAME_LENGTH];
+
+/* Buffer in which the server statistics are assembled, kept off the stacks
+ * of the HTTP server threads, and the mutex guarding it as both servers may
+ * answer /api/stats at once during the handover.
+ */
+static char stats_response[STATS_RESPONSE_LENGTH];
+static SemaphoreHandle_t stats_response_mutex = NULL;
+static StaticSemaphore_t stats_response_mutex_buffer;
+_Static_assert(sizeof(stats_response_mutex_buffer) == STATS_MUTEX_MEMORY,
+               "STATS_MUTEX_MEMORY does not match the storage of the statistics mutex");
 
 /*Variable to indicate re-configuration request*/
 volatile int8_t reconfiguration_request = 0;
@@ -161,17 +190,12 @@ volatile bool increase_pwm = false;
 /* Flag to indicate status of decrease pwm value command. */
 volatile bool decrease_pwm = false;
 
-/* Array to store Wi-Fi connect response. */
-static char http_wifi_connect_response[WIFI_CONNECT_RESPONSE_LENGTH] = {0};
-
-/* Array to store Wi-Fi scan response. */
-static char http_scan_response[MAX_WIFI_SCAN_HTTP_RESPONSE_LENGTH] = {0};
-
 /*******************************************************************************
  * Function Name: process_sse_handler
  *******************************************************************************
  * Summary:
- *  Handler for enabling server sent events
+ *  Handler for enabling server sent events. The server task sends the device
+ *  data to all of the event streams recorded by the connection manager.
  *
  * Parameters:
  *  url_path - Pointer to the HTTP URL path.
@@ -191,14 +215,11 @@ int32_t process_sse_handler( const char* url_path, const char* url_parameters,
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
 
-    /* Assign the incoming stream to http_event_stream pointer */
-    http_event_stream = stream;
-
     /* Enable chunked transfer encoding on the HTTP stream */
-    result = cy_http_server_response_stream_enable_chunked_transfer( http_event_stream );
+    result = cy_http_server_response_stream_enable_chunked_transfer( stream );
     PRINT_AND_ASSERT(result, "HTTP server event failed to enable chunked transfer\r\n");
 
-    result = cy_http_server_response_stream_write_header( http_event_stream, CY_HTTP_200_TYPE,
+    result = cy_http_server_response_stream_write_header( stream, CY_HTTP_200_TYPE,
                                                 CHUNKED_CONTENT_LENGTH, CY_HTTP_CACHE_DISABLED,
                                                 MIME_TYPE_TEXT_EVENT_STREAM );
     PRINT_AND_ASSERT(result, "HTTP server event failed to write stream header\r\n");
@@ -207,15 +228,91 @@ int32_t process_sse_handler( const char* url_path, const char* url_parameters,
 }
 
 /*******************************************************************************
- * Function Name: softap_resource_handler
+ * Function Name: get_query_uint
+ *******************************************************************************
+ * Summary:
+ *  Reads an unsigned decimal value from the URL query string.
+ *
+ * Parameters:
+ *  url_parameters - Pointer to the HTTP URL query string.
+ *  key - Name of the query parameter.
+ *  value - Pointer to the variable that receives the value.
+ *
+ * Return:
+ *  bool - true if the parameter is present and holds a valid number.
+ *
+ *******************************************************************************/
+static bool get_query_uint(const char *url_parameters, const char *key, uint32_t *value)
+{
+    char *parameter_value = NULL;
+    uint32_t value_length = 0;
+    uint32_t parsed_value = 0;
+
+    if ((url_parameters == NULL) ||
+        (CY_RSLT_SUCCESS != cy_http_server_get_query_parameter_value(url_parameters, key, &parameter_value, &value_length)) ||
+        (value_length == 0) || (value_length > QUERY_VALUE_MAX_DIGITS))
+    {
+        return false;
+    }
+
+    for (uint32_t index = 0; index < value_length; index++)
+    {
+        if (!isdigit((unsigned char)parameter_value[index]))
+        {
+            return false;
+        }
+        parsed_value = (parsed_value * 10) + (parameter_value[index] - '0');
+    }
+
+    *value = parsed_value;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: format_history_record
  *******************************************************************************
  * Summary:
- *  Handles HTTP GET, POST, and PUT requests from the client.
- *  HTTP GET sends the HTTP startup webpage as a response to the client.
- *  HTTP POST extracts the credentials from the HTTP data from the client 
- *  and tries to connect to the AP.
- *  HTTP PUT sends an error message as a response to the client if the resource
- *  registration is unsuccessful.
+ *  Formats a history record as a CSV line or an NDJSON object.
+ *
+ * Parameters:
+ *  dst - Buffer of at least EXPORT_RECORD_LENGTH bytes.
+ *  record - Pointer to the history record.
+ *  ndjson - true for NDJSON output, false for CSV output.
+ *
+ * Return:
+ *  size_t - Number of characters written, excluding the terminating NULL.
+ *
+ *******************************************************************************/
+static size_t format_history_record(char *dst, const history_record_t *record, bool ndjson)
+{
+    size_t length = 0;
+
+    format_append(dst, EXPORT_RECORD_LENGTH, &length, ndjson ? EXPORT_NDJSON_TIME : "");
+    format_append_uint(dst, EXPORT_RECORD_LENGTH, &length, record->timestamp);
+#ifdef ENABLE_TFT
+    format_append(dst, EXPORT_RECORD_LENGTH, &length, ndjson ? EXPORT_NDJSON_LIGHT_SENSOR : ",");
+    format_append_uint(dst, EXPORT_RECORD_LENGTH, &length, record->light_sensor_voltage);
+#endif /* #ifdef ENABLE_TFT */
+    format_append(dst, EXPORT_RECORD_LENGTH, &length, ndjson ? EXPORT_NDJSON_DUTY_CYCLE : ",");
+    format_append_uint(dst, EXPORT_RECORD_LENGTH, &length, record->duty);
+    format_append(dst, EXPORT_RECORD_LENGTH, &length, ndjson ? EXPORT_NDJSON_END : "\n");
+
+    return length;
+}
+
+/*******************************************************************************
+ * Function Name: process_export_handler
+ *******************************************************************************
+ * Summary:
+ *  Streams the recorded sensor history to the client using chunked transfer
+ *  encoding. The records are collected by a response builder over a fixed
+ *  EXPORT_CHUNK_LENGTH buffer which is sent every time it fills up, so the
+ *  memory needed does not depend on the number of records exported.
+ *
+ *  Supported query parameters:
+ *   format - "csv" (default) or "ndjson".
+ *   from   - Oldest record to export, in seconds since boot.
+ *   to     - Newest record to export, in seconds since boot.
  *
  * Parameters:
  *  url_path - Pointer to the HTTP URL path.
@@ -229,102 +326,226 @@ int32_t process_sse_handler( const char* url_path, const char* url_parameters,
  *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
  *
  *******************************************************************************/
-int32_t softap_resource_handler(const char *url_path,
-                                 const char *url_parameters,
-                                 cy_http_response_stream_t *stream,
-                                 void *arg,
-                                 cy_http_message_body_t *http_message_body)
+int32_t process_export_handler( const char* url_path, const char* url_parameters,
+                                cy_http_response_stream_t* stream, void* arg,
+                                cy_http_message_body_t* http_message_body )
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
-    int32_t status = HTTP_REQUEST_HANDLE_SUCCESS;
+    char chunk[EXPORT_CHUNK_LENGTH];
+    char record_buffer[EXPORT_RECORD_LENGTH];
+    response_builder_t builder;
+    char *format = NULL;
+    uint32_t format_length = 0;
+    bool ndjson = false;
+    uint32_t from = 0;
+    uint32_t to = UINT32_MAX;
+    uint32_t record_count;
+    history_record_t record;
+
+    if ((url_parameters != NULL) &&
+        (CY_RSLT_SUCCESS == cy_http_server_get_query_parameter_value(url_parameters, "format", &format, &format_length)))
+    {
+        ndjson = ((format_length == (sizeof(EXPORT_FORMAT_NDJSON) - 1)) &&
+                  (!strncmp(format, EXPORT_FORMAT_NDJSON, format_length)));
+    }
+    get_query_uint(url_parameters, "from", &from);
+    get_query_uint(url_parameters, "to", &to);
+
+    result = cy_http_server_response_stream_enable_chunked_transfer(stream);
+    PRINT_AND_ASSERT(result, "HTTP server export failed to enable chunked transfer\r\n");
+
+    result = cy_http_server_response_stream_write_header(stream, CY_HTTP_200_TYPE,
+                                                CHUNKED_CONTENT_LENGTH, CY_HTTP_CACHE_DISABLED,
+                                                ndjson ? MIME_TYPE_JSON : MIME_TYPE_TEXT_PLAIN);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("HTTP server export failed to write stream header\r\n"));
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
 
-    switch (http_message_body->request_type)
+    response_builder_init(&builder, chunk, sizeof(chunk), stream);
+    if (!ndjson)
     {
-    case CY_HTTP_REQUEST_GET:
+        response_builder_append(&builder, EXPORT_CSV_HEADER, sizeof(EXPORT_CSV_HEADER) - 1);
+    }
 
-        /* If device is not configured send the initial page */
-        if(!device_configured)
+    record_count = history_get_count();
+    for (uint32_t index = 0; index < record_count; index++)
+    {
+        if (!history_get_record(index, &record) || (record.timestamp > to))
         {
-            /* The start up page of the HTTP client will be sent as an initial response
-             * to the GET request.
-             */
-            result = cy_http_server_response_stream_write_payload(stream, HTTP_SOFTAP_STARTUP_WEBPAGE, sizeof(HTTP_SOFTAP_STARTUP_WEBPAGE) - 1);
-            if (CY_RSLT_SUCCESS != result)
-            {
-                ERR_INFO(("Failed to send the HTTP GET response.\r\n"));
-            }
+            break;
         }
-        else
+        if (record.timestamp < from)
         {
-            /* Send the data of the device */
-            result = cy_http_server_response_stream_write_payload(stream, SOFTAP_DEVICE_DATA, sizeof(SOFTAP_DEVICE_DATA) - 1);
-            if (CY_RSLT_SUCCESS != result)
-            {
-                ERR_INFO(("Failed to send the HTTP GET response.\n"));
-            }
+            continue;
         }
-        break;
-
-    case CY_HTTP_REQUEST_POST:
 
-        if(!device_configured)
+        if (!response_builder_append(&builder, record_buffer,
+                                     format_history_record(record_buffer, &record, ndjson)))
         {
-            /* The device tries to connect to the AP using the credentials sent via HTTP
-             * webpage.
-             */
-            result = wifi_extract_credentials(http_message_body->data, http_message_body->data_length,stream);
+            break;
         }
-        else
-        {
-            /* Compare the input from client to increase or decrease pwm value. */
-            if(!strncmp((char *)http_message_body->data, INCREASE, 8))
-            {
-                increase_pwm = true;
-            }
-            else if(!strncmp((char *)http_message_body->data, DECREASE, 8))
-            {
-                decrease_pwm = true;
-            }
+    }
 
-            /* Send the HTTP response. */
-            result = cy_http_server_response_stream_write_payload(stream, HTTP_HEADER_204, sizeof(HTTP_HEADER_204) - 1);
-            if (CY_RSLT_SUCCESS != result)
-            {
-                ERR_INFO(("Failed to send the HTTP POST response.\n"));
-            }
-        }
-    break;
+    result = response_builder_finish(&builder);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("Failed to write the history export\r\n"));
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
 
-    default:
-        ERR_INFO(("Received invalid HTTP request method. Supported HTTP methods are GET, POST, and PUT.\n"));
-        
-        break;
+    return HTTP_REQUEST_HANDLE_SUCCESS;
+}
 
+/*******************************************************************************
+ * Function Name: send_fixed_length_response
+ *******************************************************************************
+ * Summary:
+ *  Sends a "200 OK" response with a Content-Length header from a raw resource
+ *  handler. Unlike a chunked response, the client knows where the response
+ *  ends without waiting for the terminating chunk, and keeps the connection
+ *  open for the next request.
+ *
+ * Parameters:
+ *  stream - Pointer to the HTTP response stream.
+ *  content_type - MIME type of the body.
+ *  body - Body of the response.
+ *  length - Length of the body in bytes.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, or the error returned by the stream.
+ *
+ *******************************************************************************/
+static cy_rslt_t send_fixed_length_response(cy_http_response_stream_t *stream, const char *content_type,
+                                            const char *body, size_t length)
+{
+    char header[HTTP_HEADER_LENGTH];
+    response_builder_t builder;
+
+    response_builder_init(&builder, header, sizeof(header), stream);
+    response_builder_append_string(&builder, "HTTP/1.1 200 OK\r\nContent-Type: ");
+    response_builder_append_string(&builder, content_type);
+    response_builder_append_string(&builder, "\r\nCache-Control: no-store\r\nContent-Length: ");
+    response_builder_append_uint(&builder, length);
+    response_builder_append_string(&builder, "\r\n" HTTP_CONNECTION_HEADERS "\r\n");
+    response_builder_append(&builder, body, length);
+
+    return response_builder_finish(&builder);
+}
+
+/*******************************************************************************
+ * Function Name: process_stats_handler
+ *******************************************************************************
+ * Summary:
+ *  Sends the server statistics as a JSON object: the current and peak heap
+ *  usage, the payload bytes sent straight from flash against the bytes
+ *  staged in RAM buffers, and the stack high-water mark of every task. With
+ *  the query parameter "reset=1" the peaks are restarted after the response
+ *  has been built, so the peak of a given load can be measured. The response
+ *  is assembled in a static buffer, taken for the length of the request.
+ *
+ * Parameters:
+ *  url_path - Pointer to the HTTP URL path.
+ *  url_parameters - Pointer to the HTTP URL query string.
+ *  stream - Pointer to the HTTP response stream.
+ *  arg - Pointer to the argument passed during HTTP resource registration.
+ *  http_message_body - Pointer to the HTTP data from the client.
+ *
+ * Return:
+ *  int32_t - Returns HTTP_REQUEST_HANDLE_SUCCESS if the request from the client
+ *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
+ *
+ *******************************************************************************/
+int32_t process_stats_handler( const char* url_path, const char* url_parameters,
+                               cy_http_response_stream_t* stream, void* arg,
+                               cy_http_message_body_t* http_message_body )
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    response_builder_t builder;
+    uint32_t reset = 0;
+
+    xSemaphoreTake(stats_response_mutex, portMAX_DELAY);
+
+    /* The body is assembled first, so it can be sent with its length */
+    response_builder_init(&builder, stats_response, sizeof(stats_response), NULL);
+    response_builder_append_string(&builder, "{");
+    server_stats_write_json(&builder);
+    response_builder_append_string(&builder, ",");
+    connection_manager_write_json(&builder);
+    response_builder_append_string(&builder, ",");
+    rate_limiter_write_json(&builder);
+    response_builder_append_string(&builder, ",");
+    wifi_link_write_json(&builder);
+    response_builder_append_string(&builder, ",");
+    boot_timeline_write_json(&builder);
+    response_builder_append_string(&builder, "}\n");
+
+    if (get_query_uint(url_parameters, "reset", &reset) && (reset != 0))
+    {
+        server_stats_reset_peaks();
+    }
+
+    result = response_builder_finish(&builder);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = send_fixed_length_response(stream, "application/json", stats_response, builder.length);
     }
+    xSemaphoreGive(stats_response_mutex);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("Failed to write the server statistics\r\n"));
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
+
+    return HTTP_REQUEST_HANDLE_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: write_page_header
+ *******************************************************************************
+ * Summary:
+ *  Writes the header of an HTML page sent by a raw resource handler, which
+ *  unlike the dynamic resources is not written by the HTTP server.
+ *
+ * Parameters:
+ *  stream - Pointer to the HTTP response stream.
+ *
+ * Return:
+ *  cy_rslt_t - CY_RSLT_SUCCESS, or the error returned by the stream.
+ *
+ *******************************************************************************/
+static cy_rslt_t write_page_header(cy_http_response_stream_t *stream)
+{
+    cy_rslt_t result;
 
+    result = cy_http_server_response_stream_enable_chunked_transfer(stream);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cy_http_server_response_stream_write_header(stream, CY_HTTP_200_TYPE,
+                                                    CHUNKED_CONTENT_LENGTH, CY_HTTP_CACHE_DISABLED,
+                                                    MIME_TYPE_TEXT_HTML);
+    }
     if (CY_RSLT_SUCCESS != result)
     {
-        status = HTTP_REQUEST_HANDLE_ERROR;
+        ERR_INFO(("Failed to write the page header\r\n"));
     }
 
-    return status;
+    return result;
 }
 
 /*******************************************************************************
- * Function Name: wifi_resource_handler
+ * Function Name: startup_page_handler
  *******************************************************************************
  * Summary:
- *  Handles HTTP GET, POST, and PUT requests from the client.
- *  HTTP GET performs scan for available networks(APs) and sends the list of 
- *  available networks as a response to the client.
- *  HTTP POST extracts the credentials from the HTTP data from the client 
- *  and tries to connect to the AP.
+ *  Handles HTTP GET "/" on the SoftAP server by sending the startup page, on
+ *  which the user enters the credentials of the AP or starts a scan.
  *
  * Parameters:
  *  url_path - Pointer to the HTTP URL path.
  *  url_parameters - Pointer to the HTTP URL query string.
  *  stream - Pointer to the HTTP response stream.
- *  arg - Pointer to the argument passed during HTTP resource registration.
+ *  arg - Unused.
  *  http_message_body - Pointer to the HTTP data from the client.
  *
  * Return:
@@ -332,125 +553,478 @@ int32_t softap_resource_handler(const char *url_path,
  *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
  *
  *******************************************************************************/
-static int32_t wifi_resource_handler(const char *url_path,
-                                     const char *url_parameters,
-                                     cy_http_response_stream_t *stream,
-                                     void *arg,
-                                     cy_http_message_body_t *http_message_body)
+int32_t startup_page_handler(const char *url_path, const char *url_parameters,
+                             cy_http_response_stream_t *stream, void *arg,
+                             cy_http_message_body_t *http_message_body)
 {
-    cy_rslt_t result = CY_RSLT_SUCCESS;
-    int32_t status = HTTP_REQUEST_HANDLE_SUCCESS;
-    
-    switch (http_message_body->request_type)
+    cy_rslt_t result = write_page_header(stream);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = template_send(&page_startup, stream);
+    }
+    if (CY_RSLT_SUCCESS != result)
     {
-    case CY_HTTP_REQUEST_GET:
+        ERR_INFO(("Failed to send the HTTP GET response.\r\n"));
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
 
-        /* Scan for the available networks in response to the HTTP GET request. */
-        scan_for_available_aps(stream);
-        
-        break;
+    return HTTP_REQUEST_HANDLE_SUCCESS;
+}
 
-    case CY_HTTP_REQUEST_POST:
+/*******************************************************************************
+ * Function Name: credentials_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles HTTP POST "/" on the SoftAP server: extracts the credentials from
+ *  the HTTP data from the client and tries to connect to the AP.
+ *
+ * Parameters:
+ *  url_path - Pointer to the HTTP URL path.
+ *  url_parameters - Pointer to the HTTP URL query string.
+ *  stream - Pointer to the HTTP response stream.
+ *  arg - Unused.
+ *  http_message_body - Pointer to the HTTP data from the client.
+ *
+ * Return:
+ *  int32_t - Returns HTTP_REQUEST_HANDLE_SUCCESS if the request from the client
+ *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
+ *
+ *******************************************************************************/
+int32_t credentials_handler(const char *url_path, const char *url_parameters,
+                            cy_http_response_stream_t *stream, void *arg,
+                            cy_http_message_body_t *http_message_body)
+{
+    /* The device tries to connect to the AP using the credentials sent via HTTP
+     * webpage.
+     */
+    cy_rslt_t result = wifi_extract_credentials(http_message_body, stream);
 
-        /* The device tries to connect to the AP using the credentials sent via HTTP
-         * webpage.
-         */
-        result = cy_http_server_response_stream_write_payload(stream, HTTP_DEVICE_DATA_REDIRECT_WEBPAGE, sizeof(HTTP_DEVICE_DATA_REDIRECT_WEBPAGE));
-        if (CY_RSLT_SUCCESS != result)
+    return (CY_RSLT_SUCCESS == result) ? HTTP_REQUEST_HANDLE_SUCCESS : HTTP_REQUEST_HANDLE_ERROR;
+}
+
+/*******************************************************************************
+ * Function Name: scan_page_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles HTTP GET "/wifi_scan_form" on the SoftAP server by sending the
+ *  scan page, which lists the networks (APs) streamed by "/scan_events" as
+ *  the scan finds them. With the query parameter "live=0", sent by browsers
+ *  without server sent events, scans for the available networks and sends
+ *  their list once the scan is complete; this scan is charged to the scan
+ *  budget of the rate limiter, and answered with "503 Service Unavailable"
+ *  while another scan is running. The query parameters "channels", "ssid" or
+ *  "ssid_prefix", and "min_rssi" restrict the scan.
+ *
+ * Parameters:
+ *  url_path - Pointer to the HTTP URL path.
+ *  url_parameters - Pointer to the HTTP URL query string.
+ *  stream - Pointer to the HTTP response stream.
+ *  arg - Unused.
+ *  http_message_body - Pointer to the HTTP data from the client.
+ *
+ * Return:
+ *  int32_t - Returns HTTP_REQUEST_HANDLE_SUCCESS if the request from the client
+ *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
+ *
+ *******************************************************************************/
+int32_t scan_page_handler(const char *url_path, const char *url_parameters,
+                          cy_http_response_stream_t *stream, void *arg,
+                          cy_http_message_body_t *http_message_body)
+{
+    scan_options_t options;
+    uint32_t live = 1;
+
+    get_query_uint(url_parameters, "live", &live);
+    if (live != 0)
+    {
+        if ((CY_RSLT_SUCCESS != write_page_header(stream)) ||
+            (CY_RSLT_SUCCESS != template_send(&page_scan_live, stream)))
         {
-            ERR_INFO(("Failed to send the HTTP POST response.\n"));
+            ERR_INFO(("Failed to send the HTTP GET response.\n"));
+            return HTTP_REQUEST_HANDLE_ERROR;
         }
+        return HTTP_REQUEST_HANDLE_SUCCESS;
+    }
 
-        /* Set device configured flag to true */
-        device_configured = true;
-        reconfiguration_request = SERVER_RECONFIGURE_REQUESTED;
-        cy_wcm_stop_ap();
-        break;
+    if (!rate_limiter_admit(stream, RATE_LIMIT_CLASS_SCAN))
+    {
+        return HTTP_REQUEST_HANDLE_SUCCESS;
+    }
 
-    default:
-        ERR_INFO(("Wi-Fi Scan: Received invalid HTTP request method. Supported HTTP methods are GET, POST, and PUT.\n"));
-        
-        break;
+    if (!scan_events_lock(stream))
+    {
+        return HTTP_REQUEST_HANDLE_SUCCESS;
+    }
+
+    scan_options_parse(url_parameters, &options);
+
+    if (CY_RSLT_SUCCESS != write_page_header(stream))
+    {
+        scan_events_unlock();
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
+
+    scan_for_available_aps(stream, &options);
+    scan_events_unlock();
+
+    return HTTP_REQUEST_HANDLE_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: scan_events_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles HTTP GET "/scan_events" on the SoftAP server: scans for the
+ *  available networks and sends each network as a "network" server sent
+ *  event as soon as it is reported, once per SSID, followed by a "done"
+ *  event with the number of networks, the time to the first one and the
+ *  duration of the scan. The query parameters of the scan page restrict
+ *  the scan. A request made while another scan is running is answered with
+ *  "503 Service Unavailable", as the scans share the event queue.
+ *
+ * Parameters:
+ *  url_path - Pointer to the HTTP URL path.
+ *  url_parameters - Pointer to the HTTP URL query string.
+ *  stream - Pointer to the HTTP response stream.
+ *  arg - Unused.
+ *  http_message_body - Pointer to the HTTP data from the client.
+ *
+ * Return:
+ *  int32_t - Returns HTTP_REQUEST_HANDLE_SUCCESS if the request from the client
+ *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
+ *
+ *******************************************************************************/
+int32_t scan_events_handler(const char *url_path, const char *url_parameters,
+                            cy_http_response_stream_t *stream, void *arg,
+                            cy_http_message_body_t *http_message_body)
+{
+    cy_rslt_t result;
+    scan_options_t options;
+    scan_event_t event;
+    scan_events_status_t status = SCAN_EVENTS_TIMEOUT;
+    char frame[SCAN_EVENTS_FRAME_LENGTH];
+    size_t length;
+    uint32_t start;
+    uint32_t first_msec = 0;
+    uint32_t networks = 0;
+
+    if (!scan_events_lock(stream))
+    {
+        return HTTP_REQUEST_HANDLE_SUCCESS;
+    }
+
+    scan_options_parse(url_parameters, &options);
+
+    result = cy_http_server_response_stream_enable_chunked_transfer(stream);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = cy_http_server_response_stream_write_header(stream, CY_HTTP_200_TYPE,
+                                                    CHUNKED_CONTENT_LENGTH, CY_HTTP_CACHE_DISABLED,
+                                                    MIME_TYPE_TEXT_EVENT_STREAM);
+    }
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("HTTP server scan events failed to write stream header\r\n"));
+        scan_events_unlock();
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
+
+    start = xTaskGetTickCount();
+    result = scan_events_start(&options);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("cy_wcm_start_scan failed with error code %d\r\n", (int)result));
+    }
+
+    /* Each network is written as its own chunk, so it leaves right away */
+    while (CY_RSLT_SUCCESS == result)
+    {
+        status = scan_events_next(&event, SCAN_EVENTS_TIMEOUT_MSEC);
+        if (SCAN_EVENTS_NETWORK != status)
+        {
+            break;
+        }
+
+        length = scan_events_format_network(frame, sizeof(frame), &event);
+        result = cy_http_server_response_stream_write_payload(stream, frame, length);
+        server_stats_add_sent(length, false);
+        if (networks++ == 0u)
+        {
+            first_msec = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+        }
+    }
+    scan_events_stop();
+    scan_events_unlock();
+
+    if (SCAN_EVENTS_TIMEOUT == status)
+    {
+        ERR_INFO(("The scan did not complete, ending the scan events\r\n"));
+    }
+    if ((CY_RSLT_SUCCESS != result) && (networks != 0u))
+    {
+        ERR_INFO(("Failed to write the scan events\r\n"));
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
+
+    length = scan_events_format_done(frame, sizeof(frame), networks, first_msec,
+                                     (xTaskGetTickCount() - start) * portTICK_PERIOD_MS,
+                                     (SCAN_EVENTS_COMPLETE == status));
+    result = cy_http_server_response_stream_write_payload(stream, frame, length);
+    server_stats_add_sent(length, false);
+    APP_INFO(("Scan streamed %lu networks, the first after %lu ms\r\n",
+              (unsigned long)networks, (unsigned long)first_msec));
+
+    return (CY_RSLT_SUCCESS == result) ? HTTP_REQUEST_HANDLE_SUCCESS : HTTP_REQUEST_HANDLE_ERROR;
+}
+
+/*******************************************************************************
+ * Function Name: provisioning_done_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles HTTP POST "/wifi_scan_form" on the SoftAP server, sent once the
+ *  device is connected to the AP: redirects the client to the device data
+ *  page and requests the HTTP server to be reconfigured on the STA
+ *  interface.
+ *
+ * Parameters:
+ *  url_path - Pointer to the HTTP URL path.
+ *  url_parameters - Pointer to the HTTP URL query string.
+ *  stream - Pointer to the HTTP response stream.
+ *  arg - Unused.
+ *  http_message_body - Pointer to the HTTP data from the client.
+ *
+ * Return:
+ *  int32_t - Returns HTTP_REQUEST_HANDLE_SUCCESS if the request from the client
+ *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
+ *
+ *******************************************************************************/
+int32_t provisioning_done_handler(const char *url_path, const char *url_parameters,
+                                  cy_http_response_stream_t *stream, void *arg,
+                                  cy_http_message_body_t *http_message_body)
+{
+    cy_rslt_t result = write_page_header(stream);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = template_send(&page_device_data_redirect, stream);
+    }
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("Failed to send the HTTP POST response.\n"));
+    }
+
+    /* Set device configured flag to true. The SoftAP is stopped once the STA
+     * server has taken over.
+     */
+    device_configured = true;
+    reconfiguration_request = SERVER_RECONFIGURE_REQUESTED;
+
+    return (CY_RSLT_SUCCESS == result) ? HTTP_REQUEST_HANDLE_SUCCESS : HTTP_REQUEST_HANDLE_ERROR;
+}
+
+/*******************************************************************************
+ * Function Name: device_page_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles HTTP GET "/" on the STA server by sending the device data page.
+ *
+ * Parameters:
+ *  url_path - Pointer to the HTTP URL path.
+ *  url_parameters - Pointer to the HTTP URL query string.
+ *  stream - Pointer to the HTTP response stream.
+ *  arg - Unused.
+ *  http_message_body - Pointer to the HTTP data from the client.
+ *
+ * Return:
+ *  int32_t - Returns HTTP_REQUEST_HANDLE_SUCCESS if the request from the client
+ *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
+ *
+ *******************************************************************************/
+int32_t device_page_handler(const char *url_path, const char *url_parameters,
+                            cy_http_response_stream_t *stream, void *arg,
+                            cy_http_message_body_t *http_message_body)
+{
+    cy_rslt_t result = write_page_header(stream);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        result = template_send(&page_device_data, stream);
+    }
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("Failed to send the HTTP GET response.\n"));
+        return HTTP_REQUEST_HANDLE_ERROR;
+    }
+
+    return HTTP_REQUEST_HANDLE_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: device_control_handler
+ *******************************************************************************
+ * Summary:
+ *  Handles HTTP POST "/" on the STA server: increases or decreases the LED
+ *  brightness as requested by the "Increase" or "Decrease" command in the
+ *  HTTP data, and answers with "204 No Content".
+ *
+ * Parameters:
+ *  url_path - Pointer to the HTTP URL path.
+ *  url_parameters - Pointer to the HTTP URL query string.
+ *  stream - Pointer to the HTTP response stream.
+ *  arg - Unused.
+ *  http_message_body - Pointer to the HTTP data from the client.
+ *
+ * Return:
+ *  int32_t - Returns HTTP_REQUEST_HANDLE_SUCCESS if the request from the client
+ *  was handled successfully. Otherwise, it returns HTTP_REQUEST_HANDLE_ERROR.
+ *
+ *******************************************************************************/
+int32_t device_control_handler(const char *url_path, const char *url_parameters,
+                               cy_http_response_stream_t *stream, void *arg,
+                               cy_http_message_body_t *http_message_body)
+{
+    cy_rslt_t result;
 
+    /* Compare the input from client to increase or decrease pwm value. */
+    if(!strncmp((char *)http_message_body->data, INCREASE, 8))
+    {
+        increase_pwm = true;
+    }
+    else if(!strncmp((char *)http_message_body->data, DECREASE, 8))
+    {
+        decrease_pwm = true;
     }
 
+    /* Send the HTTP response, which has no body by definition. */
+    result = cy_http_server_response_stream_write_payload(stream, HTTP_RESPONSE_204, sizeof(HTTP_RESPONSE_204) - 1);
     if (CY_RSLT_SUCCESS != result)
     {
-        status = HTTP_REQUEST_HANDLE_ERROR;
+        ERR_INFO(("Failed to send the HTTP POST response.\n"));
+        return HTTP_REQUEST_HANDLE_ERROR;
     }
 
-    return status;
+    return HTTP_REQUEST_HANDLE_SUCCESS;
 }
 
 /*******************************************************************************
  * Function Name: scan_callback
  *******************************************************************************
- * Summary: The callback function which accumulates the scan results. After
- * completing the scan, it updates scan_complete_flag to indicate end of scan.
+ * Summary: The callback function which accumulates the SSIDs of the scan
+ * results satisfying the scan options in the SSID list, one per line, and
+ * records all of the APs in the scan cache. The results are only cached once
+ * the provisioning buffers have been released.
+ * After completing the scan, it updates scan_complete_flag to indicate end of
+ * scan.
+ *
+ * Parameters:
+ *  cy_wcm_scan_result_t *result_ptr: Pointer to the scan result
+ *  void *user_data: User data.
+ *  cy_wcm_scan_status_t status: Status of scan completion.
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void scan_callback(cy_wcm_scan_result_t *result_ptr, void *user_data, cy_wcm_scan_status_t status)
+{
+    size_t ssid_length;
+
+    if ((status == CY_WCM_SCAN_INCOMPLETE) && (result_ptr->SSID[0] != '\0'))
+    {
+        /* Keep the security type and channel for the connection */
+        scan_cache_add(result_ptr);
+        if ((NULL == provisioning) || !scan_options_match(&provisioning->scan_options, result_ptr))
+        {
+            return;
+        }
+
+        /* Only whole SSIDs are listed, a result which does not fit in the
+         * SSID list is left out and the list is flagged as truncated.
+         */
+        ssid_length = strlen((const char *)result_ptr->SSID);
+        if ((ssid_length + 1u) > (provisioning->scan_list_builder.capacity - provisioning->scan_list_builder.length))
+        {
+            provisioning->scan_list_builder.overflow = true;
+            return;
+        }
+        response_builder_append(&provisioning->scan_list_builder, (const char *)result_ptr->SSID, ssid_length);
+        response_builder_append(&provisioning->scan_list_builder, "\n", 1);
+        scan_complete_flag = false;
+    }
+
+    if ((CY_WCM_SCAN_COMPLETE == status))
+    {
+        /* Flag to notify that scan has completed.*/
+        scan_complete_flag = true;        
+    }
+
+}
+
+/*******************************************************************************
+ * Function Name: scan_result_slot_writer
+ *******************************************************************************
+ * Summary: Fills in the slots of the scan result page.
  *
  * Parameters:
- *  cy_wcm_scan_result_t *result_ptr: Pointer to the scan result
- *  void *user_data: User data.
- *  cy_wcm_scan_status_t status: Status of scan completion.
+ *  response_builder_t *builder: Builder the page is written to.
+ *  uint8_t slot: Slot to be filled in.
+ *  void *arg: Builder holding the list of SSIDs found by the scan.
  *
  * Return:
- *  void
+ *  bool: true if the slot value was written.
  *
  ******************************************************************************/
-void scan_callback(cy_wcm_scan_result_t *result_ptr, void *user_data, cy_wcm_scan_status_t status)
+static bool scan_result_slot_writer(response_builder_t *builder, uint8_t slot, void *arg)
 {
-    char *network_name = ssid_buff;
-    static uint32_t len = 0;
-    
-    if ((strlen((const char *)result_ptr->SSID) != 0) && (status == CY_WCM_SCAN_INCOMPLETE))
-    {
-
-        network_name += len;
-        memcpy(network_name, result_ptr->SSID, strlen((char *)result_ptr->SSID));
-        len += strlen((char *)result_ptr->SSID);
-        memcpy((network_name + strlen((char *)result_ptr->SSID)), "\n", 1);
-        len++;
-        scan_complete_flag = false;
-    }
+    const response_builder_t *scan_list = (const response_builder_t *)arg;
 
-    if ((CY_WCM_SCAN_COMPLETE == status))
+    if (slot != PAGE_SLOT_SSID_LIST)
     {
-        /* Reset the number of scan results to 0 for the next scan.*/
-        len++;
-        memcpy((ssid_buff + len), "\0", 1);
-        len = 0;
-        
-        /* Flag to notify that scan has completed.*/
-        scan_complete_flag = true;        
+        return true;
     }
 
+    return response_builder_append(builder, scan_list->buffer, scan_list->length);
 }
 
 /*******************************************************************************
  * Function Name: scan_for_available_aps
  *******************************************************************************
  * Summary: This function scans for available APs and prints the scan result to 
- * the webpage once the scan is complete.
+ * the webpage once the scan is complete. The scan options are applied by the
+ * scan filter of the Wi-Fi connection manager as far as it supports them,
+ * and by scan_callback for the rest.
  *
  *
  * Parameters:
  *  cy_http_response_stream_t *url_stream : HTTP stream on which data was received.
+ *  const scan_options_t *options : Options the listed APs must satisfy.
  *
  * Return:
  *  void
  *
  ******************************************************************************/
-void scan_for_available_aps(cy_http_response_stream_t *url_stream)
+void scan_for_available_aps(cy_http_response_stream_t *url_stream, const scan_options_t *options)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
+    char response_buffer[RESPONSE_CHUNK_LENGTH];
+    response_builder_t builder;
+    cy_wcm_scan_filter_t scan_filter;
+    bool filtered;
 
-    char *response = http_scan_response;
-
-    result = cy_http_server_response_stream_write_payload(url_stream, WIFI_SCAN_IN_PROGRESS, sizeof(WIFI_SCAN_IN_PROGRESS));
+    /* Send the progress page before the scan as the scan takes a while. */
+    result = template_send(&page_scan_in_progress, url_stream);
     PRINT_AND_ASSERT(result, "Failed to send the HTTP POST response.\n");
 
-    result = cy_wcm_start_scan(scan_callback, NULL, NULL);
+    response_builder_init(&provisioning->scan_list_builder, provisioning->ssid_list,
+                          sizeof(provisioning->ssid_list), NULL);
+    provisioning->scan_options = *options;
+    filtered = scan_options_to_wcm_filter(options, &scan_filter);
+    scan_running = true;
+    result = cy_wcm_start_scan(scan_callback, NULL, filtered ? &scan_filter : NULL);
     PRINT_AND_ASSERT(result, "cy_wcm_start_scan failed.\n");
+
+    response_builder_init(&builder, response_buffer, sizeof(response_buffer), url_stream);
     
     /* Waiting for the scan to be completed */
     while (!scan_complete_flag)
@@ -460,17 +1034,22 @@ void scan_for_available_aps(cy_http_response_stream_t *url_stream)
 
     scan_complete_flag = false;
 
+    /* The scan was stopped as the provisioning buffers were released. */
+    if (NULL == provisioning)
+    {
+        scan_running = false;
+        return;
+    }
+
+    if (provisioning->scan_list_builder.overflow)
+    {
+        APP_INFO(("Scan results did not fit in the SSID list and were truncated\r\n"));
+    }
+
     /* Print the scan result in webpage.*/
-    sprintf(response, SOFTAP_SCAN_START_RESPONSE);
-    response += strlen(SOFTAP_SCAN_START_RESPONSE);
-    memcpy(response, ssid_buff, strlen(ssid_buff));
-    response += strlen(ssid_buff);
-    sprintf(response, SOFTAP_SCAN_INTERMEDIATE_RESPONSE);
-    response += strlen(SOFTAP_SCAN_INTERMEDIATE_RESPONSE);
-    sprintf(response, SOFTAP_SCAN_END_RESPONSE);
-    response += strlen(SOFTAP_SCAN_END_RESPONSE); 
-    
-    result = cy_http_server_response_stream_write_payload(url_stream, http_scan_response, sizeof(http_scan_response) - 1);
+    result = template_render(&page_scan_result, &builder, scan_result_slot_writer,
+                             &provisioning->scan_list_builder);
+    scan_running = false;
     if (CY_RSLT_SUCCESS != result)
     {
         ERR_INFO(("Failed to write HTTP response\r\n"));
@@ -478,74 +1057,132 @@ void scan_for_available_aps(cy_http_response_stream_t *url_stream)
 
 }
 
+/*******************************************************************************
+ * Function Name: save_credentials
+ *******************************************************************************
+ * Summary:
+ *  Stores the credentials of the Wi-Fi network the device has just connected
+ *  to, along with the details of the AP, so that the next boot can connect
+ *  to it directly.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ *******************************************************************************/
+static void save_credentials(void)
+{
+    credentials_t credentials;
+    wifi_link_ap_t ap;
+    cy_rslt_t result;
+
+    memset(&credentials, 0, sizeof(credentials));
+    memcpy(credentials.ssid, wifi_ssid, sizeof(credentials.ssid));
+    memcpy(credentials.password, wifi_pwd, sizeof(credentials.password));
+    credentials.security = CY_WCM_SECURITY_WPA2_AES_PSK;
+
+    /* Keep the association details, so the next boot joins without a search */
+    if (wifi_link_get_ap(&ap))
+    {
+        credentials.security = ap.security;
+        memcpy(credentials.bssid, ap.bssid, sizeof(credentials.bssid));
+        credentials.channel = ap.channel;
+        credentials.band = ap.band;
+    }
+
+    result = credential_store_save(&credentials);
+    memset(&credentials, 0, sizeof(credentials));
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("Failed to store the Wi-Fi credentials: 0x%08lx\n", (unsigned long)result));
+    }
+}
+
 /********************************************************************************
  * Function Name: wifi_extract_credentials
  ********************************************************************************
  * Summary:
  *  The function extracts the credentials entered via HTTP webpage. Switches to STA 
  *  mode then connects to the same credentials.
+ *  The HTTP server hands a body larger than a packet over in several pieces,
+ *  calling the handler once per piece; each piece is fed to the form parser
+ *  as it arrives, and the connection is made after the last one. The fields
+ *  may come in any order. A piece which does not continue the form being
+ *  received, as when a client dropped a form partway and the stream was
+ *  given to a new request, starts a new form.
  *
  * Parameters:
- *  const uint8_t* data : The HTTP data that contains ssid and password that is
- *  entered from the HTTP webpage.
-*   uint32_t data_len : The length of the HTTP response.
+ *  const cy_http_message_body_t* body : Piece of the HTTP data that contains
+ *  the ssid and password entered from the HTTP webpage.
+ *  cy_http_response_stream_t* stream : HTTP stream the page is sent to.
  *
  * Return:
- *  void
+ *  cy_rslt_t: CY_RSLT_SUCCESS if the response was sent.
  *
  *******************************************************************************/
-cy_rslt_t wifi_extract_credentials(const uint8_t *data, uint32_t data_len, cy_http_response_stream_t *stream)
+cy_rslt_t wifi_extract_credentials(const cy_http_message_body_t *body, cy_http_response_stream_t *stream)
 {
-    int8_t ssid_buff_index, buff_index = 0;
     cy_rslt_t result = CY_RSLT_SUCCESS;
-    char *response = http_wifi_connect_response;
+    char response_buffer[RESPONSE_CHUNK_LENGTH];
+    response_builder_t builder;
+    form_parser_result_t form_result;
 
 #ifdef ENABLE_TFT
     char display_buffer[DISPLAY_BUFFER_LENGTH] = {0};
+    size_t display_length = 0;
 #endif /* #ifdef ENABLE_TFT */
 
-    /*decode the url encoded data using the function url_decode()*/
-    url_decode(buffer, data);
-
-    if (!strncmp("SSID", buffer, 4))
+    /* The first piece of a form */
+    if ((credentials_stream != stream) ||
+        ((body->data_length + body->data_remaining) != credentials_remaining))
     {
-        /* Extract SSID and Password - skip to SSID*/
-        while ((buffer[buff_index++] != EQUALS_OPERATOR_ASCII_VALUE))
-            ;
-
-        ssid_buff_index = 0;
-        /*skip '&' */
-        while ((buffer[buff_index] != AMPERSAND_OPERATOR_ASCII_VALUE))
-            wifi_ssid[ssid_buff_index++] = buffer[buff_index++];
+        result = write_page_header(stream);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+        form_parser_init(&provisioning->credentials_parser, provisioning->credentials_fields,
+                         CREDENTIALS_FIELD_COUNT);
+        credentials_stream = stream;
+    }
 
-        buff_index++;
-        /* skip to Password */
-        while ((buffer[buff_index++] != EQUALS_OPERATOR_ASCII_VALUE ))
-            ;
+    form_parser_feed(&provisioning->credentials_parser, body->data, body->data_length);
+    credentials_remaining = body->data_remaining;
+    if (body->data_remaining != 0u)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+    credentials_stream = NULL;
 
-        ssid_buff_index = 0;
-        while ((buff_index < data_len))
+    form_result = form_parser_finish(&provisioning->credentials_parser);
+    if (FORM_PARSER_OK != form_result)
+    {
+        ERR_INFO(("Invalid credentials form, error %d\n", (int)form_result));
+        response_builder_init(&builder, response_buffer, sizeof(response_buffer), stream);
+        result = template_render(&page_wifi_connect_fail, &builder, NULL, NULL);
+        if (CY_RSLT_SUCCESS != result)
         {
-            if (buffer[buff_index] == AMPERSAND_OPERATOR_ASCII_VALUE)
-                break;
-
-            wifi_pwd[ssid_buff_index++] = buffer[buff_index++];
+            ERR_INFO(("Failed to send the HTTP POST response.\n"));
         }
+        return result;
     }
-    result = cy_http_server_response_stream_write_payload(stream, WIFI_CONNECT_IN_PROGRESS, sizeof(WIFI_CONNECT_IN_PROGRESS));
+    memcpy(wifi_ssid, provisioning->form_ssid, sizeof(provisioning->form_ssid));
+    memcpy(wifi_pwd, provisioning->form_pwd, sizeof(wifi_pwd));
+
+    /* Send the progress page before connecting as the connection takes a while. */
+    result = template_send(&page_connect_in_progress, stream);
     if (CY_RSLT_SUCCESS != result)
     {
         ERR_INFO(("Failed to send the HTTP POST response.\n"));
     }
 
     result = start_sta_mode();
+    response_builder_init(&builder, response_buffer, sizeof(response_buffer), stream);
     if (CY_RSLT_SUCCESS != result)
     {
-        sprintf(response, WIFI_CONNECT_RESPONSE_START);
-        response += strlen(WIFI_CONNECT_RESPONSE_START);
-        sprintf(response, WIFI_CONNECT_FAIL_RESPONSE_END);
-        response += strlen(WIFI_CONNECT_FAIL_RESPONSE_END);
-        result = cy_http_server_response_stream_write_payload(stream, http_wifi_connect_response, sizeof(http_wifi_connect_response));
+        result = template_render(&page_wifi_connect_fail, &builder, NULL, NULL);
         if (CY_RSLT_SUCCESS != result)
         {
             ERR_INFO(("Failed to send the HTTP POST response.\n"));
@@ -553,11 +1190,9 @@ cy_rslt_t wifi_extract_credentials(const uint8_t *data, uint32_t data_len, cy_ht
     }
     else
     {
-        sprintf(response, WIFI_CONNECT_RESPONSE_START);
-        response += strlen(WIFI_CONNECT_RESPONSE_START);
-        sprintf(response, WIFI_CONNECT_SUCCESS_RESPONSE_END);
-        response += strlen(WIFI_CONNECT_SUCCESS_RESPONSE_END);
-        result = cy_http_server_response_stream_write_payload(stream, http_wifi_connect_response, sizeof(http_wifi_connect_response));
+        save_credentials();
+
+        result = template_render(&page_wifi_connect_success, &builder, NULL, NULL);
         if (CY_RSLT_SUCCESS != result)
         {
             ERR_INFO(("Failed to send the HTTP POST response.\n"));
@@ -567,7 +1202,9 @@ cy_rslt_t wifi_extract_credentials(const uint8_t *data, uint32_t data_len, cy_ht
     row += ROW_OFFSET;
     GUI_DispStringAt("Connected to the Wi-Fi network: \r\n", 0, row);
     row += ROW_OFFSET;
-    sprintf(display_buffer, " %s\r\n", wifi_ssid);
+    format_append(display_buffer, sizeof(display_buffer), &display_length, " ");
+    format_append(display_buffer, sizeof(display_buffer), &display_length, (char *)wifi_ssid);
+    format_append(display_buffer, sizeof(display_buffer), &display_length, "\r\n");
     GUI_DispStringAt(display_buffer, 0, row);
     row += ROW_OFFSET;
 #endif /* #ifdef ENABLE_TFT */
@@ -576,6 +1213,103 @@ cy_rslt_t wifi_extract_credentials(const uint8_t *data, uint32_t data_len, cy_ht
     return result;
 }
 
+/*******************************************************************************
+ * Function Name: erase_button_held
+ *******************************************************************************
+ * Summary:
+ *  Reads the user button, which erases the stored credentials when it is held
+ *  while the device boots.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool: Returns true if the user button is pressed.
+ *
+ *******************************************************************************/
+static bool erase_button_held(void)
+{
+    bool held = false;
+
+    if (CY_RSLT_SUCCESS == cyhal_gpio_init(CYBSP_USER_BTN, CYHAL_GPIO_DIR_INPUT,
+                                           CYHAL_GPIO_DRIVE_PULLUP, CYBSP_BTN_OFF))
+    {
+        held = (CYBSP_BTN_PRESSED == cyhal_gpio_read(CYBSP_USER_BTN));
+        cyhal_gpio_free(CYBSP_USER_BTN);
+    }
+
+    return held;
+}
+
+/*******************************************************************************
+ * Function Name: start_sta_mode_from_store
+ *******************************************************************************
+ * Summary:
+ *  Connects to the Wi-Fi network whose credentials were stored by a previous
+ *  boot, if any. Holding the user button while the device boots erases the
+ *  stored credentials and returns the device to SoftAP provisioning.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool: Returns true if the device is connected to the stored network,
+ *  false if it has to be provisioned through the SoftAP.
+ *
+ *******************************************************************************/
+bool start_sta_mode_from_store(void)
+{
+    credentials_t credentials;
+    wifi_link_ap_t ap;
+
+    if (CY_RSLT_SUCCESS != credential_store_init())
+    {
+        ERR_INFO(("Failed to initialize the credential store.\n"));
+        return false;
+    }
+
+    if (erase_button_held())
+    {
+        if (CY_RSLT_SUCCESS == credential_store_erase())
+        {
+            APP_INFO(("User button held, erased the stored credentials.\n"));
+        }
+        else
+        {
+            ERR_INFO(("Failed to erase the stored credentials.\n"));
+        }
+        return false;
+    }
+
+    if (!credential_store_load(&credentials))
+    {
+        return false;
+    }
+    boot_timeline_mark(BOOT_EVENT_CREDENTIALS_LOADED);
+
+    memcpy(wifi_ssid, credentials.ssid, sizeof(credentials.ssid));
+    memcpy(wifi_pwd, credentials.password, sizeof(wifi_pwd));
+    if (0u != credentials.channel)
+    {
+        memcpy(ap.bssid, credentials.bssid, sizeof(ap.bssid));
+        ap.channel = credentials.channel;
+        ap.band = credentials.band;
+        ap.security = credentials.security;
+        wifi_link_set_ap(credentials.ssid, &ap);
+    }
+    memset(&credentials, 0, sizeof(credentials));
+
+    if (CY_RSLT_SUCCESS != start_sta_mode())
+    {
+        ERR_INFO(("Failed to connect with the stored credentials, starting the SoftAP.\n"));
+        memset(wifi_ssid, 0, sizeof(wifi_ssid));
+        memset(wifi_pwd, 0, sizeof(wifi_pwd));
+        return false;
+    }
+
+    return true;
+}
+
 /********************************************************************************
  * Function Name: start_ap_mode
  ********************************************************************************
@@ -624,7 +1358,9 @@ cy_rslt_t start_ap_mode()
  *******************************************************************************
  * Summary:
  *  The function attempts to connect to Wi-Fi until a connection is made or
- *  MAX_WIFI_RETRY_COUNT attempts have been made.
+ *  MAX_WIFI_RETRY_COUNT attempts have been made. The first attempt joins the
+ *  AP last connected to directly when its details are cached, and the
+ *  attempts are spaced by a jittered exponential backoff.
  * 
  * Parameters:
  *  void
@@ -637,8 +1373,6 @@ cy_rslt_t start_ap_mode()
 cy_rslt_t start_sta_mode()
 {
     cy_rslt_t result;
-    cy_wcm_connect_params_t connect_param;
-    cy_wcm_ip_address_t ip_address;
     bool wifi_conct_stat = false;
 
     /*Disconnect from the currently connected AP if any*/
@@ -648,27 +1382,14 @@ cy_rslt_t start_sta_mode()
         cy_wcm_disconnect_ap();
     }
 
-    memset(&connect_param, 0, sizeof(cy_wcm_connect_params_t));
-    memset(&ip_address, 0, sizeof(cy_wcm_ip_address_t));
-   
-    memcpy(connect_param.ap_credentials.SSID, wifi_ssid, sizeof(wifi_ssid));
-    memcpy(connect_param.ap_credentials.password, wifi_pwd, sizeof(wifi_pwd));
-    connect_param.ap_credentials.security = CY_WCM_SECURITY_WPA2_AES_PSK;
-
     /* Attempt to connect to Wi-Fi until a connection is made or
      * MAX_WIFI_RETRY_COUNT attempts have been made.
      */
-    for (uint32_t conn_retries = 0; conn_retries < MAX_WIFI_RETRY_COUNT; conn_retries++)
+    result = wifi_link_connect(wifi_ssid, wifi_pwd, MAX_WIFI_RETRY_COUNT);
+    if (result == CY_RSLT_SUCCESS)
     {
-        result = cy_wcm_connect_ap(&connect_param, &ip_address);
-        if (result == CY_RSLT_SUCCESS)
-        {
-            APP_INFO(("Successfully connected to Wi-Fi network '%s'.\n", connect_param.ap_credentials.SSID));
-            break;
-        }
-        ERR_INFO(("Connection to Wi-Fi network failed with error code %d. Retrying in %d ms...\n", (int)result, WIFI_CONN_RETRY_INTERVAL_MSEC));
-
-        vTaskDelay(pdMS_TO_TICKS(WIFI_CONN_RETRY_INTERVAL_MSEC));
+        APP_INFO(("Successfully connected to Wi-Fi network '%.32s'.\n", (char *)wifi_ssid));
+        boot_timeline_mark(BOOT_EVENT_STA_CONNECTED);
     }
 
     return result;
@@ -678,8 +1399,8 @@ cy_rslt_t start_sta_mode()
  * Function Name: configure_http_server
  *******************************************************************************
  * Summary:
- *  The function registers a softap_resource_handler to handle HTTP requests 
- *  received by http_ap_server. 
+ *  The function registers the SoftAP routes of the route table and the files
+ *  of the asset image to handle HTTP requests received by http_ap_server.
  *
  * Parameters:
  *  void
@@ -694,9 +1415,6 @@ cy_rslt_t configure_http_server(void)
     cy_rslt_t result = CY_RSLT_SUCCESS;
     cy_wcm_ip_address_t ip_addr;
 
-    /* Holds the response handler for HTTP GET and POST request from the client. */
-    cy_resource_dynamic_data_t http_get_post_resource;
-
     /* IP address of SoftAp. */
     result = cy_wcm_get_ip_addr(CY_WCM_INTERFACE_TYPE_AP, &ip_addr);
     PRINT_AND_ASSERT(result, "cy_wcm_get_ip_addr failed for creating HTTP server...! \n");
@@ -708,36 +1426,13 @@ cy_rslt_t configure_http_server(void)
     nw_interface.object = (void *)&http_server_ip_address;
     nw_interface.type = CY_NW_INF_TYPE_WIFI;
 
-    /* Initialize secure socket library. */
-    result = cy_http_server_network_init();
-
     /* Allocate memory needed for secure HTTP server. */
     result = cy_http_server_create(&nw_interface, HTTP_PORT, MAX_SOCKETS, NULL, &http_ap_server);
     PRINT_AND_ASSERT(result, "Failed to allocate memory for the HTTP server.\n");
 
-    /* Configure dynamic resource handler. */
-    http_get_post_resource.resource_handler = softap_resource_handler;
-    http_get_post_resource.arg = NULL;
-
-    /* Register all the resources with the secure HTTP server. */
-    result = cy_http_server_register_resource(http_ap_server,
-                                              (uint8_t *)"/",
-                                              (uint8_t *)"text/html",
-                                              CY_DYNAMIC_URL_CONTENT,
-                                              &http_get_post_resource);
-    PRINT_AND_ASSERT(result, "Failed to register a resource.\n");
-
-    /* Configure dynamic resource handler. */
-    http_wifi_resource.resource_handler = wifi_resource_handler;
-    http_wifi_resource.arg = NULL;
-
-    /* Register all the resources with the secure HTTP server. */
-    result = cy_http_server_register_resource(http_ap_server,
-                                              (uint8_t *)"/wifi_scan_form",
-                                              (uint8_t *)"text/html",
-                                              CY_DYNAMIC_URL_CONTENT,
-                                              &http_wifi_resource);
-    PRINT_AND_ASSERT(result, "Failed to register a resource.\n");
+    /* Register the routes of the SoftAP server, with its files of the asset image. */
+    result = router_register(http_ap_server, ROUTE_SERVER_AP);
+    PRINT_AND_ASSERT(result, "Failed to register the routes.\n");
 
     return result;
 }
@@ -746,10 +1441,17 @@ cy_rslt_t configure_http_server(void)
  * Function Name: reconfigure_http_server
  *******************************************************************************
  * Summary:
- * The function deletes the existing HTTP server instance (http_ap_server), and 
- * starts a new HTTP server instance (http_sta_server). After registering 
- * dynamic URL handler (process_sse_handler and http_get_post_resource) to handle 
- * the HTTP GET, POST, and PUT requests.
+ * The function hands the HTTP service over from the SoftAP server instance
+ * (http_ap_server) to a new server instance on the STA interface
+ * (http_sta_server) without a gap. The STA server is created, given the STA
+ * routes of the route table and the files of the asset image, and started
+ * while the SoftAP server keeps serving. Only once the STA server is
+ * listening is the SoftAP server stopped and deleted and the SoftAP brought
+ * down. The timing of the handover is logged and reported by /api/stats,
+ * together with the gap between the last response of the SoftAP server and
+ * the first response of the STA server.
+ * After a fast boot there is no SoftAP server and the STA server is simply
+ * started.
  *
  * Parameters:
  *  void
@@ -763,149 +1465,222 @@ cy_rslt_t reconfigure_http_server(void)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
     cy_wcm_ip_address_t ip_addr;
+    TickType_t handover_start = xTaskGetTickCount();
+    TickType_t sta_listening;
+    TickType_t ap_stopped = 0;
+    uint32_t listen_msec;
+    uint32_t overlap_msec;
+
+    /* IP address of the STA interface. */
+    result = cy_wcm_get_ip_addr(CY_WCM_INTERFACE_TYPE_STA, &ip_addr);
+    PRINT_AND_ASSERT(result, "cy_wcm_get_ip_addr failed for creating HTTP server...! \n");
+
+    http_sta_server_ip_address.ip_address.ip.v4 = ip_addr.ip.v4;
+    http_sta_server_ip_address.ip_address.version = CY_SOCKET_IP_VER_V4;
+
+    /* Add IP address information to network interface object. The socket
+     * library is already initialized for the SoftAP server.
+     */
+    sta_nw_interface.object = (void *)&http_sta_server_ip_address;
+    sta_nw_interface.type = CY_NW_INF_TYPE_WIFI;
+
+    /* Allocate memory needed for secure HTTP server. */
+    result = cy_http_server_create(&sta_nw_interface, HTTP_PORT, MAX_SOCKETS, NULL, &http_sta_server);
+    PRINT_AND_ASSERT(result, "Failed to allocate memory for the HTTP server.\n");
+
+    /* Register the routes of the STA server, with its files of the asset image. */
+    result = router_register(http_sta_server, ROUTE_SERVER_STA);
+    PRINT_AND_ASSERT(result, "Failed to register the routes.\n");
+
+    /* Start the HTTP server. The listening socket is bound once this returns. */
+    result = cy_http_server_start(http_sta_server);
+    PRINT_AND_ASSERT(result, "Failed to start the HTTP server.\n");
+    sta_listening = xTaskGetTickCount();
+    boot_timeline_mark(BOOT_EVENT_SERVER_LISTENING);
 
-    /* Holds the response handler for HTTP GET and POST request from the client. */
-    cy_resource_dynamic_data_t http_get_post_resource;
+    if (!http_ap_server_running)
+    {
+        return result;
+    }
 
-    /* Holds the response handler for dynamic SSE resource. */
-    cy_resource_dynamic_data_t dynamic_sse_resource;
+    /* Let the SoftAP server finish the redirect to the STA server. */
+    vTaskDelay(pdMS_TO_TICKS(SERVER_HANDOVER_GRACE_MSEC));
 
-    /* Restart HTTP server using the new ip address. */
+    /* Retire the SoftAP server now that the STA server is serving. */
+    ap_stopped = xTaskGetTickCount();
     result = cy_http_server_stop( http_ap_server );
     PRINT_AND_ASSERT(result, "Failed to stop HTTP server.\n");
 
     /* Delete the HTTP server object */
     result = cy_http_server_delete( http_ap_server );
     PRINT_AND_ASSERT(result, "Failed to delete HTTP server.\n");
+    http_ap_server_running = false;
 
-    /* Deinitialize the network socket */
-    result = cy_http_server_network_deinit();
-    PRINT_AND_ASSERT(result, "Failed to deinit server.\n");
+    /* The connections of the deleted server are gone */
+    connection_manager_forget_server(ROUTE_SERVER_AP);
+    router_forget_server(ROUTE_SERVER_AP);
+    cy_wcm_stop_ap();
 
-    /* IP address of SoftAp. */
-    result = cy_wcm_get_ip_addr(CY_WCM_INTERFACE_TYPE_STA, &ip_addr);
-    PRINT_AND_ASSERT(result, "cy_wcm_get_ip_addr failed for creating HTTP server...! \n");
+    listen_msec = (uint32_t)(sta_listening - handover_start) * portTICK_PERIOD_MS;
+    overlap_msec = (uint32_t)(ap_stopped - sta_listening) * portTICK_PERIOD_MS;
+    server_stats_set_handover(listen_msec, overlap_msec);
 
-    http_server_ip_address.ip_address.ip.v4 = ip_addr.ip.v4;
-    http_server_ip_address.ip_address.version = CY_SOCKET_IP_VER_V4;
+    APP_INFO(("HTTP server handover: STA listening after %lu ms, overlap %lu ms\n",
+              (unsigned long)listen_msec, (unsigned long)overlap_msec));
 
-    /* Add IP address information to network interface object. */
-    nw_interface.object = (void *)&http_server_ip_address;
-    nw_interface.type = CY_NW_INF_TYPE_WIFI;
+    return result;
+}
 
-    /* Initialize secure socket library. */
-    result = cy_http_server_network_init();
+/*******************************************************************************
+* Function Name: format_telemetry_frame
+********************************************************************************
+* Summary:
+*  Formats the readings sent to the event streams of the device data page as
+*  one server sent event in telemetry_frame.
+*
+* Parameters:
+*  light_sensor_voltage - Light sensor voltage in mV, unused without the TFT.
+*  duty - PWM duty cycle in percent.
+*
+* Return:
+*  size_t - Length of the event in bytes.
+*
+*******************************************************************************/
+static size_t format_telemetry_frame(uint32_t light_sensor_voltage, uint8_t duty)
+{
+    size_t length = 0;
 
-    /* Allocate memory needed for secure HTTP server. */
-    result = cy_http_server_create(&nw_interface, HTTP_PORT, MAX_SOCKETS, NULL, &http_sta_server);
-    PRINT_AND_ASSERT(result, "Failed to allocate memory for the HTTP server.\n");
+    format_append(telemetry_frame, sizeof(telemetry_frame), &length, EVENT_STREAM_DATA);
+#ifdef ENABLE_TFT
+    format_append(telemetry_frame, sizeof(telemetry_frame), &length, TELEMETRY_LIGHT_SENSOR);
+    format_append_uint(telemetry_frame, sizeof(telemetry_frame), &length, light_sensor_voltage);
+    format_append(telemetry_frame, sizeof(telemetry_frame), &length, TELEMETRY_LIGHT_SENSOR_UNIT);
+#else
+    (void)light_sensor_voltage;
+#endif /* #ifdef ENABLE_TFT */
+    format_append(telemetry_frame, sizeof(telemetry_frame), &length, TELEMETRY_DUTY_CYCLE);
+    format_append_uint(telemetry_frame, sizeof(telemetry_frame), &length, duty);
+    format_append(telemetry_frame, sizeof(telemetry_frame), &length, LFLF);
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: send_event
+********************************************************************************
+* Summary:
+*  Sends one server sent event. A stream which cannot be written is closed by
+*  the client, and is removed from the connection manager.
+*
+* Parameters:
+*  stream - Event stream to write to.
+*  frame - The whole event, from the "data: " field to the blank line ending
+*          it.
+*  length - Length of the event in bytes.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS if the event was sent.
+*
+*******************************************************************************/
+static cy_rslt_t send_event(cy_http_response_stream_t *stream, const char *frame, uint32_t length)
+{
+    cy_rslt_t result;
+
+    result = cy_http_server_response_stream_write_payload(stream, frame, length);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        ERR_INFO(("Updating event stream failed\r\n"));
+        connection_manager_release(stream);
+    }
+    else
+    {
+        server_stats_add_sent(length, false);
+        connection_manager_activity(stream);
+    }
 
-    /* Configure server sent events*/
-    dynamic_sse_resource.resource_handler = process_sse_handler;
-    dynamic_sse_resource.arg = NULL;
-    result = cy_http_server_register_resource( http_sta_server,
-                                                (uint8_t*) "/events",
-                                                (uint8_t*)"text/event-stream",
-                                                CY_RAW_DYNAMIC_URL_CONTENT,
-                                                &dynamic_sse_resource);
-    PRINT_AND_ASSERT(result, "Failed to register a resource.\n");
-    
-    /* Configure dynamic resource handler. */
-    http_get_post_resource.resource_handler = softap_resource_handler;
-    http_get_post_resource.arg = NULL;
-
-    /* Register all the resources with the secure HTTP server. */
-    result = cy_http_server_register_resource(http_sta_server,
-                                              (uint8_t *)"/",
-                                              (uint8_t *)"text/html",
-                                              CY_DYNAMIC_URL_CONTENT,
-                                              &http_get_post_resource);
-    PRINT_AND_ASSERT(result, "Failed to register a resource.\n");
-
-    /* Start the HTTP server. */
-    result = cy_http_server_start(http_sta_server);
-    PRINT_AND_ASSERT(result, "Failed to start the HTTP server.\n");
-   
     return result;
 }
 
 /*******************************************************************************
-* Function Name: url_decode
+* Function Name: allocate_provisioning_state
 ********************************************************************************
+* Summary:
+*  Allocates the buffers used while the device is provisioned over the
+*  SoftAP from the provisioning arena, which is sized for them at build time.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
 *
+*******************************************************************************/
+static void allocate_provisioning_state(void)
+{
+    provisioning = (provisioning_state_t *)provisioning_arena_alloc(sizeof(provisioning_state_t));
+
+    memset(provisioning, 0, sizeof(*provisioning));
+    provisioning->credentials_fields[0].name = CREDENTIALS_FIELD_SSID;
+    provisioning->credentials_fields[0].value = provisioning->form_ssid;
+    provisioning->credentials_fields[0].capacity = sizeof(provisioning->form_ssid);
+    provisioning->credentials_fields[0].required = true;
+    provisioning->credentials_fields[1].name = CREDENTIALS_FIELD_PASSWORD;
+    provisioning->credentials_fields[1].value = provisioning->form_pwd;
+    provisioning->credentials_fields[1].capacity = sizeof(provisioning->form_pwd);
+    provisioning->credentials_fields[1].required = false;
+}
+
+/*******************************************************************************
+* Function Name: release_provisioning_state
+********************************************************************************
 * Summary:
-* This function is used to decode the url encoded HTTP data received.
+*  Releases the provisioning arena once the SoftAP server is gone, and hands
+*  its storage over to the sensor history. A scan still running for the
+*  SoftAP server is stopped first, and the page of its results given up.
 *
 * Parameters:
-* char* dst: Pointer to to whch decoded data should be copied.
-* const uint8_t* src: Pointer to url encoded data .
+*  void
 *
 * Return:
-* void: Returns void .
+*  void
 *
 *******************************************************************************/
-void url_decode(char *dst, const uint8_t *src)
+static void release_provisioning_state(void)
 {
-    char current_char, next_char;
-    /* Ensure that the received character is a valid character. */
-    while ((*src) && ((*src) < VALID_CHARACTER_ASCII_VALUE))
+    void *storage;
+    size_t length;
+    uint32_t records;
+    uint32_t waited_msec = 0u;
+
+    if (scan_running)
     {
-        /* URL encoding replaces unsafe ASCII characters with a "%" followed 
-         * by two hexadecimal digits. Check for character "%" followed by
-         * two hexadecimal digits to decode unsafe ASCII characters.
-         */
-        if ((*src == MODUS_OPERATOR_ASCII_VALUE) && ((current_char = src[1]) && (next_char = src[2])) && (isxdigit(current_char) && isxdigit(next_char)))
-        {
-            if (current_char >= SMALL_LETTER_A_ASCII_VALUE)
-            {
-                current_char -= SMALL_LETTER_A_ASCII_VALUE - CAPITAL_LETTER_A_ASCII_VALUE;
-            }
-            if (current_char >= CAPITAL_LETTER_A_ASCII_VALUE)
-            {
-                current_char -= (CAPITAL_LETTER_A_ASCII_VALUE - LF_OPERATOR_ASCII_VALUE);
-            }
-            else
-            {
-                current_char -= NUMBER_ZERO_ASCII_VALUE;
-            }
-            if (next_char >= SMALL_LETTER_A_ASCII_VALUE)
-            {
-                next_char -= SMALL_LETTER_A_ASCII_VALUE - CAPITAL_LETTER_A_ASCII_VALUE;
-            }
-            if (next_char >= CAPITAL_LETTER_A_ASCII_VALUE)
-            {
-                next_char -= (CAPITAL_LETTER_A_ASCII_VALUE - LF_OPERATOR_ASCII_VALUE);
-            }
-            else
-            {
-                next_char -= NUMBER_ZERO_ASCII_VALUE ;
-            }
-            *dst++ = DLE_OPERATOR_ASCII_VALUE * current_char + next_char;
-            src += URL_DECODE_ASCII_OFFSET_VALUE;
-        }
-        /* A space character is URL encoded as "+". Decode space character. */
-        else if (*src == PLUS_OPERATOR_ASCII_VALUE)
-        {
-            *dst++ = SPACE_CHARACTER_ASCII_VALUE;
-            src++;
-        }
-        /* Decode other characters. */
-        else
+        cy_wcm_stop_scan();
+        provisioning = NULL;
+        scan_complete_flag = true;
+
+        /* Let scan_for_available_aps see the stop before the buffers go */
+        while (scan_running && (waited_msec < SCAN_STOP_TIMEOUT_MS))
         {
-            *dst++ = *src++;
+            vTaskDelay(pdMS_TO_TICKS(SCAN_DELAY_MS));
+            waited_msec += SCAN_DELAY_MS;
         }
-
     }
 
-    *dst++ = NULL_CHARACTER_ASCII_VALUE;
-    
+    provisioning = NULL;
+    credentials_stream = NULL;
+    storage = provisioning_arena_release(&length);
+    records = history_add_storage(storage, length);
+
+    APP_INFO(("Reclaimed %u bytes of provisioning buffers for %lu more history records\r\n",
+              (unsigned int)length, (unsigned long)records));
 }
 
 /*******************************************************************************
 * Function Name: server_task
 ********************************************************************************
 * Summary:
-*  Task that initializes the device as SoftAp, and starts the HTTP server
+*  Task that connects the device to the stored Wi-Fi network, or else
+*  initializes it as SoftAp for provisioning, and starts the HTTP server
 *
 * Parameters:
 *  arg - Unused.
@@ -925,35 +1700,65 @@ void server_task(void *arg)
 
     uint8_t light_sensor_reading = 0;
     uint16_t light_sensor_voltage = 0;
+    sensor_snapshot_t sensor_snapshot;
 #endif /* #ifdef ENABLE_TFT */
 
     uint8_t duty_cycle_reading = 0;
-    char sensor_value_buffer[SENSOR_BUFFER_LENGTH];
-    char http_response[MAX_HTTP_RESPONSE_LENGTH] = {0};
+    size_t telemetry_length;
+    cy_http_response_stream_t *event_streams[CONNECTION_MAX_EVENT_STREAMS];
+    uint8_t event_stream_count;
 
 #ifdef ENABLE_TFT
     /*Initialize and setup TFT display */
     initialize_display();
 #endif /* #ifdef ENABLE_TFT */
 
+    /* Initialize the sensor history used by the export resource */
+    initialize_history();
+    connection_manager_init();
+    rate_limiter_init();
+    stats_response_mutex = xSemaphoreCreateMutexStatic(&stats_response_mutex_buffer);
+    configASSERT(stats_response_mutex != NULL);
+    asset_fs_init();
+    wifi_link_init();
+    scan_events_init();
+
     /* Initialize the Wi-Fi device as a STA.*/
     cy_wcm_config_t config = {.interface = CY_WCM_INTERFACE_TYPE_AP_STA};
    
     /* Initialize the Wi-Fi device, Wi-Fi transport, and lwIP network stack.*/
     result = cy_wcm_init(&config);
     PRINT_AND_ASSERT(result,"cy_wcm_init failed...!\n");
+    boot_timeline_mark(BOOT_EVENT_WIFI_READY);
+
+    /* Initialize secure socket library. */
+    result = cy_http_server_network_init();
+    PRINT_AND_ASSERT(result, "Failed to initialize the secure socket library.\n");
 
-    result = start_ap_mode();
-   // PRINT_AND_ASSERT(result, "start SoftAP failed...!\n");
+    if (start_sta_mode_from_store())
+    {
+        /* Skip provisioning, the STA server is started by the loop below. */
+        device_configured = true;
+        reconfiguration_request = SERVER_RECONFIGURE_REQUESTED;
+    }
+    else
+    {
+        allocate_provisioning_state();
+        result = start_ap_mode();
+       // PRINT_AND_ASSERT(result, "start SoftAP failed...!\n");
+        boot_timeline_mark(BOOT_EVENT_SOFTAP_STARTED);
 
-    result = configure_http_server();
-    PRINT_AND_ASSERT(result, "Failed to configure the HTTP server...!\n");
+        result = configure_http_server();
+        PRINT_AND_ASSERT(result, "Failed to configure the HTTP server...!\n");
 
-    /* Start the HTTP server. */
-    result = cy_http_server_start(http_ap_server);
-    PRINT_AND_ASSERT(result, "Failed to start the HTTP server.\n");
+        /* Start the HTTP server. */
+        result = cy_http_server_start(http_ap_server);
+        PRINT_AND_ASSERT(result, "Failed to start the HTTP server.\n");
+        http_ap_server_running = true;
+        boot_timeline_mark(BOOT_EVENT_SERVER_LISTENING);
 
-    display_configuration();
+        display_configuration();
+    }
     
     /* Waits for queue message to register a new HTTP page resource.*/
     while (true)
@@ -993,59 +1798,66 @@ void server_task(void *arg)
            /*Calculate lightsensor voltage.*/
            light_sensor_reading = mtb_light_sensor_light_level(&light_sensor_obj);
            light_sensor_voltage = (uint32_t)((light_sensor_reading * LIGHTSENSOR_ADC_MAX_VOLTAGE) / LIGHTSENSOR_ADC_MAX_COUNT);
+
+           /* Record the readings for the history export */
+           history_update(light_sensor_voltage, duty_cycle_reading);
+#else
+           history_update(0u, duty_cycle_reading);
 #endif /* #ifdef ENABLE_TFT */
 
 #ifdef ENABLE_TFT
-        /* Display data on LCD */
-        sprintf(sensor_value_buffer, "%04d mV", light_sensor_voltage);
-        GUI_DispStringAt(sensor_value_buffer, SENSOR_DISPLAY_OFFSET, light_sensor_row_print);
-        sprintf(sensor_value_buffer, "%03d %%", duty_cycle_reading);
-        GUI_DispStringAt(sensor_value_buffer, SENSOR_DISPLAY_OFFSET, duty_cycle_row_print);
+        /* Hand the readings over to the display task */
+        sensor_snapshot.light_sensor_voltage = light_sensor_voltage;
+        sensor_snapshot.duty = duty_cycle_reading;
+        display_update(&sensor_snapshot);
 #endif /* #ifdef ENABLE_TFT */
 
         /* Send the event stream with light sensor voltage and duty cycle */
-        if( http_event_stream != NULL )
+        event_stream_count = connection_manager_get_event_streams(event_streams, CONNECTION_MAX_EVENT_STREAMS);
+        if( event_stream_count != 0 )
         {
 #ifdef ENABLE_TFT
-            sprintf(sensor_value_buffer, "Light Sensor Voltage: %dmV <br> PWM Duty Cycle: %d", light_sensor_voltage, duty_cycle_reading);
-
+            telemetry_length = format_telemetry_frame(light_sensor_voltage, duty_cycle_reading);
 #else
-            sprintf(sensor_value_buffer, "PWM Duty Cycle: %d", duty_cycle_reading);
+            telemetry_length = format_telemetry_frame(0u, duty_cycle_reading);
 #endif /* #ifdef ENABLE_TFT */
-            strcpy(http_response, (char*)sensor_value_buffer);
 
-            /* Add event stream header */
-            result = cy_http_server_response_stream_write_payload( http_event_stream, (const void*)EVENT_STREAM_DATA, sizeof( EVENT_STREAM_DATA ) - 1);
-            if(result != CY_RSLT_SUCCESS){
-                ERR_INFO(("Updating event stream failed"));
-                http_event_stream = NULL;
+            for (uint8_t index = 0; index < event_stream_count; index++)
+            {
+                send_event(event_streams[index], telemetry_frame, telemetry_length);
             }
+        }
 
-            /* Message to client */
-            result = cy_http_server_response_stream_write_payload( http_event_stream, http_response, sizeof(http_response) - 1);
-            if(result != CY_RSLT_SUCCESS){
-                ERR_INFO(("Updating event stream failed"));
-                http_event_stream = NULL;
-            }
+           /* Close the stale event streams, forget the idle connections */
+           connection_manager_poll();
 
-            /* SSE is ended with two line feeds */
-            result = cy_http_server_response_stream_write_payload( http_event_stream, (const void*)LFLF, sizeof( LFLF ) - 1);
-            if(result != CY_RSLT_SUCCESS){
-                ERR_INFO(("Updating event stream failed\r\n"));
-                http_event_stream = NULL;
-            }
-        }
+           server_stats_sample_heap();
 
            vTaskDelay(pdMS_TO_TICKS(50));
 
         }
+        else if (SERVER_RECONFIGURE_REQUESTED != reconfiguration_request)
+        {
+            /* Forget the idle connections of the SoftAP server */
+            connection_manager_poll();
+            vTaskDelay(pdMS_TO_TICKS(CONNECTION_POLL_INTERVAL_MSEC));
+        }
 
         if(SERVER_RECONFIGURE_REQUESTED == reconfiguration_request)
         {
             reconfigure_http_server();
+            wifi_link_start_monitor();
             display_configuration();
+#ifdef ENABLE_TFT
+            start_display_task(light_sensor_row_print, duty_cycle_row_print);
+#endif /* #ifdef ENABLE_TFT */
             initialize_sensors();
+            release_provisioning_state();
             reconfiguration_request = SERVER_RECONFIGURED;
+
+            /* The deepest calls of the task are behind it, see SERVER_TASK_STACK_SIZE */
+            APP_INFO(("Server task stack high-water mark: %lu bytes free\r\n",
+                      (unsigned long)(uxTaskGetStackHighWaterMark(NULL) * sizeof(StackType_t))));
         }
 
     }
@@ -1102,11 +1914,13 @@ void display_configuration(void)
     cy_rslt_t result = CY_RSLT_SUCCESS;
 
     uint32_t ip_addr;
-    char display_ip_buffer[DISPLAY_BUFFER_LENGTH];
+    char display_ip_buffer[FORMAT_IPV4_BUFFER_LENGTH];
     char http_url[URL_LENGTH]={0};
+    size_t http_url_length = 0;
 
 #ifdef ENABLE_TFT
     char display_buffer[SENSOR_BUFFER_LENGTH];
+    size_t display_length;
 #endif /* #ifdef ENABLE_TFT */
 
     if(reconfiguration_request == 0)
@@ -1117,12 +1931,11 @@ void display_configuration(void)
 
         /*Print message to connect to that ip address*/
         ip_addr = ip_address.ip.v4;
-        sprintf(display_ip_buffer, "%u.%u.%u.%u",  (unsigned char) ( ( ip_addr >> 0 ) & 0xff ),
-                (unsigned char) ( ( ip_addr >> 8 ) & 0xff ),
-                (unsigned char) ( ( ip_addr >> 16 ) & 0xff ),
-                (unsigned char) ( ( ip_addr >> 24 ) & 0xff ));
-
-        sprintf(http_url, "http://%s:%d", display_ip_buffer, HTTP_PORT);
+        format_ipv4(display_ip_buffer, ip_addr);
+        format_append(http_url, sizeof(http_url), &http_url_length, "http://");
+        format_append(http_url, sizeof(http_url), &http_url_length, display_ip_buffer);
+        format_append(http_url, sizeof(http_url), &http_url_length, ":");
+        format_append_uint(http_url, sizeof(http_url), &http_url_length, HTTP_PORT);
 
         APP_INFO(("****************************************************************************\r\n"));
         APP_INFO(("Using another device, connect to the following Wi-Fi network:\r\n"));
@@ -1144,11 +1957,9 @@ void display_configuration(void)
         row +=ROW_OFFSET;
         GUI_DispStringAt("network: \r\n", 0, row);
         row +=ROW_OFFSET;
-        sprintf(display_buffer, "SSID: %s \r\n", SOFTAP_SSID);
-        GUI_DispStringAt(display_buffer, 0, row);
+        GUI_DispStringAt("SSID: " SOFTAP_SSID " \r\n", 0, row);
         row +=ROW_OFFSET;
-        sprintf(display_buffer, "Password: %s \r\n", SOFTAP_PASSWORD);
-        GUI_DispStringAt(display_buffer, 0, row);
+        GUI_DispStringAt("Password: " SOFTAP_PASSWORD " \r\n", 0, row);
         row +=ROW_OFFSET;   
         GUI_DispStringAt("Open a web browser of your choice and enter the URL : \r\n", 0, row);
         row +=ROW_OFFSET;
@@ -1169,12 +1980,11 @@ void display_configuration(void)
 
         /*Print message to connect to that ip address*/
         ip_addr = ip_address.ip.v4;
-        sprintf(display_ip_buffer, "%u.%u.%u.%u",  (unsigned char) ( ( ip_addr >> 0 ) & 0xff ),
-                (unsigned char) ( ( ip_addr >> 8 ) & 0xff ),
-                (unsigned char) ( ( ip_addr >> 16 ) & 0xff ),
-                (unsigned char) ( ( ip_addr >> 24 ) & 0xff ));
-                
-        sprintf(http_url, "http://%s:%d", display_ip_buffer, HTTP_PORT);
+        format_ipv4(display_ip_buffer, ip_addr);
+        format_append(http_url, sizeof(http_url), &http_url_length, "http://");
+        format_append(http_url, sizeof(http_url), &http_url_length, display_ip_buffer);
+        format_append(http_url, sizeof(http_url), &http_url_length, ":");
+        format_append_uint(http_url, sizeof(http_url), &http_url_length, HTTP_PORT);
         
         /*Get the associated AP informations. */
         cy_wcm_get_associated_ap_info(&associated_ap_info);
@@ -1199,7 +2009,9 @@ void display_configuration(void)
         GUI_SetFont(GUI_FONT_13B_1);
         GUI_DispStringAt("On a device connected to the Wi-Fi network\r\n", 0, row);
         row += ROW_OFFSET;
-        sprintf(display_buffer, "%s, \r\n", associated_ap_info.SSID);
+        display_length = 0;
+        format_append(display_buffer, sizeof(display_buffer), &display_length, (char *)associated_ap_info.SSID);
+        format_append(display_buffer, sizeof(display_buffer), &display_length, ", \r\n");
         GUI_DispStringAt(display_buffer, 0, row);
         row += ROW_OFFSET;
         GUI_DispStringAt("open a web browser and go to : \r\n", 0, row);
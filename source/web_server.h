@@ -55,8 +55,28 @@
 
 #include "cyabs_rtos.h"
 #include "cy_http_server.h"
-#include "html_web_page.h"
 #include "sensors.h"
+#include "sensor_history.h"
+#include "fast_format.h"
+#include "response_builder.h"
+#include "template_engine.h"
+#include "page_templates.h"
+#include "asset_fs.h"
+#include "server_stats.h"
+#include "connection_manager.h"
+#include "rate_limiter.h"
+#include "router.h"
+#include "route_table.h"
+#include "credential_store.h"
+#include "boot_timeline.h"
+#include "wifi_link.h"
+#include "scan_cache.h"
+#include "scan_filter.h"
+#include "scan_events.h"
+#include "form_parser.h"
+#include "provisioning_arena.h"
+#include "rtos_memory.h"
+#include "url_decode.h"
 
 #ifdef ENABLE_TFT
 /* CY8CKIT-028-TFT shield and LCD library */
@@ -64,6 +84,7 @@
 #include "mtb_st7789v.h"
 #include "cy8ckit_028_tft_pins.h"
 #include "mtb_light_sensor.h"
+#include "display_task.h"
 #endif /* #ifdef ENABLE_TFT */
 
 #define INITIALISER_IPV4_ADDRESS(addr_var, addr_val)  addr_var = { CY_WCM_IP_VER_V4, { .v4 = (uint32_t)(addr_val) } }
@@ -82,19 +103,35 @@
                                                            }                              \
                                                       } while(0);
 
+/* Server task stack size in words, and priority. The task runs the Wi-Fi
+ * initialization, the scan before connecting and the credential store on its
+ * own stack. Its high-water mark is printed once the STA server is up and
+ * reported by /api/stats; reduce the size only from a measured figure.
+ */
+#define SERVER_TASK_STACK_SIZE                       (10 * 1024)
+#define SERVER_TASK_PRIORITY                         (1)
+
+/* RAM taken by the server task, checked against its storage in main.c. */
+#define SERVER_TASK_MEMORY                           RTOS_TASK_MEMORY(SERVER_TASK_STACK_SIZE)
+
 #define HTTP_PORT                                    (80u)
 #define URL_LENGTH                                   (128)
-#define MAX_SOCKETS                                  (4)
-#define MAX_HTTP_RESPONSE_LENGTH                     (sizeof(HTTP_SOFTAP_STARTUP_WEBPAGE) + 64)
+#define MAX_SOCKETS                                  (CONNECTION_SLOT_COUNT)
 #define HTTP_REQUEST_HANDLE_SUCCESS                  (0)
 #define HTTP_REQUEST_HANDLE_ERROR                    (-1)
-#define DEVICE_DATA_RESPONSE_LENGTH                  (sizeof(SOFTAP_DEVICE_DATA) + 64)
-#define WIFI_CONNECT_RESPONSE_LENGTH                 (sizeof(WIFI_CONNECT_RESPONSE_START) + sizeof(WIFI_CONNECT_SUCCESS_RESPONSE_END) + sizeof(WIFI_CONNECT_IN_PROGRESS) + 140)
 
+/* Size of the list of SSIDs found by a scan of the SoftAP scan page. */
 #define BUFFER_LENGTH                                (2048)
 #define WIFI_SSID_LEN                                (32u)
 #define WIFI_PWD_LEN                                 (64u)
-#define MAX_WIFI_SCAN_HTTP_RESPONSE_LENGTH           (2048)
+/* Fields of the credentials form posted to "/" on the SoftAP server */
+#define CREDENTIALS_FIELD_SSID                       "SSID"
+#define CREDENTIALS_FIELD_PASSWORD                   "Password"
+#define CREDENTIALS_FIELD_COUNT                      (2u)
+/* Size of the buffer in which the scan and connect pages are assembled before
+ * being written to the stream.
+ */
+#define RESPONSE_CHUNK_LENGTH                        (256u)
 
 #define SENSOR_BUFFER_LENGTH                         (128)
 #define DISPLAY_BUFFER_LENGTH                        (64)
@@ -113,14 +150,24 @@
 #define SOFTAP_GATEWAY                               MAKE_IPV4_ADDRESS(192, 168, 0,  2)
 
 #define MAX_WIFI_RETRY_COUNT                         (3u)
+/* Backoff between connection attempts, doubled after every failed attempt
+ * up to the maximum, with random jitter.
+ */
 #define WIFI_CONN_RETRY_INTERVAL_MSEC                (100u)
+#define WIFI_CONN_RETRY_MAX_INTERVAL_MSEC            (5000u)
 
 /* HTTP headers used in response to client */
-#define HTTP_HEADER_204                              "HTTP/1.1 204 No Content"
+/* Complete 204 response of a raw resource, which leaves the connection open. */
+#define HTTP_RESPONSE_204                            "HTTP/1.1 204 No Content\r\n" HTTP_CONNECTION_HEADERS "\r\n"
+/* Size of the buffer in which the header of a raw response is assembled. */
+#define HTTP_HEADER_LENGTH                           (160u)
 
 /* The delay in milliseconds between successive scans.*/
 #define SCAN_DELAY_MS                                (5000u)
 
+/* Longest wait for a scan stopped when the provisioning buffers are released */
+#define SCAN_STOP_TIMEOUT_MS                         (2u * SCAN_DELAY_MS)
+
 /* The delay in milliseconds between successive data upload.*/
 #define WIFI_DATA_UPLOAD_INTERVAL_MSEC               (50u)
 
@@ -137,6 +184,47 @@
 #define LFLF                                         "\n\n"
 #define CHUNKED_CONTENT_LENGTH                       (0u)
 
+/* Readings sent to the event streams of the device data page */
+#define TELEMETRY_LIGHT_SENSOR                       "Light Sensor Voltage: "
+#define TELEMETRY_LIGHT_SENSOR_UNIT                  "mV <br> "
+#define TELEMETRY_DUTY_CYCLE                         "PWM Duty Cycle: "
+
+/* Size of the buffer holding one telemetry event, from "data: " to the
+ * blank line ending it, with its NUL.
+ */
+#define TELEMETRY_FRAME_LENGTH                       (sizeof(EVENT_STREAM_DATA) + sizeof(TELEMETRY_LIGHT_SENSOR) + \
+                                                      sizeof(TELEMETRY_LIGHT_SENSOR_UNIT) + sizeof(TELEMETRY_DUTY_CYCLE) + \
+                                                      sizeof(LFLF) + (2 * FORMAT_UINT_MAX_DIGITS) - 4)
+
+/* Size of the buffer used to assemble one chunk of the history export. */
+#define EXPORT_CHUNK_LENGTH                          (256u)
+/* Maximum length of one formatted history record. */
+#define EXPORT_RECORD_LENGTH                         (80u)
+/* Size of the buffer used to assemble the server statistics. The buffer is
+ * static, shared by the threads of both HTTP servers under a mutex.
+ */
+#define STATS_RESPONSE_LENGTH                        (2048u)
+/* RAM taken by the mutex of the statistics buffer, checked against its storage. */
+#define STATS_MUTEX_MEMORY                           RTOS_MUTEX_MEMORY
+/* Maximum number of digits accepted in a numeric query parameter. */
+#define QUERY_VALUE_MAX_DIGITS                       (10u)
+
+/* History export formats selected by the "format" query parameter */
+#define EXPORT_FORMAT_CSV                            "csv"
+#define EXPORT_FORMAT_NDJSON                         "ndjson"
+
+#ifdef ENABLE_TFT
+#define EXPORT_CSV_HEADER                            "time_s,light_sensor_mv,duty_cycle\n"
+#else
+#define EXPORT_CSV_HEADER                            "time_s,duty_cycle\n"
+#endif /* #ifdef ENABLE_TFT */
+
+/* Field prefixes of a history record in NDJSON format */
+#define EXPORT_NDJSON_TIME                           "{\"time_s\":"
+#define EXPORT_NDJSON_LIGHT_SENSOR                   ",\"light_sensor_mv\":"
+#define EXPORT_NDJSON_DUTY_CYCLE                     ",\"duty_cycle\":"
+#define EXPORT_NDJSON_END                            "}\n"
+
 #define INCREASE                                     ("Increase")
 #define DECREASE                                     ("Decrease")
 
@@ -148,6 +236,12 @@
 #define SERVER_RECONFIGURE_REQUESTED                 (1u)
 #define SERVER_RECONFIGURED                          (2u)
 
+/* Time for which the SoftAP server keeps running once the STA server is
+ * listening, so that the client can finish the redirect to the device data
+ * page before the SoftAP goes down.
+ */
+#define SERVER_HANDOVER_GRACE_MSEC                   (500u)
+
 /* The size of the cy_wcm_ip_address_t array that is passed to
  * cy_wcm_get_ip_addr API. In the case of stand-alone AP or STA mode, the size of
  * the array is 1. In concurrent AP/STA mode, the size of the array is 2 where
@@ -156,30 +250,29 @@
  */
 #define SIZE_OF_IP_ARRAY_STA                        (1u)
 
-
-/* Macros that defines ASCII characters used in the code example */ 
-#define CAPITAL_LETTER_A_ASCII_VALUE                (65u)
-#define SMALL_LETTER_A_ASCII_VALUE                  (97u)
-#define NUMBER_ZERO_ASCII_VALUE                     (48u)
-#define LF_OPERATOR_ASCII_VALUE                     (10u)
-#define DLE_OPERATOR_ASCII_VALUE                    (16u)
-#define MODUS_OPERATOR_ASCII_VALUE                  (37u)
-#define PLUS_OPERATOR_ASCII_VALUE                   (43u)
-#define EQUALS_OPERATOR_ASCII_VALUE                 (61u)
-#define AMPERSAND_OPERATOR_ASCII_VALUE              (38u)
-#define SPACE_CHARACTER_ASCII_VALUE                 (32u)
-#define NULL_CHARACTER_ASCII_VALUE                  (0u)
-#define VALID_CHARACTER_ASCII_VALUE                 (128u)
-#define URL_DECODE_ASCII_OFFSET_VALUE               (3u)
-
-
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+/* Buffers used only while the device is provisioned over the SoftAP, which
+ * live in the provisioning arena.
+ */
+typedef struct
+{
+    char                ssid_list[BUFFER_LENGTH];   /* SSIDs found by the scan, one per line */
+    response_builder_t  scan_list_builder;          /* Builder writing ssid_list */
+    scan_options_t      scan_options;               /* Options of the scan in progress */
+    uint8_t             form_ssid[WIFI_SSID_LEN];   /* Fields of the credentials form being received, */
+    uint8_t             form_pwd[WIFI_PWD_LEN];     /* copied to wifi_ssid and wifi_pwd once it is valid */
+    form_field_t        credentials_fields[CREDENTIALS_FIELD_COUNT];
+    form_parser_t       credentials_parser;
+} provisioning_state_t;
 
 void server_task(void *arg);
-cy_rslt_t wifi_extract_credentials(const uint8_t *data, uint32_t data_len, cy_http_response_stream_t *stream);
+cy_rslt_t wifi_extract_credentials(const cy_http_message_body_t *body, cy_http_response_stream_t *stream);
 cy_rslt_t start_sta_mode(void);
+bool start_sta_mode_from_store(void);
 cy_rslt_t start_ap_mode(void);
-void scan_for_available_aps(cy_http_response_stream_t *url_stream);
-void url_decode(char *dst, const uint8_t *src);
+void scan_for_available_aps(cy_http_response_stream_t *url_stream, const scan_options_t *options);
 void initialize_display(void);
 void display_configuration(void);
 cy_rslt_t configure_http_server(void);
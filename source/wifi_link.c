@@ -0,0 +1,830 @@
+/******************************************************************************
+* File Name: wifi_link.c
+*
+* Description: This file contains the Wi-Fi link manager. A connection is
+*              first attempted with the BSSID, band and security type of the
+*              AP last connected to, which lets the Wi-Fi driver join without
+*              searching every channel, and falls back to a search by SSID.
+*              When the AP is not cached, its details are looked up in the
+*              scan cache, scanning for the network if it has not been seen
+*              recently, so that even the first attempt uses the right
+*              security type. Failed attempts are retried after an
+*              exponential backoff with random jitter. Once the device serves on the STA interface,
+*              the link monitor task reconnects whenever the connection
+*              manager reports that the link was lost, and measures how long
+*              the link was down.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "web_server.h"
+#include "wifi_link.h"
+
+/* Standard C header files */
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS header files */
+#include <FreeRTOS.h>
+#include <task.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Parameters of the last connection, reused by the link monitor. */
+static cy_wcm_connect_params_t connect_params;
+
+/* Association details of the AP last connected to, and its SSID. */
+static wifi_link_ap_t cached_ap;
+static cy_wcm_ssid_t cached_ssid;
+static bool ap_cached = false;
+
+/* Statistics, updated inside critical sections. */
+static wifi_link_stats_t link_stats;
+
+/* Tick count at which the link was lost, valid while link_lost is set. */
+static uint32_t link_lost_tick;
+static bool link_lost = false;
+
+/* Set while the device moves to another AP, so that the disconnection from
+ * the current one is not taken for a lost link.
+ */
+static volatile bool roaming = false;
+
+/* Tick count of the last roaming scan, valid once roam_scanned is set. */
+static uint32_t roam_scan_tick;
+static bool roam_scanned = false;
+
+/* Ring of the last RSSI samples in dBm, updated inside critical sections. */
+static int8_t rssi_history[WIFI_LINK_HISTORY_LENGTH];
+static uint8_t rssi_history_head = 0;
+static uint8_t rssi_history_count = 0;
+
+static TaskHandle_t link_monitor_task_handle = NULL;
+static StackType_t link_monitor_task_stack[LINK_MONITOR_TASK_STACK_SIZE];
+static StaticTask_t link_monitor_task_tcb;
+_Static_assert((sizeof(link_monitor_task_stack) + sizeof(link_monitor_task_tcb)) == LINK_MONITOR_TASK_MEMORY,
+               "LINK_MONITOR_TASK_MEMORY does not match the storage of the link monitor task");
+
+/*******************************************************************************
+* Function Name: backoff_delay_msec
+********************************************************************************
+* Summary:
+*  Returns the delay before the next connection attempt: a random time
+*  between half and all of WIFI_CONN_RETRY_INTERVAL_MSEC doubled for every
+*  failed attempt, up to WIFI_CONN_RETRY_MAX_INTERVAL_MSEC. The jitter keeps
+*  devices which lost the same AP from retrying in step.
+*
+* Parameters:
+*  attempt - Number of attempts made so far, at least 1.
+*
+* Return:
+*  uint32_t - Delay in milliseconds.
+*
+*******************************************************************************/
+static uint32_t backoff_delay_msec(uint32_t attempt)
+{
+    uint32_t ceiling = WIFI_CONN_RETRY_INTERVAL_MSEC;
+
+    while ((attempt > 1u) && (ceiling < WIFI_CONN_RETRY_MAX_INTERVAL_MSEC))
+    {
+        ceiling <<= 1;
+        attempt--;
+    }
+    if (ceiling > WIFI_CONN_RETRY_MAX_INTERVAL_MSEC)
+    {
+        ceiling = WIFI_CONN_RETRY_MAX_INTERVAL_MSEC;
+    }
+
+    return (ceiling / 2u) + ((uint32_t)rand() % ((ceiling / 2u) + 1u));
+}
+
+/*******************************************************************************
+* Function Name: remember_ap
+********************************************************************************
+* Summary:
+*  Caches the association details of the AP the device is connected to.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void remember_ap(void)
+{
+    cy_wcm_associated_ap_info_t ap_info;
+
+    if (CY_RSLT_SUCCESS != cy_wcm_get_associated_ap_info(&ap_info))
+    {
+        return;
+    }
+
+    memcpy(cached_ap.bssid, ap_info.BSSID, sizeof(cached_ap.bssid));
+    cached_ap.channel = ap_info.channel;
+    cached_ap.band = (ap_info.channel > WIFI_LINK_MAX_2_4GHZ_CHANNEL) ?
+                     CY_WCM_WIFI_BAND_5GHZ : CY_WCM_WIFI_BAND_2_4GHZ;
+    cached_ap.security = (uint32_t)ap_info.security;
+    memcpy(cached_ssid, connect_params.ap_credentials.SSID, sizeof(cached_ssid));
+    ap_cached = true;
+}
+
+/*******************************************************************************
+* Function Name: learn_ap_from_scan
+********************************************************************************
+* Summary:
+*  Caches the details of the strongest AP of the network in connect_params,
+*  as found in the scan cache. If the network has not been seen within
+*  SCAN_CACHE_MAX_AGE_MSEC, a scan for its SSID is run first.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void learn_ap_from_scan(void)
+{
+    scan_cache_entry_t entry;
+    const uint8_t *ssid = connect_params.ap_credentials.SSID;
+
+    if (!scan_cache_find(ssid, SCAN_CACHE_MAX_AGE_MSEC, &entry))
+    {
+        taskENTER_CRITICAL();
+        link_stats.ssid_scans++;
+        taskEXIT_CRITICAL();
+
+        if ((CY_RSLT_SUCCESS != scan_cache_scan_ssid(ssid)) ||
+            !scan_cache_find(ssid, SCAN_CACHE_MAX_AGE_MSEC, &entry))
+        {
+            APP_INFO(("Wi-Fi network '%s' not found by the scan, assuming WPA2\r\n", (const char *)ssid));
+            return;
+        }
+    }
+
+    memcpy(cached_ap.bssid, entry.bssid, sizeof(cached_ap.bssid));
+    cached_ap.channel = entry.channel;
+    cached_ap.band = entry.band;
+    cached_ap.security = entry.security;
+    memcpy(cached_ssid, ssid, sizeof(cached_ssid));
+    ap_cached = true;
+
+    taskENTER_CRITICAL();
+    link_stats.scan_lookups++;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: link_restored
+********************************************************************************
+* Summary:
+*  Accounts for a lost link being up again, whether it was restored by the
+*  link monitor or by the retries of the connection manager.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void link_restored(void)
+{
+    uint32_t down_msec = 0;
+    bool restored = false;
+
+    taskENTER_CRITICAL();
+    if (link_lost)
+    {
+        down_msec = (xTaskGetTickCount() - link_lost_tick) * portTICK_PERIOD_MS;
+        link_stats.reconnects++;
+        link_stats.last_reconnect_msec = down_msec;
+        if (down_msec > link_stats.max_reconnect_msec)
+        {
+            link_stats.max_reconnect_msec = down_msec;
+        }
+        link_lost = false;
+        restored = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (restored)
+    {
+        APP_INFO(("Wi-Fi link restored after %lu ms\r\n", (unsigned long)down_msec));
+    }
+}
+
+/*******************************************************************************
+* Function Name: connect_with_backoff
+********************************************************************************
+* Summary:
+*  Connects with connect_params. The first attempt uses the cached details
+*  of the AP, if any; the following ones search by SSID, after a backoff.
+*
+* Parameters:
+*  max_attempts - Maximum number of attempts, or WIFI_LINK_RETRY_FOREVER to
+*                 keep trying until the link is up.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS once connected, otherwise the error of the
+*  last attempt.
+*
+*******************************************************************************/
+static cy_rslt_t connect_with_backoff(uint32_t max_attempts)
+{
+    cy_rslt_t result;
+    cy_wcm_ip_address_t ip_address;
+    bool use_cache = ap_cached;
+    uint32_t attempt = 0;
+    uint32_t delay_msec;
+
+    while (true)
+    {
+        if (use_cache)
+        {
+            memcpy(connect_params.BSSID, cached_ap.bssid, sizeof(connect_params.BSSID));
+            connect_params.band = (cy_wcm_wifi_band_t)cached_ap.band;
+            connect_params.ap_credentials.security = (cy_wcm_security_t)cached_ap.security;
+        }
+        else
+        {
+            memset(connect_params.BSSID, 0, sizeof(connect_params.BSSID));
+            connect_params.band = CY_WCM_WIFI_BAND_ANY;
+        }
+
+        memset(&ip_address, 0, sizeof(ip_address));
+        result = cy_wcm_connect_ap(&connect_params, &ip_address);
+        attempt++;
+
+        if (CY_RSLT_SUCCESS == result)
+        {
+            taskENTER_CRITICAL();
+            link_stats.connects++;
+            link_stats.fast_connects += use_cache ? 1u : 0u;
+            link_stats.first_attempt_connects += (attempt == 1u) ? 1u : 0u;
+            link_stats.last_attempts = attempt;
+            taskEXIT_CRITICAL();
+            remember_ap();
+            return result;
+        }
+
+        if ((WIFI_LINK_RETRY_FOREVER != max_attempts) && (attempt >= max_attempts))
+        {
+            return result;
+        }
+
+        /* The AP may have moved to another BSSID or band, search right away */
+        if (use_cache)
+        {
+            ERR_INFO(("Connection to the cached BSSID failed with error code %d, searching by SSID.\n", (int)result));
+            use_cache = false;
+            continue;
+        }
+
+        delay_msec = backoff_delay_msec(attempt);
+        ERR_INFO(("Connection to Wi-Fi network failed with error code %d. Retrying in %lu ms...\n",
+                  (int)result, (unsigned long)delay_msec));
+        vTaskDelay(pdMS_TO_TICKS(delay_msec));
+
+        /* The connection manager may have reconnected by itself meanwhile */
+        if ((WIFI_LINK_RETRY_FOREVER == max_attempts) && cy_wcm_is_connected_to_ap())
+        {
+            return CY_RSLT_SUCCESS;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: link_event_callback
+********************************************************************************
+* Summary:
+*  Wi-Fi connection manager event callback. Runs in the context of the
+*  connection manager, so the reconnection is left to the link monitor task.
+*
+* Parameters:
+*  event - Connection manager event.
+*  event_data - Data of the event.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void link_event_callback(cy_wcm_event_t event, cy_wcm_event_data_t *event_data)
+{
+    (void)event_data;
+
+    switch (event)
+    {
+        case CY_WCM_EVENT_DISCONNECTED:
+            if (roaming)
+            {
+                break;
+            }
+            taskENTER_CRITICAL();
+            if (!link_lost)
+            {
+                link_lost = true;
+                link_lost_tick = xTaskGetTickCount();
+                link_stats.link_losses++;
+            }
+            taskEXIT_CRITICAL();
+            xTaskNotifyGive(link_monitor_task_handle);
+            break;
+
+        case CY_WCM_EVENT_RECONNECTED:
+            link_restored();
+            break;
+
+        case CY_WCM_EVENT_IP_CHANGED:
+            ERR_INFO(("The IP address of the STA interface has changed.\r\n"));
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: roam_to_better_ap
+********************************************************************************
+* Summary:
+*  Scans for the APs of the network and moves to the strongest one if its
+*  RSSI beats the average RSSI of the current AP by WIFI_ROAM_HYSTERESIS_DB.
+*  If the move fails, the device reconnects to the current AP first.
+*
+* Parameters:
+*  rssi_average - Average RSSI of the current AP in dBm.
+*  bssid - BSSID of the current AP.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void roam_to_better_ap(int16_t rssi_average, const uint8_t *bssid)
+{
+    scan_cache_entry_t entry;
+    cy_wcm_ip_address_t ip_address;
+    cy_rslt_t result;
+    uint32_t start;
+    uint32_t elapsed_msec;
+
+    roam_scan_tick = xTaskGetTickCount();
+    roam_scanned = true;
+    taskENTER_CRITICAL();
+    link_stats.roam_scans++;
+    taskEXIT_CRITICAL();
+
+    /* Only the APs reported by this scan are candidates */
+    if ((CY_RSLT_SUCCESS != scan_cache_scan_ssid(connect_params.ap_credentials.SSID)) ||
+        !scan_cache_find(connect_params.ap_credentials.SSID, SCAN_CACHE_SCAN_TIMEOUT_MSEC, &entry) ||
+        (0 == memcmp(entry.bssid, bssid, WIFI_LINK_BSSID_LENGTH)) ||
+        (entry.rssi < (rssi_average + WIFI_ROAM_HYSTERESIS_DB)))
+    {
+        return;
+    }
+
+    APP_INFO(("Roaming from %d dBm to %02X:%02X:%02X:%02X:%02X:%02X at %d dBm on channel %u\r\n",
+              rssi_average, entry.bssid[0], entry.bssid[1], entry.bssid[2], entry.bssid[3],
+              entry.bssid[4], entry.bssid[5], entry.rssi, entry.channel));
+
+    start = xTaskGetTickCount();
+    roaming = true;
+    cy_wcm_disconnect_ap();
+
+    memcpy(connect_params.BSSID, entry.bssid, sizeof(connect_params.BSSID));
+    connect_params.band = (cy_wcm_wifi_band_t)entry.band;
+    connect_params.ap_credentials.security = (cy_wcm_security_t)entry.security;
+    memset(&ip_address, 0, sizeof(ip_address));
+    result = cy_wcm_connect_ap(&connect_params, &ip_address);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        remember_ap();
+    }
+    else
+    {
+        ERR_INFO(("Roaming failed with error code %d, reconnecting.\n", (int)result));
+        connect_with_backoff(WIFI_LINK_RETRY_FOREVER);
+    }
+    roaming = false;
+
+    elapsed_msec = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+    taskENTER_CRITICAL();
+    if (CY_RSLT_SUCCESS == result)
+    {
+        link_stats.roams++;
+    }
+    else
+    {
+        link_stats.roam_failures++;
+    }
+    link_stats.last_roam_msec = elapsed_msec;
+    /* The average belongs to the previous AP */
+    link_stats.rssi_samples = 0;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: sample_link_quality
+********************************************************************************
+* Summary:
+*  Samples the RSSI of the AP into the link quality history and, unless
+*  WIFI_ROAM_DISABLED is defined, looks for a better AP once the average
+*  RSSI has fallen below WIFI_ROAM_RSSI_THRESHOLD.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sample_link_quality(void)
+{
+    cy_wcm_associated_ap_info_t ap_info;
+    int16_t rssi_average;
+
+    if (CY_RSLT_SUCCESS != cy_wcm_get_associated_ap_info(&ap_info))
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    rssi_history[rssi_history_head] = (int8_t)ap_info.signal_strength;
+    rssi_history_head = (uint8_t)((rssi_history_head + 1u) % WIFI_LINK_HISTORY_LENGTH);
+    if (rssi_history_count < WIFI_LINK_HISTORY_LENGTH)
+    {
+        rssi_history_count++;
+    }
+    link_stats.rssi = ap_info.signal_strength;
+    link_stats.rssi_average = (link_stats.rssi_samples == 0u) ? ap_info.signal_strength :
+                              (int16_t)(((3 * link_stats.rssi_average) + ap_info.signal_strength) / 4);
+    link_stats.rssi_samples++;
+    rssi_average = link_stats.rssi_average;
+    taskEXIT_CRITICAL();
+
+#ifndef WIFI_ROAM_DISABLED
+    if ((rssi_average < WIFI_ROAM_RSSI_THRESHOLD) &&
+        (!roam_scanned ||
+         (((xTaskGetTickCount() - roam_scan_tick) * portTICK_PERIOD_MS) >= WIFI_ROAM_SCAN_INTERVAL_MSEC)))
+    {
+        roam_to_better_ap(rssi_average, ap_info.BSSID);
+    }
+#else
+    (void)rssi_average;
+#endif /* #ifndef WIFI_ROAM_DISABLED */
+}
+
+/*******************************************************************************
+* Function Name: link_monitor_task
+********************************************************************************
+* Summary:
+*  Waits for the link to be lost, and reconnects with the cached details of
+*  the AP and backoff until it is up again. While the link is up, samples
+*  its quality every WIFI_LINK_SAMPLE_INTERVAL_MSEC.
+*
+* Parameters:
+*  arg - Unused.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void link_monitor_task(void *arg)
+{
+    (void)arg;
+
+    while (true)
+    {
+        if (0u == ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WIFI_LINK_SAMPLE_INTERVAL_MSEC)))
+        {
+            if (cy_wcm_is_connected_to_ap())
+            {
+                sample_link_quality();
+            }
+            continue;
+        }
+
+        if (!cy_wcm_is_connected_to_ap())
+        {
+            APP_INFO(("Wi-Fi link lost, reconnecting to '%s'\r\n", connect_params.ap_credentials.SSID));
+            connect_with_backoff(WIFI_LINK_RETRY_FOREVER);
+        }
+        link_restored();
+    }
+}
+
+/*******************************************************************************
+* Function Name: wifi_link_init
+********************************************************************************
+* Summary:
+*  Seeds the backoff jitter, which differs between devices.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wifi_link_init(void)
+{
+    uint64_t unique_id = Cy_SysLib_GetUniqueId();
+
+    srand((unsigned int)(unique_id ^ (unique_id >> 32) ^ xTaskGetTickCount()));
+}
+
+/*******************************************************************************
+* Function Name: wifi_link_set_ap
+********************************************************************************
+* Summary:
+*  Seeds the cache with the association details of an AP, such as those
+*  stored by a previous boot.
+*
+* Parameters:
+*  ssid - SSID of the network of the AP, CREDENTIAL_SSID_LENGTH bytes.
+*  ap - Association details of the AP.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wifi_link_set_ap(const uint8_t *ssid, const wifi_link_ap_t *ap)
+{
+    memset(cached_ssid, 0, sizeof(cached_ssid));
+    memcpy(cached_ssid, ssid, CREDENTIAL_SSID_LENGTH);
+    cached_ap = *ap;
+    ap_cached = true;
+}
+
+/*******************************************************************************
+* Function Name: wifi_link_get_ap
+********************************************************************************
+* Summary:
+*  Returns the association details of the AP last connected to.
+*
+* Parameters:
+*  ap - Receives the association details.
+*
+* Return:
+*  bool - true if an AP has been cached.
+*
+*******************************************************************************/
+bool wifi_link_get_ap(wifi_link_ap_t *ap)
+{
+    if (ap_cached)
+    {
+        *ap = cached_ap;
+    }
+
+    return ap_cached;
+}
+
+/*******************************************************************************
+* Function Name: wifi_link_connect
+********************************************************************************
+* Summary:
+*  Connects to a Wi-Fi network. The cached details of the AP are used if
+*  they belong to the same network; otherwise they are taken from the scan
+*  cache. Only when the network cannot be found is WPA2 AES PSK assumed.
+*  The time taken, scan included, is recorded.
+*
+* Parameters:
+*  ssid - SSID of the network, CREDENTIAL_SSID_LENGTH bytes.
+*  password - Password of the network, CREDENTIAL_PASSWORD_LENGTH bytes.
+*  max_attempts - Maximum number of attempts, or WIFI_LINK_RETRY_FOREVER.
+*
+* Return:
+*  cy_rslt_t - CY_RSLT_SUCCESS once connected, otherwise the error of the
+*  last attempt.
+*
+*******************************************************************************/
+cy_rslt_t wifi_link_connect(const uint8_t *ssid, const uint8_t *password, uint32_t max_attempts)
+{
+    cy_rslt_t result;
+    uint32_t start = xTaskGetTickCount();
+    uint32_t elapsed_msec;
+
+    memset(&connect_params, 0, sizeof(connect_params));
+    memcpy(connect_params.ap_credentials.SSID, ssid, CREDENTIAL_SSID_LENGTH);
+    memcpy(connect_params.ap_credentials.password, password, CREDENTIAL_PASSWORD_LENGTH);
+    connect_params.ap_credentials.security = CY_WCM_SECURITY_WPA2_AES_PSK;
+
+    if (ap_cached && (0 != memcmp(cached_ssid, connect_params.ap_credentials.SSID, sizeof(cached_ssid))))
+    {
+        ap_cached = false;
+    }
+    if (!ap_cached)
+    {
+        learn_ap_from_scan();
+    }
+
+    result = connect_with_backoff(max_attempts);
+    if (CY_RSLT_SUCCESS == result)
+    {
+        elapsed_msec = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+        taskENTER_CRITICAL();
+        link_stats.last_connect_msec = elapsed_msec;
+        if (elapsed_msec > link_stats.max_connect_msec)
+        {
+            link_stats.max_connect_msec = elapsed_msec;
+        }
+        taskEXIT_CRITICAL();
+        APP_INFO(("Connected in %lu ms\r\n", (unsigned long)elapsed_msec));
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: wifi_link_start_monitor
+********************************************************************************
+* Summary:
+*  Creates the link monitor task and registers for the events of the Wi-Fi
+*  connection manager. Called once the device serves on the STA interface.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wifi_link_start_monitor(void)
+{
+    cy_rslt_t result;
+
+    if (NULL != link_monitor_task_handle)
+    {
+        return;
+    }
+
+    link_monitor_task_handle = xTaskCreateStatic(link_monitor_task, "Link Monitor", LINK_MONITOR_TASK_STACK_SIZE,
+                                                 NULL, LINK_MONITOR_TASK_PRIORITY, link_monitor_task_stack,
+                                                 &link_monitor_task_tcb);
+    configASSERT(link_monitor_task_handle != NULL);
+
+    result = cy_wcm_register_event_callback(link_event_callback);
+    PRINT_AND_ASSERT(result, "Failed to register the Wi-Fi event callback.\n");
+}
+
+/*******************************************************************************
+* Function Name: wifi_link_get_stats
+********************************************************************************
+* Summary:
+*  Takes a consistent copy of the statistics.
+*
+* Parameters:
+*  stats - Pointer to the structure that receives the statistics.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wifi_link_get_stats(wifi_link_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = link_stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: append_dbm
+********************************************************************************
+* Summary:
+*  Appends a signed value in dBm.
+*
+* Parameters:
+*  builder - Builder the value is appended to.
+*  value - Value in dBm.
+*
+* Return:
+*  bool - true if the value was accepted.
+*
+*******************************************************************************/
+static bool append_dbm(response_builder_t *builder, int16_t value)
+{
+    if (value < 0)
+    {
+        response_builder_append_string(builder, "-");
+        return response_builder_append_uint(builder, (uint32_t)(-value));
+    }
+
+    return response_builder_append_uint(builder, (uint32_t)value);
+}
+
+/*******************************************************************************
+* Function Name: wifi_link_write_json
+********************************************************************************
+* Summary:
+*  Writes the statistics and the RSSI history, oldest sample first, as a
+*  "wifi" JSON member.
+*
+* Parameters:
+*  builder - Builder the member is written to.
+*
+* Return:
+*  bool - true if the member was accepted.
+*
+*******************************************************************************/
+bool wifi_link_write_json(response_builder_t *builder)
+{
+    wifi_link_stats_t stats;
+    int8_t history[WIFI_LINK_HISTORY_LENGTH];
+    uint8_t count;
+    uint8_t index;
+
+    taskENTER_CRITICAL();
+    stats = link_stats;
+    count = rssi_history_count;
+    index = (uint8_t)((rssi_history_head + WIFI_LINK_HISTORY_LENGTH - count) % WIFI_LINK_HISTORY_LENGTH);
+    for (uint8_t sample = 0; sample < count; sample++)
+    {
+        history[sample] = rssi_history[index];
+        index = (uint8_t)((index + 1u) % WIFI_LINK_HISTORY_LENGTH);
+    }
+    taskEXIT_CRITICAL();
+
+    response_builder_append_string(builder, "\"wifi\":{\"connects\":");
+    response_builder_append_uint(builder, stats.connects);
+    response_builder_append_string(builder, ",\"fast_connects\":");
+    response_builder_append_uint(builder, stats.fast_connects);
+    response_builder_append_string(builder, ",\"first_attempt_connects\":");
+    response_builder_append_uint(builder, stats.first_attempt_connects);
+    response_builder_append_string(builder, ",\"first_attempt_percent\":");
+    response_builder_append_uint(builder, (stats.connects != 0u) ?
+                                          ((stats.first_attempt_connects * 100u) / stats.connects) : 0u);
+    response_builder_append_string(builder, ",\"last_attempts\":");
+    response_builder_append_uint(builder, stats.last_attempts);
+    response_builder_append_string(builder, ",\"scan_lookups\":");
+    response_builder_append_uint(builder, stats.scan_lookups);
+    response_builder_append_string(builder, ",\"ssid_scans\":");
+    response_builder_append_uint(builder, stats.ssid_scans);
+    response_builder_append_string(builder, ",\"last_connect_msec\":");
+    response_builder_append_uint(builder, stats.last_connect_msec);
+    response_builder_append_string(builder, ",\"max_connect_msec\":");
+    response_builder_append_uint(builder, stats.max_connect_msec);
+    response_builder_append_string(builder, ",\"link_losses\":");
+    response_builder_append_uint(builder, stats.link_losses);
+    response_builder_append_string(builder, ",\"reconnects\":");
+    response_builder_append_uint(builder, stats.reconnects);
+    response_builder_append_string(builder, ",\"last_reconnect_msec\":");
+    response_builder_append_uint(builder, stats.last_reconnect_msec);
+    response_builder_append_string(builder, ",\"max_reconnect_msec\":");
+    response_builder_append_uint(builder, stats.max_reconnect_msec);
+    response_builder_append_string(builder, ",\"rssi\":");
+    append_dbm(builder, stats.rssi);
+    response_builder_append_string(builder, ",\"rssi_average\":");
+    append_dbm(builder, stats.rssi_average);
+    response_builder_append_string(builder, ",\"roam_scans\":");
+    response_builder_append_uint(builder, stats.roam_scans);
+    response_builder_append_string(builder, ",\"roams\":");
+    response_builder_append_uint(builder, stats.roams);
+    response_builder_append_string(builder, ",\"roam_failures\":");
+    response_builder_append_uint(builder, stats.roam_failures);
+    response_builder_append_string(builder, ",\"last_roam_msec\":");
+    response_builder_append_uint(builder, stats.last_roam_msec);
+    response_builder_append_string(builder, ",\"rssi_history\":[");
+    for (uint8_t sample = 0; sample < count; sample++)
+    {
+        if (sample != 0u)
+        {
+            response_builder_append_string(builder, ",");
+        }
+        append_dbm(builder, history[sample]);
+    }
+    return response_builder_append_string(builder, "]}");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,138 @@
+/******************************************************************************
+* File Name: wifi_link.h
+*
+* Description: This file contains the structures and function prototypes of
+*              the Wi-Fi link manager, which connects to the AP with cached
+*              association details and backoff, and reconnects automatically
+*              when the link is lost.
+*
+********************************************************************************
+* Copyright 2021-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Include guard
+*******************************************************************************/
+#ifndef WIFI_LINK_H_
+#define WIFI_LINK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cy_result.h"
+#include "response_builder.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define WIFI_LINK_BSSID_LENGTH                       (6u)
+
+/* Highest channel of the 2.4 GHz band. */
+#define WIFI_LINK_MAX_2_4GHZ_CHANNEL                 (14u)
+
+/* Passed as max_attempts to keep trying until the link is up. */
+#define WIFI_LINK_RETRY_FOREVER                      (0u)
+
+/* Link monitor task stack size in words, and priority, above the server
+ * task so that a reconnect is not held up by the network loop.
+ */
+#define LINK_MONITOR_TASK_STACK_SIZE                 (2 * 1024)
+#define LINK_MONITOR_TASK_PRIORITY                   (2u)
+
+/* RAM taken by the link monitor task, checked against its storage. */
+#define LINK_MONITOR_TASK_MEMORY                     RTOS_TASK_MEMORY(LINK_MONITOR_TASK_STACK_SIZE)
+
+/* Interval at which the link monitor samples the RSSI of the AP, and the
+ * number of samples kept as the link quality history.
+ */
+#define WIFI_LINK_SAMPLE_INTERVAL_MSEC               (10000u)
+#define WIFI_LINK_HISTORY_LENGTH                     (24u)
+
+/* Roaming: once the average RSSI falls below WIFI_ROAM_RSSI_THRESHOLD, the
+ * network is scanned for at most once every WIFI_ROAM_SCAN_INTERVAL_MSEC and
+ * the device moves to another AP of the network if its RSSI is better by
+ * WIFI_ROAM_HYSTERESIS_DB. Add WIFI_ROAM_DISABLED to DEFINES in the Makefile
+ * to only sample the link.
+ */
+#define WIFI_ROAM_RSSI_THRESHOLD                     (-70)
+#define WIFI_ROAM_HYSTERESIS_DB                      (8)
+#define WIFI_ROAM_SCAN_INTERVAL_MSEC                 (60000u)
+
+/*******************************************************************************
+ *                    Structures
+*******************************************************************************/
+/* Association details of the AP last connected to. */
+typedef struct
+{
+    uint8_t     bssid[WIFI_LINK_BSSID_LENGTH];
+    uint8_t     channel;
+    uint8_t     band;                           /* cy_wcm_wifi_band_t */
+    uint32_t    security;                       /* cy_wcm_security_t */
+} wifi_link_ap_t;
+
+typedef struct
+{
+    uint32_t    connects;               /* Successful connections */
+    uint32_t    fast_connects;          /* Of which made to the cached BSSID */
+    uint32_t    first_attempt_connects; /* Of which made on the first attempt */
+    uint32_t    last_attempts;          /* Attempts made by the last connection */
+    uint32_t    scan_lookups;           /* AP details taken from the scan cache */
+    uint32_t    ssid_scans;             /* Scans run to find the network */
+    uint32_t    last_connect_msec;      /* Time taken by the last wifi_link_connect */
+    uint32_t    max_connect_msec;       /* Longest time taken by wifi_link_connect */
+    uint32_t    link_losses;            /* Links lost while connected */
+    uint32_t    reconnects;             /* Links restored after a loss */
+    uint32_t    last_reconnect_msec;    /* Time the last lost link was down */
+    uint32_t    max_reconnect_msec;     /* Longest time a lost link was down */
+    int16_t     rssi;                   /* Last RSSI sample in dBm */
+    int16_t     rssi_average;           /* Moving average of the RSSI in dBm */
+    uint32_t    rssi_samples;           /* RSSI samples taken */
+    uint32_t    roam_scans;             /* Scans run to find a better AP */
+    uint32_t    roams;                  /* Moves to a better AP */
+    uint32_t    roam_failures;          /* Moves which fell back to a reconnect */
+    uint32_t    last_roam_msec;         /* Time the link was down for the last move */
+} wifi_link_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+*******************************************************************************/
+void wifi_link_init(void);
+void wifi_link_set_ap(const uint8_t *ssid, const wifi_link_ap_t *ap);
+bool wifi_link_get_ap(wifi_link_ap_t *ap);
+cy_rslt_t wifi_link_connect(const uint8_t *ssid, const uint8_t *password, uint32_t max_attempts);
+void wifi_link_start_monitor(void);
+void wifi_link_get_stats(wifi_link_stats_t *stats);
+bool wifi_link_write_json(response_builder_t *builder);
+
+#endif /* WIFI_LINK_H_ */
+
+/* [] END OF FILE */